@@ -56,7 +56,19 @@ void DebugMon_Handler(void);
 void PendSV_Handler(void);
 void SysTick_Handler(void);
 /* USER CODE BEGIN EFP */
-
+void DMA1_Stream0_IRQHandler(void);
+void I2C1_EV_IRQHandler(void);
+void I2C1_ER_IRQHandler(void);
+void I2C2_EV_IRQHandler(void);
+void I2C2_ER_IRQHandler(void);
+void DMA2_Stream1_IRQHandler(void);
+void TIM1_UP_TIM10_IRQHandler(void);
+void TIM2_IRQHandler(void);
+void TIM3_IRQHandler(void);
+void TIM6_DAC_IRQHandler(void);
+void TIM7_IRQHandler(void);
+void TIM8_TRG_COM_TIM14_IRQHandler(void);
+void USART1_IRQHandler(void);
 /* USER CODE END EFP */
 
 #ifdef __cplusplus
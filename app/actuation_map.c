@@ -0,0 +1,203 @@
+/**
+ * @file actuation_map.c
+ * @brief 电机执行映射实现
+ * @date 2026-10-16
+ */
+
+#include <stddef.h>
+#include "actuation_map.h"
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+#define ACT_MAP_DUTY_FULL           32767L  /**< Q15占空比满量程 */
+#define ACT_MAP_COMP_MIN            (ACT_MAP_COMP_ONE / 2U)
+#define ACT_MAP_COMP_MAX            0xFFFFU
+
+/* ========================================================================== */
+/*                              私有函数                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 浮点占空比四舍五入并限制在[0, 满量程]
+ */
+static uint16_t actuation_map_to_duty(float value)
+{
+    if (!(value > 0.0f)) {
+        return 0;
+    }
+    if (value >= (float)ACT_MAP_DUTY_FULL) {
+        return (uint16_t)ACT_MAP_DUTY_FULL;
+    }
+    return (uint16_t)(value + 0.5f);
+}
+
+/* ========================================================================== */
+/*                              公共函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 生成线性映射
+ */
+void actuation_map_init_linear(actuation_map_t *map, uint16_t coulomb, uint16_t kick, uint16_t max_duty)
+{
+    uint32_t k;
+
+    if (map == NULL) {
+        return;
+    }
+
+    if (max_duty > ACT_MAP_DUTY_FULL) {
+        max_duty = (uint16_t)ACT_MAP_DUTY_FULL;
+    }
+    if (coulomb > max_duty) {
+        coulomb = max_duty;
+    }
+
+    for (k = 0; k < ACT_MAP_POINTS; k++) {
+        map->lut[k] = (uint16_t)(coulomb + ((uint32_t)(max_duty - coulomb) * k) / ACT_MAP_SEGMENTS);
+    }
+    map->kick = kick;
+    map->max_duty = max_duty;
+    map->comp_q14 = ACT_MAP_COMP_ONE;
+}
+
+/**
+ * @brief 按实测的占空比-速度曲线拟合映射
+ * @note 查表点k对应的目标速度为满量程速度的k/64，在实测曲线上反查占空比；
+ *       起转点以下用(动摩擦占空比, 0)作为插值下端
+ */
+int32_t actuation_map_fit(actuation_map_t *map, const uint16_t *duty, const int32_t *vel, uint32_t n)
+{
+    float v_full, v_des, thresh;
+    float sx, sy, sxx, sxy, cnt, slope;
+    float x0, y0, x1, y1;
+    float coulomb, breakaway;
+    uint16_t lut[ACT_MAP_POINTS];
+    uint32_t b, m, i, k;
+
+    if (map == NULL || duty == NULL || vel == NULL || n < 3 || vel[n - 1] <= 0) {
+        return -1;
+    }
+
+    /* 起转点: 第一个速度超过满量程2%的点，之后至少还要有一个点 */
+    v_full = (float)vel[n - 1];
+    thresh = v_full / 50.0f;
+    for (b = 0; b < n && (float)vel[b] <= thresh; b++) {
+    }
+    if (b + 1 >= n) {
+        return -1;
+    }
+
+    /* 最小二乘直线只取下半量程的运动点，避开高速段的饱和弯曲 */
+    for (m = b + 1; m + 1 < n && (float)vel[m + 1] <= v_full * 0.5f; m++) {
+    }
+    sx = sy = sxx = sxy = cnt = 0.0f;
+    for (i = b; i <= m; i++) {
+        sx += (float)duty[i];
+        sy += (float)vel[i];
+        sxx += (float)duty[i] * (float)duty[i];
+        sxy += (float)duty[i] * (float)vel[i];
+        cnt += 1.0f;
+    }
+    slope = (cnt * sxy - sx * sy) / (cnt * sxx - sx * sx);
+    coulomb = (slope > 0.0f) ? ((sx - sy / slope) / cnt) : 0.0f;
+
+    /* 起转占空比取起转点与前一点的中点，动摩擦不超过起转占空比 */
+    breakaway = (b > 0) ? 0.5f * ((float)duty[b - 1] + (float)duty[b]) : (float)duty[b];
+    if (coulomb > breakaway) {
+        coulomb = breakaway;
+    }
+    if (coulomb < 0.0f) {
+        coulomb = 0.0f;
+    }
+
+    lut[0] = actuation_map_to_duty(coulomb);
+    for (k = 1; k < ACT_MAP_POINTS; k++) {
+        v_des = v_full * (float)k / (float)ACT_MAP_SEGMENTS;
+        for (i = b; i + 1 < n && (float)vel[i] < v_des; i++) {
+        }
+        if (i == b) {
+            x0 = coulomb;
+            y0 = 0.0f;
+        } else {
+            x0 = (float)duty[i - 1];
+            y0 = (float)vel[i - 1];
+        }
+        x1 = (float)duty[i];
+        y1 = (float)vel[i];
+        lut[k] = (y1 > y0) ? actuation_map_to_duty(x0 + (x1 - x0) * (v_des - y0) / (y1 - y0))
+                           : actuation_map_to_duty(x1);
+        if (lut[k] < lut[k - 1]) {
+            lut[k] = lut[k - 1];  /* 实测曲线有波动时保持单调 */
+        }
+    }
+
+    for (k = 0; k < ACT_MAP_POINTS; k++) {
+        map->lut[k] = lut[k];
+    }
+    map->kick = actuation_map_to_duty(breakaway - coulomb);
+    map->max_duty = duty[n - 1];
+
+    return 0;
+}
+
+/**
+ * @brief 设置电压补偿
+ */
+void actuation_map_set_supply(actuation_map_t *map, uint32_t supply_mv, uint32_t nominal_mv)
+{
+    uint32_t comp;
+
+    if (map == NULL) {
+        return;
+    }
+
+    if (supply_mv == 0 || nominal_mv == 0) {
+        map->comp_q14 = ACT_MAP_COMP_ONE;
+        return;
+    }
+
+    comp = (nominal_mv * ACT_MAP_COMP_ONE + supply_mv / 2U) / supply_mv;
+    if (comp < ACT_MAP_COMP_MIN) {
+        comp = ACT_MAP_COMP_MIN;
+    } else if (comp > ACT_MAP_COMP_MAX) {
+        comp = ACT_MAP_COMP_MAX;
+    }
+    map->comp_q14 = (uint16_t)comp;
+}
+
+/**
+ * @brief 映射一个指令
+ */
+int32_t actuation_map_apply(const actuation_map_t *map, int32_t command, uint8_t stationary)
+{
+    uint32_t mag = (uint32_t)((command >= 0) ? command : -command);
+    uint32_t idx, frac;
+    int32_t lo, hi;
+    uint32_t out;
+
+    if (mag < ACT_MAP_ZERO_BAND) {
+        return 0;
+    }
+    if (mag > (uint32_t)ACT_MAP_DUTY_FULL) {
+        mag = (uint32_t)ACT_MAP_DUTY_FULL;
+    }
+
+    idx = mag >> ACT_MAP_SEG_SHIFT;
+    frac = mag & ((1U << ACT_MAP_SEG_SHIFT) - 1U);
+    lo = map->lut[idx];
+    hi = map->lut[idx + 1U];
+    out = (uint32_t)(lo + (((hi - lo) * (int32_t)frac) >> ACT_MAP_SEG_SHIFT));
+
+    if (stationary) {
+        out += map->kick;
+    }
+    out = (out * map->comp_q14) >> 14;
+    if (out > map->max_duty) {
+        out = map->max_duty;
+    }
+
+    return (command >= 0) ? (int32_t)out : -(int32_t)out;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file actuation_map.h
+ * @brief 电机执行映射 (死区跳变、静/动摩擦前馈、电压补偿)
+ * @details 把线性的控制指令(Q15占空比)映射为实际下发的占空比:
+ *          - 死区跳变: 非零指令至少输出动摩擦(库仑摩擦)占空比，低指令不再堵转
+ *          - 静摩擦前馈: 车轮静止时额外叠加起转占空比
+ *          - 电压补偿: 按标称电压/实际电压等比放大 (可选)
+ *          映射曲线预先算成65点查找表(64段)，每次调用只做一次查表插值，
+ *          适合在1kHz控制节拍中断中执行。
+ * @date 2026-10-16
+ *
+ * @note 每个电机使用独立的映射实例；表可由actuation_map_init_linear()按配置生成，
+ *       也可由actuation_map_fit()按实测的占空比-速度曲线拟合
+ */
+
+#ifndef ACTUATION_MAP_H__
+#define ACTUATION_MAP_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/*                              配置参数                                      */
+/* ========================================================================== */
+
+#define ACT_MAP_SEG_SHIFT           9U                          /**< 每段宽度 512 (Q15) */
+#define ACT_MAP_SEGMENTS            (32768U >> ACT_MAP_SEG_SHIFT)  /**< 分段数 (64) */
+#define ACT_MAP_POINTS              (ACT_MAP_SEGMENTS + 1U)     /**< 表点数 */
+#define ACT_MAP_ZERO_BAND           64U     /**< 低于该指令视为0 (约0.2%)，避免在0附近来回跳变 */
+#define ACT_MAP_COMP_ONE            16384U  /**< 电压补偿增益的1.0 (Q14) */
+
+/* ========================================================================== */
+/*                              数据结构定义                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 执行映射
+ * @note lut[0]为指令趋近0+时的输出(即动摩擦占空比)，lut[ACT_MAP_SEGMENTS]为满量程输出
+ */
+typedef struct {
+    uint16_t lut[ACT_MAP_POINTS];   /**< |指令| → 占空比 (Q15)，单调不减 */
+    uint16_t kick;                  /**< 静止时叠加的静摩擦占空比 (Q15) */
+    uint16_t max_duty;              /**< 输出上限 (Q15) */
+    uint16_t comp_q14;              /**< 电压补偿增益 (Q14)，ACT_MAP_COMP_ONE表示不补偿 */
+} actuation_map_t;
+
+/* ========================================================================== */
+/*                              接口函数                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 生成线性映射: 非零指令从coulomb线性过渡到max_duty
+ * @param map 输出映射
+ * @param coulomb 动摩擦占空比 (Q15)，0表示无死区补偿
+ * @param kick 静摩擦附加占空比 (Q15)
+ * @param max_duty 输出上限 (Q15)
+ */
+void actuation_map_init_linear(actuation_map_t *map, uint16_t coulomb, uint16_t kick, uint16_t max_duty);
+
+/**
+ * @brief 按实测的占空比-速度曲线拟合映射，使指令与稳态速度成正比
+ * @param map 输出映射 (电压补偿增益保持不变)
+ * @param duty 扫描占空比 (Q15)，从0开始递增
+ * @param vel 各占空比下的稳态速度 (计数/秒，正向)
+ * @param n 点数，至少3
+ * @return int32_t 0: 成功, -1: 点数不足或车轮未转动 (映射不变)
+ * @note 起转点取第一个速度超过满量程2%的点；动摩擦占空比由运动点的最小二乘直线
+ *       外推到速度0得到，起转占空比与其之差作为静摩擦附加量
+ */
+int32_t actuation_map_fit(actuation_map_t *map, const uint16_t *duty, const int32_t *vel, uint32_t n);
+
+/**
+ * @brief 设置电压补偿
+ * @param map 映射
+ * @param supply_mv 实际电机电源电压 (mV)，0表示关闭补偿
+ * @param nominal_mv 拟合/标定时的标称电压 (mV)
+ * @note 增益限制在0.5~3.9之间；只修改一个16位字段，可在主循环中随时调用
+ */
+void actuation_map_set_supply(actuation_map_t *map, uint32_t supply_mv, uint32_t nominal_mv);
+
+/**
+ * @brief 映射一个指令
+ * @param map 映射
+ * @param command 指令 (Q15占空比，带符号)
+ * @param stationary 车轮是否静止 (静止时叠加静摩擦占空比)
+ * @return int32_t 下发占空比 (Q15，带符号，不超过±max_duty)
+ */
+int32_t actuation_map_apply(const actuation_map_t *map, int32_t command, uint8_t stationary);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ACTUATION_MAP_H__ */
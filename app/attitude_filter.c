@@ -0,0 +1,237 @@
+/**
+ * @file attitude_filter.c
+ * @brief 四元数姿态滤波实现 (Mahony互补滤波)
+ * @details 由当前姿态估计重力方向，与加速度计测得的方向做叉积得到误差，
+ *          经PI修正后叠加到角速度上，再按 q' = 0.5 * q ⊗ (0, ω) 积分。
+ * @date 2026-10-16
+ */
+
+#include <math.h>
+#include <string.h>
+#include "arm_math.h"
+#include "attitude_filter.h"
+
+/* 端口层接口声明 - 由具体端口层实现 */
+extern uint32_t tick_port_cycles(void);
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+#define ATTITUDE_DEG2RAD        0.017453292519943f
+#define ATTITUDE_RAD2DEG        57.29577951308232f
+#define ATTITUDE_DT_MAX         0.1f
+
+/* ========================================================================== */
+/*                              私有数据结构                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 滤波器状态
+ */
+typedef struct {
+    attitude_config_t config;   /**< 配置 */
+    float32_t q[4];             /**< 当前四元数 */
+    float integral[3];          /**< 误差积分 (rad/s) */
+    uint8_t aligned;            /**< 是否已由加速度计初始化 */
+    attitude_stats_t stats;     /**< 运行统计 */
+} attitude_filter_t;
+
+/* ========================================================================== */
+/*                              私有变量                                      */
+/* ========================================================================== */
+
+static attitude_filter_t g_attitude = {
+    .config = {ATTITUDE_DEFAULT_KP, ATTITUDE_DEFAULT_KI, ATTITUDE_DEFAULT_BUDGET},
+    .q = {1.0f, 0.0f, 0.0f, 0.0f},
+};
+
+/* ========================================================================== */
+/*                              私有函数声明                                  */
+/* ========================================================================== */
+
+static void attitude_align(const float acc[3]);
+static void attitude_to_euler(const float32_t q[4], float euler[3]);
+
+/* ========================================================================== */
+/*                              公共函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化滤波器
+ */
+void attitude_filter_init(const attitude_config_t *config)
+{
+    memset(&g_attitude, 0, sizeof(g_attitude));
+
+    if (config != NULL) {
+        g_attitude.config = *config;
+    } else {
+        g_attitude.config.kp = ATTITUDE_DEFAULT_KP;
+        g_attitude.config.ki = ATTITUDE_DEFAULT_KI;
+        g_attitude.config.budget_cycles = ATTITUDE_DEFAULT_BUDGET;
+    }
+
+    g_attitude.q[0] = 1.0f;
+}
+
+/**
+ * @brief 修改滤波增益
+ */
+int32_t attitude_filter_set_gain(float kp, float ki)
+{
+    if (kp < 0.0f || ki < 0.0f) {
+        return -1;
+    }
+
+    g_attitude.config.kp = kp;
+    g_attitude.config.ki = ki;
+    if (ki == 0.0f) {
+        memset(g_attitude.integral, 0, sizeof(g_attitude.integral));
+    }
+    return 0;
+}
+
+/**
+ * @brief 使用一组原始测量更新姿态
+ */
+int32_t attitude_filter_update(const float gyro_dps[3], const float acc_g[3], float dt, attitude_t *out)
+{
+    uint32_t start = tick_port_cycles();
+    float32_t *q = g_attitude.q;
+    float32_t omega[4];
+    float32_t q_dot[4];
+    float a[3];
+    float norm;
+    uint32_t cycles;
+
+    if (gyro_dps == NULL || acc_g == NULL || !(dt > 0.0f) || dt > ATTITUDE_DT_MAX) {
+        return -1;
+    }
+
+    omega[0] = 0.0f;
+    omega[1] = gyro_dps[0] * ATTITUDE_DEG2RAD;
+    omega[2] = gyro_dps[1] * ATTITUDE_DEG2RAD;
+    omega[3] = gyro_dps[2] * ATTITUDE_DEG2RAD;
+
+    norm = sqrtf(acc_g[0] * acc_g[0] + acc_g[1] * acc_g[1] + acc_g[2] * acc_g[2]);
+    if (norm > 0.0f) {
+        a[0] = acc_g[0] / norm;
+        a[1] = acc_g[1] / norm;
+        a[2] = acc_g[2] / norm;
+
+        if (!g_attitude.aligned) {
+            attitude_align(a);
+        } else {
+            /* 由姿态估计的重力方向 (机体坐标系) */
+            float vx = 2.0f * (q[1] * q[3] - q[0] * q[2]);
+            float vy = 2.0f * (q[0] * q[1] + q[2] * q[3]);
+            float vz = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+
+            /* 误差 = 测量方向 × 估计方向 */
+            float ex = a[1] * vz - a[2] * vy;
+            float ey = a[2] * vx - a[0] * vz;
+            float ez = a[0] * vy - a[1] * vx;
+
+            if (g_attitude.config.ki > 0.0f) {
+                g_attitude.integral[0] += g_attitude.config.ki * ex * dt;
+                g_attitude.integral[1] += g_attitude.config.ki * ey * dt;
+                g_attitude.integral[2] += g_attitude.config.ki * ez * dt;
+            }
+
+            omega[1] += g_attitude.config.kp * ex + g_attitude.integral[0];
+            omega[2] += g_attitude.config.kp * ey + g_attitude.integral[1];
+            omega[3] += g_attitude.config.kp * ez + g_attitude.integral[2];
+        }
+    }
+
+    /* q += 0.5 * q ⊗ (0, ω) * dt */
+    arm_quaternion_product_single_f32(q, omega, q_dot);
+    q[0] += 0.5f * q_dot[0] * dt;
+    q[1] += 0.5f * q_dot[1] * dt;
+    q[2] += 0.5f * q_dot[2] * dt;
+    q[3] += 0.5f * q_dot[3] * dt;
+    arm_quaternion_normalize_f32(q, q, 1);
+
+    if (out != NULL) {
+        memcpy(out->q, q, sizeof(out->q));
+        attitude_to_euler(q, out->euler);
+    }
+
+    cycles = tick_port_cycles() - start;
+    g_attitude.stats.updates++;
+    g_attitude.stats.last_cycles = cycles;
+    if (cycles > g_attitude.stats.max_cycles) {
+        g_attitude.stats.max_cycles = cycles;
+    }
+    if (cycles > g_attitude.config.budget_cycles) {
+        g_attitude.stats.budget_overruns++;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 重置姿态
+ */
+void attitude_filter_reset(void)
+{
+    g_attitude.q[0] = 1.0f;
+    g_attitude.q[1] = 0.0f;
+    g_attitude.q[2] = 0.0f;
+    g_attitude.q[3] = 0.0f;
+    memset(g_attitude.integral, 0, sizeof(g_attitude.integral));
+    g_attitude.aligned = 0;
+}
+
+/**
+ * @brief 获取运行统计
+ */
+void attitude_filter_get_stats(attitude_stats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+    *stats = g_attitude.stats;
+}
+
+/* ========================================================================== */
+/*                              私有函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 由归一化加速度确定初始姿态 (Yaw取0)
+ */
+static void attitude_align(const float acc[3])
+{
+    float roll = atan2f(acc[1], acc[2]);
+    float pitch = atan2f(-acc[0], sqrtf(acc[1] * acc[1] + acc[2] * acc[2]));
+    float cr = cosf(roll * 0.5f), sr = sinf(roll * 0.5f);
+    float cp = cosf(pitch * 0.5f), sp = sinf(pitch * 0.5f);
+
+    g_attitude.q[0] = cr * cp;
+    g_attitude.q[1] = sr * cp;
+    g_attitude.q[2] = cr * sp;
+    g_attitude.q[3] = -sr * sp;
+    g_attitude.aligned = 1;
+}
+
+/**
+ * @brief 四元数转欧拉角 (ZYX顺序，单位°)
+ */
+static void attitude_to_euler(const float32_t q[4], float euler[3])
+{
+    float sinp = 2.0f * (q[0] * q[2] - q[3] * q[1]);
+
+    if (sinp > 1.0f) {
+        sinp = 1.0f;
+    } else if (sinp < -1.0f) {
+        sinp = -1.0f;
+    }
+
+    euler[0] = atan2f(2.0f * (q[0] * q[1] + q[2] * q[3]),
+                      1.0f - 2.0f * (q[1] * q[1] + q[2] * q[2])) * ATTITUDE_RAD2DEG;
+    euler[1] = asinf(sinp) * ATTITUDE_RAD2DEG;
+    euler[2] = atan2f(2.0f * (q[0] * q[3] + q[1] * q[2]),
+                      1.0f - 2.0f * (q[2] * q[2] + q[3] * q[3])) * ATTITUDE_RAD2DEG;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file attitude_filter.h
+ * @brief 四元数姿态滤波接口 (Mahony互补滤波)
+ * @details 使用原始角速度和加速度在MCU上解算姿态，不依赖传感器内部的角度输出。
+ *          四元数运算基于CMSIS-DSP QuaternionMathFunctions，格式为[w, x, y, z]。
+ * @date 2026-10-16
+ *
+ * @note 单实例，更新函数可在采样中断中调用
+ */
+
+#ifndef ATTITUDE_FILTER_H__
+#define ATTITUDE_FILTER_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/*                              配置参数                                      */
+/* ========================================================================== */
+
+#define ATTITUDE_DEFAULT_KP         1.0f    /**< 默认比例增益 */
+#define ATTITUDE_DEFAULT_KI         0.0f    /**< 默认积分增益 (陀螺零偏估计) */
+#define ATTITUDE_DEFAULT_BUDGET     3000U   /**< 默认单次更新周期预算 (168MHz下约18us) */
+
+/* ========================================================================== */
+/*                              数据结构定义                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 滤波器配置
+ */
+typedef struct {
+    float kp;                   /**< 比例增益，越大越信任加速度计 */
+    float ki;                   /**< 积分增益，0表示不估计陀螺零偏 */
+    uint32_t budget_cycles;     /**< 单次更新CPU周期预算，超出时计数 */
+} attitude_config_t;
+
+/**
+ * @brief 姿态输出
+ */
+typedef struct {
+    float q[4];                 /**< 四元数 [w, x, y, z] */
+    float euler[3];             /**< 欧拉角 [Roll, Pitch, Yaw] (°)，ZYX顺序 */
+} attitude_t;
+
+/**
+ * @brief 滤波器运行统计
+ */
+typedef struct {
+    uint32_t updates;           /**< 更新次数 */
+    uint32_t last_cycles;       /**< 最近一次更新耗时 (CPU周期) */
+    uint32_t max_cycles;        /**< 最大更新耗时 (CPU周期) */
+    uint32_t budget_overruns;   /**< 超出周期预算的次数 */
+} attitude_stats_t;
+
+/* ========================================================================== */
+/*                              API接口                                       */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化滤波器
+ * @param config 配置，NULL使用默认值
+ * @note 姿态在第一次有效更新时由加速度计确定初始Roll/Pitch
+ */
+void attitude_filter_init(const attitude_config_t *config);
+
+/**
+ * @brief 修改滤波增益
+ * @param kp 比例增益 (>=0)
+ * @param ki 积分增益 (>=0)
+ * @return int32_t 0: 成功, -1: 参数无效
+ */
+int32_t attitude_filter_set_gain(float kp, float ki);
+
+/**
+ * @brief 使用一组原始测量更新姿态
+ * @param gyro_dps 三轴角速度 (°/s)
+ * @param acc_g 三轴加速度 (g)，全零时仅做陀螺积分
+ * @param dt 距上次更新的时间 (s)，范围: (0, 0.1]
+ * @param out 输出姿态，可为NULL
+ * @return int32_t 0: 成功, -1: 参数无效
+ */
+int32_t attitude_filter_update(const float gyro_dps[3], const float acc_g[3], float dt, attitude_t *out);
+
+/**
+ * @brief 重置姿态，下一次更新重新由加速度计初始化
+ */
+void attitude_filter_reset(void);
+
+/**
+ * @brief 获取运行统计
+ * @param stats 输出统计
+ */
+void attitude_filter_get_stats(attitude_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ATTITUDE_FILTER_H__ */
@@ -0,0 +1,152 @@
+/**
+ * @file imu_convert.c
+ * @brief IMU寄存器块原始值到物理量的转换内核实现
+ * @date 2026-10-16
+ */
+
+#include <stddef.h>
+#include "imu_convert.h"
+
+/* 端口层接口声明 - 由具体端口层实现 */
+extern uint32_t tick_port_cycles(void);
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+/* 浮点比例系数: 满量程 / 32768 (Q15) */
+#define IMU_ACC_SCALE_F32       (16.0f / 32768.0f)
+#define IMU_GYRO_SCALE_F32      (2000.0f / 32768.0f)
+#define IMU_ANGLE_SCALE_F32     (180.0f / 32768.0f)
+
+/*
+ * 定点比例: 满量程(整数单位) / 32768 化简为 乘数 >> 移位，结果精确
+ *   16000 mg       / 32768 = 125   / 2^8
+ *   2000000 m°/s   / 32768 = 15625 / 2^8
+ *   18000 0.01°    / 32768 = 1125  / 2^11
+ * 乘积最大约5.1e8，不会溢出int32
+ */
+#define IMU_ACC_MUL             125
+#define IMU_ACC_SHIFT           8
+#define IMU_GYRO_MUL            15625
+#define IMU_GYRO_SHIFT          8
+#define IMU_ANGLE_MUL           1125
+#define IMU_ANGLE_SHIFT         11
+
+/* 四舍五入的定点换算: 按绝对值舍入后恢复符号，正负对称 (半值远离0)；
+ * 直接对负数加半再算术右移会把半值舍向+∞ */
+#define IMU_FIXED(raw, mul, shift)  imu_fixed_round((int32_t)(raw) * (mul), (shift))
+
+/* ========================================================================== */
+/*                              私有函数声明                                  */
+/* ========================================================================== */
+
+static int32_t imu_fixed_round(int32_t product, uint32_t shift);
+static void imu_scale3_f32(const int16_t *src, float scale, float dst[3]);
+static void imu_convert_legacy(const int16_t *block, float acc[3], float gyro[3], float angle[3]);
+
+/* ========================================================================== */
+/*                              公共函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 转换为浮点物理量
+ */
+void imu_convert_f32(const int16_t *block, uint8_t groups, float acc[3], float gyro[3], float angle[3])
+{
+    if (groups & IMU_GROUP_ACC) {
+        imu_scale3_f32(&block[IMU_REG_ACC], IMU_ACC_SCALE_F32, acc);
+    }
+    if (groups & IMU_GROUP_GYRO) {
+        imu_scale3_f32(&block[IMU_REG_GYRO], IMU_GYRO_SCALE_F32, gyro);
+    }
+    if (groups & IMU_GROUP_ANGLE) {
+        imu_scale3_f32(&block[IMU_REG_ANGLE], IMU_ANGLE_SCALE_F32, angle);
+    }
+}
+
+/**
+ * @brief 转换为定点物理量
+ */
+void imu_convert_fixed(const int16_t *block, uint8_t groups, imu_fixed_t *out)
+{
+    uint32_t i;
+
+    if (groups & IMU_GROUP_ACC) {
+        for (i = 0; i < 3; i++) {
+            out->acc_mg[i] = IMU_FIXED(block[IMU_REG_ACC + i], IMU_ACC_MUL, IMU_ACC_SHIFT);
+        }
+    }
+    if (groups & IMU_GROUP_GYRO) {
+        for (i = 0; i < 3; i++) {
+            out->gyro_mdps[i] = IMU_FIXED(block[IMU_REG_GYRO + i], IMU_GYRO_MUL, IMU_GYRO_SHIFT);
+        }
+    }
+    if (groups & IMU_GROUP_ANGLE) {
+        for (i = 0; i < 3; i++) {
+            out->angle_cdeg[i] = IMU_FIXED(block[IMU_REG_ANGLE + i], IMU_ANGLE_MUL, IMU_ANGLE_SHIFT);
+        }
+    }
+}
+
+/**
+ * @brief 测量原实现与新内核的转换耗时
+ */
+void imu_convert_benchmark(const int16_t *block, imu_convert_bench_t *result)
+{
+    float acc[3], gyro[3], angle[3];
+    imu_fixed_t fixed;
+    uint32_t start;
+
+    if (block == NULL || result == NULL) {
+        return;
+    }
+
+    start = tick_port_cycles();
+    imu_convert_legacy(block, acc, gyro, angle);
+    result->legacy_cycles = tick_port_cycles() - start;
+
+    start = tick_port_cycles();
+    imu_convert_f32(block, IMU_GROUP_ALL, acc, gyro, angle);
+    result->f32_cycles = tick_port_cycles() - start;
+
+    start = tick_port_cycles();
+    imu_convert_fixed(block, IMU_GROUP_ALL, &fixed);
+    result->fixed_cycles = tick_port_cycles() - start;
+}
+
+/* ========================================================================== */
+/*                              私有函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 定点乘积右移并对称舍入到最近
+ */
+static int32_t imu_fixed_round(int32_t product, uint32_t shift)
+{
+    int32_t half = (int32_t)1 << (shift - 1U);
+
+    return (product >= 0) ? ((product + half) >> shift) : -((-product + half) >> shift);
+}
+
+/**
+ * @brief 3个原始值乘以比例系数
+ */
+static void imu_scale3_f32(const int16_t *src, float scale, float dst[3])
+{
+    dst[0] = (float)src[0] * scale;
+    dst[1] = (float)src[1] * scale;
+    dst[2] = (float)src[2] * scale;
+}
+
+/**
+ * @brief 原转换实现 (与原jy61p_data_convert_and_print()相同的表达式)，仅用于耗时对比
+ */
+static void imu_convert_legacy(const int16_t *block, float acc[3], float gyro[3], float angle[3])
+{
+    for (int i = 0; i < 3; i++) {
+        acc[i] = block[IMU_REG_ACC + i] / 32768.0f * 16.0f;
+        gyro[i] = block[IMU_REG_GYRO + i] / 32768.0f * 2000.0f;
+        angle[i] = block[IMU_REG_ANGLE + i] / 32768.0f * 180.0f;
+    }
+}
@@ -0,0 +1,97 @@
+/**
+ * @file imu_convert.h
+ * @brief IMU寄存器块原始值到物理量的转换内核
+ * @details 输入为JY61P寄存器AX..Yaw连续排列的12个int16_t原始值，
+ *          按组(加速度/角速度/角度)只转换被标记的部分。
+ *          浮点输出使用预先计算的Q15比例系数，每轴一次乘法，无除法；
+ *          定点输出为整数工程单位，控制代码可完全不使用浮点。
+ * @date 2026-10-16
+ */
+
+#ifndef IMU_CONVERT_H__
+#define IMU_CONVERT_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/*                              寄存器块布局                                  */
+/* ========================================================================== */
+
+#define IMU_REG_BLOCK_NUM   12U     /**< 寄存器块长度 (AX..Yaw) */
+#define IMU_REG_ACC         0U      /**< AX在块内的偏移 */
+#define IMU_REG_GYRO        3U      /**< GX在块内的偏移 */
+#define IMU_REG_MAG         6U      /**< HX在块内的偏移 */
+#define IMU_REG_ANGLE       9U      /**< Roll在块内的偏移 */
+
+/* ========================================================================== */
+/*                              转换分组                                      */
+/* ========================================================================== */
+
+/* 与jy61p_app.c的数据更新标志取值一致，可直接传入 */
+#define IMU_GROUP_ACC       0x01U   /**< 加速度 */
+#define IMU_GROUP_GYRO      0x02U   /**< 角速度 */
+#define IMU_GROUP_ANGLE     0x04U   /**< 角度 */
+#define IMU_GROUP_MAG       0x08U   /**< 磁场 (原始值，不做换算) */
+#define IMU_GROUP_ALL       0x0FU
+
+/* ========================================================================== */
+/*                              数据结构定义                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 定点物理量 (整数工程单位)
+ */
+typedef struct {
+    int32_t acc_mg[3];          /**< 加速度 (mg)，量程±16000 */
+    int32_t gyro_mdps[3];       /**< 角速度 (m°/s)，量程±2000000 */
+    int32_t angle_cdeg[3];      /**< 角度 (0.01°)，量程±18000 */
+} imu_fixed_t;
+
+/**
+ * @brief 转换耗时对比 (CPU周期)
+ */
+typedef struct {
+    uint32_t legacy_cycles;     /**< 原实现: 每轴一次除法和一次乘法 */
+    uint32_t f32_cycles;        /**< 浮点内核 (全部分组) */
+    uint32_t fixed_cycles;      /**< 定点内核 (全部分组) */
+} imu_convert_bench_t;
+
+/* ========================================================================== */
+/*                              API接口                                       */
+/* ========================================================================== */
+
+/**
+ * @brief 转换为浮点物理量
+ * @param block 寄存器块 (IMU_REG_BLOCK_NUM个原始值)
+ * @param groups 需要转换的分组 (IMU_GROUP_*)，未标记分组的输出保持不变
+ * @param acc 加速度输出 (g)
+ * @param gyro 角速度输出 (°/s)
+ * @param angle 角度输出 (°)
+ */
+void imu_convert_f32(const int16_t *block, uint8_t groups, float acc[3], float gyro[3], float angle[3]);
+
+/**
+ * @brief 转换为定点物理量
+ * @param block 寄存器块 (IMU_REG_BLOCK_NUM个原始值)
+ * @param groups 需要转换的分组 (IMU_GROUP_*)，未标记分组的输出保持不变
+ * @param out 定点输出
+ */
+void imu_convert_fixed(const int16_t *block, uint8_t groups, imu_fixed_t *out);
+
+/**
+ * @brief 测量原实现与新内核的转换耗时
+ * @param block 用于测量的寄存器块
+ * @param result 输出耗时
+ * @note 需在DWT周期计数器使能后调用，结果包含少量计时开销
+ */
+void imu_convert_benchmark(const int16_t *block, imu_convert_bench_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMU_CONVERT_H__ */
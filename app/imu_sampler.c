@@ -0,0 +1,248 @@
+/**
+ * @file imu_sampler.c
+ * @brief IMU定时采样与无锁样本队列实现
+ * @details 节拍中断仅启动异步读取并记录时间戳，数据在I2C完成中断中入队。
+ *          队列为单生产者/单消费者结构: 写索引只由生产者修改，读索引只由
+ *          消费者修改，在单核Cortex-M上无需关中断；槽位读写与索引发布之间用
+ *          编译器屏障保持顺序。
+ * @date 2026-10-16
+ */
+
+#include <string.h>
+#include "cmsis_compiler.h"
+#include "wit_c_sdk.h"
+#include "imu_sampler.h"
+
+/* 端口层接口声明 - 由具体端口层实现 */
+extern int32_t tick_port_imu_start(uint32_t rate_hz, void (*cb)(void));
+extern void tick_port_imu_stop(void);
+extern uint32_t tick_port_cycles(void);
+extern uint32_t tick_port_uptime_ms(void);
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+#define IMU_SAMPLER_QUEUE_MASK  (IMU_SAMPLER_QUEUE_SIZE - 1U)
+#define IMU_SAMPLER_REG_START   AX
+#define IMU_SAMPLER_REG_NUM     IMU_REG_BLOCK_NUM   /* AX..Yaw */
+#define IMU_SAMPLER_DRAIN_MS    10U                 /* 等待上次读取结束的上限 (100kHz下单次读取约2.5ms) */
+
+/* ========================================================================== */
+/*                              私有数据结构                                  */
+/* ========================================================================== */
+
+/**
+ * @brief SPSC样本队列
+ */
+typedef struct {
+    imu_sample_t buf[IMU_SAMPLER_QUEUE_SIZE];
+    volatile uint32_t head;     /**< 写索引 (仅生产者修改) */
+    volatile uint32_t tail;     /**< 读索引 (仅消费者修改) */
+} imu_sample_queue_t;
+
+/* ========================================================================== */
+/*                              私有变量                                      */
+/* ========================================================================== */
+
+static imu_sample_queue_t s_queue;
+static imu_sampler_stats_t s_stats;
+static volatile uint32_t s_pending_timestamp;   /* 进行中读取的节拍时间戳 */
+static volatile uint32_t s_pending_seq;         /* 进行中读取的样本序号 */
+static volatile uint32_t s_tick_seq;            /* 节拍计数 */
+static volatile imu_sampler_hook_t s_hook;      /* 样本到达钩子 */
+
+/* ========================================================================== */
+/*                              私有函数声明                                  */
+/* ========================================================================== */
+
+static void imu_sampler_tick(void);
+static void imu_sampler_read_done(uint32_t uiReg, uint32_t uiRegNum, int32_t iResult);
+static int32_t imu_queue_push(const imu_sample_t *sample);
+
+/* ========================================================================== */
+/*                              公共函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 启动定时采样
+ */
+int32_t imu_sampler_start(uint32_t rate_hz)
+{
+    if (rate_hz < IMU_SAMPLER_RATE_MIN_HZ || rate_hz > IMU_SAMPLER_RATE_MAX_HZ) {
+        return -1;
+    }
+
+    tick_port_imu_stop();
+
+    /* 上次运行的读取可能仍在进行，其完成中断会写入队列；SDK无法中止传输，
+     * 等待其结束(忙标志在完成中断中清除，主循环看到空闲时该中断已返回)后再复位索引 */
+    if (imu_sampler_wait_idle() != 0) {
+        return -1;
+    }
+
+    s_queue.head = 0;
+    s_queue.tail = 0;
+    s_tick_seq = 0;
+
+    WitReadDoneRegister(imu_sampler_read_done);
+
+    if (tick_port_imu_start(rate_hz, imu_sampler_tick) != 0) {
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 停止定时采样
+ */
+void imu_sampler_stop(void)
+{
+    tick_port_imu_stop();
+}
+
+/**
+ * @brief 等待进行中的异步读取结束
+ */
+int32_t imu_sampler_wait_idle(void)
+{
+    uint32_t start_ms = tick_port_uptime_ms();
+
+    while (WitReadRegBusy()) {
+        if ((tick_port_uptime_ms() - start_ms) > IMU_SAMPLER_DRAIN_MS) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 注册样本到达钩子
+ */
+void imu_sampler_set_hook(imu_sampler_hook_t hook)
+{
+    s_hook = hook;
+}
+
+/**
+ * @brief 从队列取出一个样本
+ */
+int32_t imu_sampler_pop(imu_sample_t *sample)
+{
+    uint32_t tail = s_queue.tail;
+
+    if (sample == NULL || tail == s_queue.head) {
+        return -1;
+    }
+    __COMPILER_BARRIER();   /* 看到写索引之后才读槽位 */
+
+    *sample = s_queue.buf[tail & IMU_SAMPLER_QUEUE_MASK];
+
+    /* 先完成数据拷贝再释放槽位 */
+    __COMPILER_BARRIER();
+    s_queue.tail = tail + 1U;
+    return 0;
+}
+
+/**
+ * @brief 当前队列中的样本数
+ */
+uint32_t imu_sampler_available(void)
+{
+    return s_queue.head - s_queue.tail;
+}
+
+/**
+ * @brief 获取采样统计
+ */
+void imu_sampler_get_stats(imu_sampler_stats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+    *stats = s_stats;
+}
+
+/**
+ * @brief 清零采样统计
+ */
+void imu_sampler_reset_stats(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+/* ========================================================================== */
+/*                              私有函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 采样节拍回调 (定时器中断上下文)
+ */
+static void imu_sampler_tick(void)
+{
+    uint32_t seq = s_tick_seq++;
+
+    if (WitReadRegBusy()) {
+        s_stats.bus_busy++;
+        return;
+    }
+
+    s_pending_timestamp = tick_port_cycles();
+    s_pending_seq = seq;
+
+    if (WitReadRegAsync(IMU_SAMPLER_REG_START, IMU_SAMPLER_REG_NUM) != WIT_HAL_OK) {
+        s_stats.bus_errors++;
+    }
+}
+
+/**
+ * @brief 异步读取完成回调 (I2C完成中断上下文)
+ * @note SDK已在调用前将数据解码到sReg
+ */
+static void imu_sampler_read_done(uint32_t uiReg, uint32_t uiRegNum, int32_t iResult)
+{
+    imu_sample_t sample;
+    imu_sampler_hook_t hook;
+
+    if (iResult != WIT_HAL_OK || uiReg != IMU_SAMPLER_REG_START || uiRegNum != IMU_SAMPLER_REG_NUM) {
+        s_stats.bus_errors++;
+        return;
+    }
+
+    sample.timestamp = s_pending_timestamp;
+    sample.seq = s_pending_seq;
+    memcpy(sample.reg, &sReg[IMU_SAMPLER_REG_START], sizeof(sample.reg));
+
+    hook = s_hook;
+    if (hook != NULL) {
+        hook(&sample);
+    }
+
+    if (imu_queue_push(&sample) != 0) {
+        s_stats.queue_overruns++;
+        return;
+    }
+    s_stats.produced++;
+}
+
+/**
+ * @brief 样本入队 (仅生产者调用)
+ * @return int32_t 0: 成功, -1: 队列已满
+ */
+static int32_t imu_queue_push(const imu_sample_t *sample)
+{
+    uint32_t head = s_queue.head;
+
+    if ((head - s_queue.tail) >= IMU_SAMPLER_QUEUE_MASK) {
+        return -1;
+    }
+    __COMPILER_BARRIER();   /* 确认槽位已被释放之后才写入 */
+
+    s_queue.buf[head & IMU_SAMPLER_QUEUE_MASK] = *sample;
+
+    /* 先写数据再发布写索引 */
+    __COMPILER_BARRIER();
+    s_queue.head = head + 1U;
+    return 0;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file imu_sampler.h
+ * @brief IMU定时采样与无锁样本队列接口
+ * @details 由定时器节拍驱动JY61P异步寄存器读取，采样频率可配置(50-500Hz)。
+ *          每个样本在节拍时刻打上CPU周期时间戳，在I2C完成中断中写入
+ *          单生产者/单消费者(SPSC)无锁环形队列，由控制代码在主循环中取出。
+ * @date 2026-10-16
+ *
+ * @note 生产者: I2C完成中断; 消费者: 主循环(或单一低优先级任务)
+ *       同一时刻只允许一个消费者调用imu_sampler_pop()
+ */
+
+#ifndef IMU_SAMPLER_H__
+#define IMU_SAMPLER_H__
+
+#include <stdint.h>
+#include "imu_convert.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/*                              配置参数                                      */
+/* ========================================================================== */
+
+#define IMU_SAMPLER_RATE_MIN_HZ     50U     /**< 最低采样频率 */
+#define IMU_SAMPLER_RATE_MAX_HZ     500U    /**< 最高采样频率 */
+
+/**
+ * @brief 样本队列深度 (必须为2的幂)
+ * @note 实际可用容量为 IMU_SAMPLER_QUEUE_SIZE - 1
+ */
+#ifndef IMU_SAMPLER_QUEUE_SIZE
+#define IMU_SAMPLER_QUEUE_SIZE      32U
+#endif
+
+#if (IMU_SAMPLER_QUEUE_SIZE & (IMU_SAMPLER_QUEUE_SIZE - 1U)) != 0U
+#error "IMU_SAMPLER_QUEUE_SIZE must be a power of two"
+#endif
+
+/* ========================================================================== */
+/*                              数据结构定义                                  */
+/* ========================================================================== */
+
+/**
+ * @brief IMU原始样本
+ * @details reg为JY61P寄存器AX..Yaw的原始值，布局见imu_convert.h (IMU_REG_*)，
+ *          可直接交给imu_convert_f32()/imu_convert_fixed()转换
+ */
+typedef struct {
+    uint32_t timestamp;     /**< 采样节拍时刻的CPU周期计数 */
+    uint32_t seq;           /**< 样本序号 (每个节拍递增，可用于检测丢样) */
+    int16_t reg[IMU_REG_BLOCK_NUM]; /**< 寄存器块: acc[3] gyro[3] mag[3] angle[3] */
+} imu_sample_t;
+
+/**
+ * @brief 采样统计 (溢出计数)
+ */
+typedef struct {
+    uint32_t produced;      /**< 成功写入队列的样本数 */
+    uint32_t queue_overruns;/**< 队列满而丢弃的样本数 */
+    uint32_t bus_busy;      /**< 节拍到来时上一次读取未完成而跳过的次数 */
+    uint32_t bus_errors;    /**< 读取启动失败或总线错误次数 */
+} imu_sampler_stats_t;
+
+/**
+ * @brief 样本到达钩子
+ * @note 在I2C完成中断中调用，早于主循环从队列取出该样本，必须短小且不可阻塞
+ */
+typedef void (*imu_sampler_hook_t)(const imu_sample_t *sample);
+
+/* ========================================================================== */
+/*                              API接口                                       */
+/* ========================================================================== */
+
+/**
+ * @brief 启动定时采样
+ * @param rate_hz 采样频率 (Hz)，范围: 50-500
+ * @return int32_t 0: 成功, -1: 参数无效、上次运行的读取未能结束或节拍启动失败
+ * @note 调用前需完成WIT SDK初始化并注册异步I2C读函数。
+ *       重新启动时先停止节拍并等待进行中的读取完成(最多10ms)，再清空队列。
+ *       I2C为100kHz时单次读取12个寄存器约需2.5ms，400Hz以上建议将I2C切换到400kHz。
+ */
+int32_t imu_sampler_start(uint32_t rate_hz);
+
+/**
+ * @brief 停止定时采样
+ * @note 已在进行中的读取仍会完成，其样本照常入队
+ */
+void imu_sampler_stop(void);
+
+/**
+ * @brief 等待进行中的异步读取结束
+ * @return int32_t 0: 总线空闲, -1: 10ms内未结束 (总线卡死且没有错误回调)
+ * @note 用于停止采样后做同步I2C访问之前；完成或出错都会清除忙标志
+ */
+int32_t imu_sampler_wait_idle(void);
+
+/**
+ * @brief 注册样本到达钩子
+ * @param hook 钩子函数，NULL表示取消
+ * @note 无论样本是否因队列满被丢弃，钩子都会被调用
+ */
+void imu_sampler_set_hook(imu_sampler_hook_t hook);
+
+/**
+ * @brief 从队列取出一个样本
+ * @param sample 输出样本
+ * @return int32_t 0: 取出成功, -1: 队列为空或参数无效
+ */
+int32_t imu_sampler_pop(imu_sample_t *sample);
+
+/**
+ * @brief 当前队列中的样本数
+ * @return uint32_t 样本数
+ */
+uint32_t imu_sampler_available(void);
+
+/**
+ * @brief 获取采样统计
+ * @param stats 输出统计信息
+ */
+void imu_sampler_get_stats(imu_sampler_stats_t *stats);
+
+/**
+ * @brief 清零采样统计
+ */
+void imu_sampler_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMU_SAMPLER_H__ */
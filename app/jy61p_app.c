@@ -11,18 +11,50 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdint.h>
+#include "cmsis_compiler.h"
 #include "wit_c_sdk.h"
 #include "jy61p_app.h"
+#include "imu_sampler.h"
+#include "telemetry.h"
+#include "attitude_filter.h"
+#include "odometry.h"
 
 /* JY61P端口层接口声明 - 由具体端口层实现 */
 extern int32_t wit_port_i2c_init(void);
 extern int32_t wit_port_i2c_write(uint8_t ucAddr, uint8_t ucReg, uint8_t *p_ucVal, uint32_t uiLen);
 extern int32_t wit_port_i2c_read(uint8_t ucAddr, uint8_t ucReg, uint8_t *p_ucVal, uint32_t uiLen);
+extern int32_t wit_port_i2c_read_async(uint8_t ucAddr, uint8_t ucReg, uint8_t *p_ucVal, uint32_t uiLen,
+                                       WitI2cDoneCb done, void *p_ctx);
+extern int32_t wit_port_i2c_probe(uint8_t ucAddr7);
 extern int32_t wit_port_uart_init(uint32_t uiBaud);
 extern void wit_port_uart_write(uint8_t *p_ucData, uint32_t uiLen);
 extern int32_t wit_port_delay_init(void);
 extern void wit_port_delay_ms(uint16_t ucMs);
 extern void wit_port_delay_us(uint16_t ucUs);
+extern uint32_t tick_port_uptime_ms(void);
+extern uint32_t tick_port_cycles_per_us(void);
+extern int32_t flash_port_record_read(uint8_t id, uint32_t *p_value);
+extern int32_t flash_port_record_write(uint8_t id, uint32_t value);
+
+/* ========================================================================== */
+/*                              应用层配置                                    */
+/* ========================================================================== */
+
+#define JY61P_SAMPLE_RATE_HZ    200U    /**< 定时采样频率 (50-500Hz) */
+#define JY61P_LOOP_PERIOD_MS    10U     /**< 主循环周期 */
+#define JY61P_PRINT_DIVIDER     50U     /**< 打印分频: 每50个循环(500ms)打印一次 */
+#define JY61P_DEFAULT_ADDR      0x50    /**< JY61P出厂默认7位地址 */
+#define JY61P_NVM_ID_ADDR       0x01    /**< Flash参数记录ID: 上次找到的传感器地址 */
+#define JY61P_ATT_KP_NORMAL     1.0f    /**< 姿态滤波默认比例增益 */
+#define JY61P_ATT_KP_FAST       5.0f    /**< 姿态滤波快速收敛比例增益 */
+
+/**
+ * @brief 上电默认输出模式
+ * @note 0: printf文本输出, 1: 二进制遥测帧 (见telemetry.h)，运行时可用't'命令切换
+ */
+#ifndef JY61P_TELEMETRY_BINARY
+#define JY61P_TELEMETRY_BINARY  0
+#endif
 
 /* ========================================================================== */
 /*                              应用层数据结构                                */
@@ -35,12 +67,27 @@ extern void wit_port_delay_us(uint16_t ucUs);
  */
 typedef struct {
     volatile uint8_t data_update_flags;  /**< 数据更新标志 */
+    volatile uint8_t read_groups;        /**< 最近一次读取更新的分组 (在读取回调中整体写入，供发布使用) */
     volatile uint8_t cmd_received;       /**< 接收到的命令 */
-    jy61p_data_t sensor_data;            /**< JY61P传感器数据 */
     uint8_t sensor_found;                /**< 传感器是否找到 */
     uint8_t sensor_addr;                 /**< 传感器I2C地址 */
+    uint8_t binary_output;               /**< 1: 二进制遥测输出, 0: 文本输出 */
 } jy61p_app_context_t;
 
+/**
+ * @brief 传感器数据发布槽
+ * @details 三个槽构成三缓冲: 采样中断写入既非最新发布、也非正被借用的槽，
+ *          写完后再发布其序号，因此被借用的槽不会被改写。
+ *          seq在写入期间为奇数，拷贝读取者据此检测并重读被覆盖的数据(seqlock)。
+ */
+typedef struct {
+    volatile uint32_t seq;               /**< 写入序号，奇数表示正在写入 */
+    jy61p_data_t data;                   /**< 传感器数据 */
+} jy61p_data_slot_t;
+
+#define JY61P_SLOT_NUM      3U
+#define JY61P_SLOT_NONE     0xFFU
+
 /* ========================================================================== */
 /*                              数据更新标志定义                              */
 /* ========================================================================== */
@@ -57,17 +104,27 @@ typedef struct {
 
 static jy61p_app_context_t g_app_ctx = {0};  /**< JY61P应用上下文 */
 
+static jy61p_data_slot_t s_data_slots[JY61P_SLOT_NUM];          /**< 数据发布槽 */
+static volatile uint8_t s_latest_slot = JY61P_SLOT_NONE;        /**< 最新发布的槽 */
+static volatile uint8_t s_borrowed_slot = JY61P_SLOT_NONE;      /**< 正被借用的槽 */
+
 /* ========================================================================== */
 /*                              函数声明                                      */
 /* ========================================================================== */
 
 static int32_t jy61p_app_init(void);
 static int32_t jy61p_sensor_scan(void);
+static int32_t jy61p_sensor_try(uint8_t addr);
 static void jy61p_sensor_data_process(uint32_t uiReg, uint32_t uiRegNum);
 static void jy61p_delay_ms(uint16_t ucMs);
 static void jy61p_cmd_process(void);
+static void jy61p_sampler_restart(void);
 static void jy61p_show_help(void);
+static void jy61p_apply_bandwidth(int32_t bandwidth);
 static void jy61p_data_convert_and_print(void);
+static void jy61p_sample_publish(const imu_sample_t *sample);
+static void jy61p_telemetry_send_encoder(void);
+static void jy61p_telemetry_send_status(void);
 
 /* ========================================================================== */
 /*                              主函数                                        */
@@ -92,27 +149,57 @@ int jy61p_app_main(void)
     }
     
     // 扫描并连接传感器
+    uint32_t scan_start_ms = tick_port_uptime_ms();
     if (jy61p_sensor_scan() != 0) {
         printf("ERROR: No JY61P found! Please check connections.\r\n");
         return -1;
     }
+    uint32_t scan_ms = tick_port_uptime_ms() - scan_start_ms;
     
     printf("JY61P initialized successfully at address 0x%02X\r\n", g_app_ctx.sensor_addr);
     jy61p_show_help();
     
+    // 启动定时采样，样本由I2C完成中断写入无锁队列
+    if (imu_sampler_start(JY61P_SAMPLE_RATE_HZ) != 0) {
+        printf("ERROR: IMU sampler start failed!\r\n");
+        return -1;
+    }
+    
     // 主循环
+    uint32_t loop_cnt = 0;
+    uint8_t first_sample = 1;
+    imu_sample_t sample;
     while (1) {
-        // 读取传感器数据 (从AX开始读取12个寄存器)
-        WitReadReg(AX, 12);
-        
-        // 延时500ms
-        wit_port_delay_ms(500);
+        // 取出队列中的全部样本，避免队列溢出
+        while (imu_sampler_pop(&sample) == 0) {
+            if (first_sample) {
+                first_sample = 0;
+                printf("First IMU sample at %lu ms after reset (discovery %lu ms)\r\n",
+                       (unsigned long)tick_port_uptime_ms(), (unsigned long)scan_ms);
+            }
+            // 控制代码在此处消费带时间戳的样本
+            if (g_app_ctx.binary_output) {
+                telemetry_send_imu(&sample);
+            }
+        }
+        if (g_app_ctx.binary_output) {
+            jy61p_telemetry_send_encoder();
+        }
         
         // 处理用户命令
         jy61p_cmd_process();
         
-        // 处理传感器数据
-        jy61p_data_convert_and_print();
+        // 按较低频率打印传感器数据
+        if (++loop_cnt >= JY61P_PRINT_DIVIDER) {
+            loop_cnt = 0;
+            if (g_app_ctx.binary_output) {
+                jy61p_telemetry_send_status();
+            } else {
+                jy61p_data_convert_and_print();
+            }
+        }
+        
+        wit_port_delay_ms(JY61P_LOOP_PERIOD_MS);
     }
     
     return 0;
@@ -147,14 +234,19 @@ static int32_t jy61p_app_init(void)
     // 初始化JY61P SDK
     WitInit(WIT_PROTOCOL_I2C, 0x50);  // JY61P默认地址0x50
     WitI2cFuncRegister(wit_port_i2c_write, wit_port_i2c_read);
+    WitI2cAsyncFuncRegister(wit_port_i2c_read_async);
     WitRegisterCallBack(jy61p_sensor_data_process);
     WitDelayMsRegister(jy61p_delay_ms);
+    imu_sampler_set_hook(jy61p_sample_publish);
+    attitude_filter_init(NULL);
     
     // 初始化应用上下文
     memset(&g_app_ctx, 0, sizeof(g_app_ctx));
     g_app_ctx.cmd_received = 0xFF;  // 无效命令
+    g_app_ctx.binary_output = JY61P_TELEMETRY_BINARY;
     
     printf("JY61P application initialized successfully.\r\n");
+    telemetry_set_binary(g_app_ctx.binary_output);
     return 0;
 }
 
@@ -163,38 +255,76 @@ static int32_t jy61p_app_init(void)
 /* ========================================================================== */
 
 /**
- * @brief 自动扫描I2C总线上的JY61P传感器
+ * @brief 查找I2C总线上的JY61P传感器
  * @return 0: 找到传感器, -1: 未找到传感器
+ * @note 查找顺序: 默认地址0x50 -> Flash中保存的上次地址 -> 快速探测0x08-0x77。
+ *       每个地址先用短超时探测ACK，应答后再读加速度寄存器确认；
+ *       找到的地址与Flash中不同时写回Flash，下次上电可直接命中。
  */
 static int32_t jy61p_sensor_scan(void)
 {
+    uint32_t cached_addr = 0xFF;
+    uint8_t addr = JY61P_DEFAULT_ADDR;
+    int32_t found;
+
     printf("Scanning I2C bus for JY61P sensors...\r\n");
-    
-    // 遍历I2C地址从0到0x7E
-    for (uint8_t addr = 0; addr < 0x7F; addr++) {
-        // 使用当前地址初始化SDK
-        WitInit(WIT_PROTOCOL_I2C, addr);
-        
-        // 重试2次
-        for (int retry = 0; retry < 2; retry++) {
-            g_app_ctx.data_update_flags = 0;
-            
-            // 尝试读取3个加速度寄存器
-            WitReadReg(AX, 3);
-            wit_port_delay_ms(10);  // 等待传感器响应
-            
-            // 如果数据更新标志被置位，说明找到了传感器
-            if (g_app_ctx.data_update_flags != 0) {
-                g_app_ctx.sensor_found = 1;
-                g_app_ctx.sensor_addr = addr;
-                printf("Found JY61P at I2C address: 0x%02X\r\n", addr);
-                return 0;
-            }
+
+    // 1. 出厂默认地址
+    found = jy61p_sensor_try(addr);
+
+    // 2. 上次找到的地址
+    if (found != 0 && flash_port_record_read(JY61P_NVM_ID_ADDR, &cached_addr) == 0 &&
+        cached_addr <= 0x7F && cached_addr != JY61P_DEFAULT_ADDR) {
+        addr = (uint8_t)cached_addr;
+        found = jy61p_sensor_try(addr);
+    }
+
+    // 3. 快速探测全部非保留7位地址
+    for (uint8_t probe = 0x08; found != 0 && probe <= 0x77; probe++) {
+        if (probe == JY61P_DEFAULT_ADDR || probe == cached_addr) {
+            continue;  // 已尝试过
         }
+        addr = probe;
+        found = jy61p_sensor_try(addr);
     }
-    
-    printf("No JY61P found on I2C bus.\r\n");
-    return -1;
+
+    if (found != 0) {
+        printf("No JY61P found on I2C bus.\r\n");
+        return -1;
+    }
+
+    g_app_ctx.sensor_found = 1;
+    g_app_ctx.sensor_addr = addr;
+    printf("Found JY61P at I2C address: 0x%02X\r\n", addr);
+
+    if (addr != cached_addr && flash_port_record_write(JY61P_NVM_ID_ADDR, addr) != 0) {
+        printf("WARNING: Failed to save sensor address to flash.\r\n");
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 尝试在指定地址连接JY61P
+ * @param addr 7位I2C地址
+ * @return 0: 传感器应答且寄存器读取成功, -1: 失败
+ */
+static int32_t jy61p_sensor_try(uint8_t addr)
+{
+    // 无应答时几毫秒内返回，避免完整读操作的重试和长超时
+    if (!wit_port_i2c_probe(addr)) {
+        return -1;
+    }
+
+    WitInit(WIT_PROTOCOL_I2C, addr);
+
+    // 同步读取3个加速度寄存器，成功时回调在返回前置位更新标志
+    g_app_ctx.data_update_flags = 0;
+    if (WitReadReg(AX, 3) != WIT_HAL_OK || g_app_ctx.data_update_flags == 0) {
+        return -1;
+    }
+
+    return 0;
 }
 
 /* ========================================================================== */
@@ -209,26 +339,33 @@ static int32_t jy61p_sensor_scan(void)
  */
 static void jy61p_sensor_data_process(uint32_t uiReg, uint32_t uiRegNum)
 {
+    uint8_t groups = 0;
+
     for (uint32_t i = 0; i < uiRegNum; i++) {
         switch (uiReg) {
             case AZ:  // Z轴加速度更新时，认为整组加速度数据都已更新
-                g_app_ctx.data_update_flags |= ACC_UPDATE;
+                groups |= ACC_UPDATE;
                 break;
             case GZ:  // Z轴角速度更新时，认为整组角速度数据都已更新
-                g_app_ctx.data_update_flags |= GYRO_UPDATE;
+                groups |= GYRO_UPDATE;
                 break;
             case HZ:  // Z轴磁场更新时，认为整组磁场数据都已更新
-                g_app_ctx.data_update_flags |= MAG_UPDATE;
+                groups |= MAG_UPDATE;
                 break;
             case Yaw: // 偏航角更新时，认为整组角度数据都已更新
-                g_app_ctx.data_update_flags |= ANGLE_UPDATE;
+                groups |= ANGLE_UPDATE;
                 break;
             default:
-                g_app_ctx.data_update_flags |= READ_UPDATE;
+                groups |= READ_UPDATE;
                 break;
         }
         uiReg++;
     }
+
+    // 异步读取时本回调与发布钩子在同一完成中断中先后执行，发布只使用这里锁存的分组，
+    // 不读主循环会清除的data_update_flags
+    g_app_ctx.read_groups = groups;
+    g_app_ctx.data_update_flags |= groups;
 }
 
 /**
@@ -245,63 +382,158 @@ static void jy61p_delay_ms(uint16_t ucMs)
 /* ========================================================================== */
 
 /**
- * @brief JY61P数据转换和打印
+ * @brief 转换样本并发布到数据槽 (I2C完成中断上下文)
+ * @param sample IMU原始样本
+ */
+static void jy61p_sample_publish(const imu_sample_t *sample)
+{
+    static uint32_t s_last_timestamp = 0;
+    static uint8_t s_has_last = 0;
+    jy61p_data_slot_t *slot;
+    attitude_t att;
+    float dt;
+    uint8_t latest = s_latest_slot;
+    uint8_t borrowed = s_borrowed_slot;
+    uint8_t groups = g_app_ctx.read_groups & IMU_GROUP_ALL;  // 本次读取更新的分组 (读取回调中锁存)
+    uint8_t w = 0;
+
+    // 选择既非最新发布、也非正被借用的槽
+    while (w == latest || w == borrowed) {
+        w++;
+    }
+    slot = &s_data_slots[w];
+
+    slot->seq++;  // 奇数: 正在写入
+    __COMPILER_BARRIER();
+
+    // 只有部分分组更新时，其余分组沿用最新发布的值
+    if (groups != IMU_GROUP_ALL && latest < JY61P_SLOT_NUM) {
+        slot->data = s_data_slots[latest].data;
+    }
+
+    // 仅转换被标记的分组: 加速度(g)、角速度(°/s)、角度(°)
+    imu_convert_f32(sample->reg, groups, slot->data.acc, slot->data.gyro, slot->data.angle);
+    // 磁场数据直接使用原始值
+    if (groups & IMU_GROUP_MAG) {
+        memcpy(slot->data.mag, &sample->reg[IMU_REG_MAG], sizeof(slot->data.mag));
+    }
+
+    // 姿态滤波，dt由相邻样本的节拍时间戳得到
+    dt = s_has_last ? (float)(sample->timestamp - s_last_timestamp) / (tick_port_cycles_per_us() * 1e6f) : 0.0f;
+    s_last_timestamp = sample->timestamp;
+    s_has_last = 1;
+    if (attitude_filter_update(slot->data.gyro, slot->data.acc, dt, &att) == 0) {
+        memcpy(slot->data.q, att.q, sizeof(slot->data.q));
+        memcpy(slot->data.attitude, att.euler, sizeof(slot->data.attitude));
+    } else {
+        // 首个样本或间隔异常，沿用上一次发布的姿态
+        if (latest < JY61P_SLOT_NUM) {
+            memcpy(slot->data.q, s_data_slots[latest].data.q, sizeof(slot->data.q));
+            memcpy(slot->data.attitude, s_data_slots[latest].data.attitude, sizeof(slot->data.attitude));
+        } else {
+            slot->data.q[0] = 1.0f;
+        }
+    }
+
+    // 陀螺Z轴角速度提供给里程计做航向融合
+    if (groups & IMU_GROUP_GYRO) {
+        odometry_feed_gyro_z(slot->data.gyro[2]);
+    }
+
+    // 温度不在采样寄存器块内，使用最近一次读到的值
+    slot->data.temp = sReg[TEMP];
+    slot->data.timestamp = sample->timestamp;
+    slot->data.seq = sample->seq;
+
+    __COMPILER_BARRIER();
+    slot->seq++;  // 偶数: 写入完成
+    s_latest_slot = w;
+}
+
+/**
+ * @brief JY61P数据打印
  */
 static void jy61p_data_convert_and_print(void)
 {
+    jy61p_data_t data;
+
     if (g_app_ctx.data_update_flags == 0) {
         return;  // 无数据更新
     }
 
-    // 转换原始数据为物理量
-    for (int i = 0; i < 3; i++) {
-        // 加速度(g) = (原始值 / 32768) * 16
-        g_app_ctx.sensor_data.acc[i] = sReg[AX + i] / 32768.0f * 16.0f;
-        // 角速度(°/s) = (原始值 / 32768) * 2000
-        g_app_ctx.sensor_data.gyro[i] = sReg[GX + i] / 32768.0f * 2000.0f;
-        // 角度(°) = (原始值 / 32768) * 180
-        g_app_ctx.sensor_data.angle[i] = sReg[Roll + i] / 32768.0f * 180.0f;
-        // 磁场数据直接使用原始值
-        g_app_ctx.sensor_data.mag[i] = sReg[HX + i];
+    // 取一致的快照
+    if (jy61p_get_sensor_data(&data) != 0) {
+        return;
     }
 
-    // 温度数据
-    g_app_ctx.sensor_data.temp = sReg[TEMP];
-
     // 根据更新标志打印相应数据
     if (g_app_ctx.data_update_flags & ACC_UPDATE) {
         printf("ACC : %.3f %.3f %.3f (g)\r\n",
-               g_app_ctx.sensor_data.acc[0],
-               g_app_ctx.sensor_data.acc[1],
-               g_app_ctx.sensor_data.acc[2]);
+               data.acc[0],
+               data.acc[1],
+               data.acc[2]);
         g_app_ctx.data_update_flags &= ~ACC_UPDATE;
     }
 
     if (g_app_ctx.data_update_flags & GYRO_UPDATE) {
         printf("GYRO: %.3f %.3f %.3f (°/s)\r\n",
-               g_app_ctx.sensor_data.gyro[0],
-               g_app_ctx.sensor_data.gyro[1],
-               g_app_ctx.sensor_data.gyro[2]);
+               data.gyro[0],
+               data.gyro[1],
+               data.gyro[2]);
         g_app_ctx.data_update_flags &= ~GYRO_UPDATE;
     }
 
     if (g_app_ctx.data_update_flags & ANGLE_UPDATE) {
         printf("ANGLE: %.3f %.3f %.3f (°)\r\n",
-               g_app_ctx.sensor_data.angle[0],
-               g_app_ctx.sensor_data.angle[1],
-               g_app_ctx.sensor_data.angle[2]);
+               data.angle[0],
+               data.angle[1],
+               data.angle[2]);
+        printf("ATT : %.3f %.3f %.3f (°)\r\n",
+               data.attitude[0],
+               data.attitude[1],
+               data.attitude[2]);
         g_app_ctx.data_update_flags &= ~ANGLE_UPDATE;
     }
 
     if (g_app_ctx.data_update_flags & MAG_UPDATE) {
         printf("MAG : %d %d %d (raw)\r\n",
-               g_app_ctx.sensor_data.mag[0],
-               g_app_ctx.sensor_data.mag[1],
-               g_app_ctx.sensor_data.mag[2]);
+               data.mag[0],
+               data.mag[1],
+               data.mag[2]);
         g_app_ctx.data_update_flags &= ~MAG_UPDATE;
     }
 }
 
+/**
+ * @brief 二进制模式下每个主循环发送一次编码器位置帧
+ * @note 编码器未启动或快照自上次发送后未更新时不发送
+ */
+static void jy61p_telemetry_send_encoder(void)
+{
+    static uint32_t last_updates = 0;
+    wheel_enc_snapshot_t snap;
+
+    wheel_enc_get(&snap);
+    if (snap.updates == 0U || snap.updates == last_updates) {
+        return;
+    }
+    last_updates = snap.updates;
+    telemetry_send_encoder(&snap);
+}
+
+/**
+ * @brief 二进制模式下低频发送的状态帧
+ * @note IMU样本帧在主循环中逐个发送，此处仅发送变化较慢的电机状态
+ */
+static void jy61p_telemetry_send_status(void)
+{
+    motor_app_status_t motor_status;
+
+    if (motor_app_get_status(&motor_status) == 0) {
+        telemetry_send_motor(&motor_status);
+    }
+}
+
 /* ========================================================================== */
 /*                              命令处理                                      */
 /* ========================================================================== */
@@ -314,6 +546,19 @@ static void jy61p_cmd_process(void)
     // 这里应该从串口接收命令，暂时使用全局变量模拟
     // 实际实现中需要在串口中断中调用 jy61p_cmd_data_received()
 
+    if (g_app_ctx.cmd_received == 0xFF) {
+        return;  // 无效命令，不处理
+    }
+
+    // 配置命令使用同步I2C写入，期间暂停定时采样以免与异步读取争用总线
+    imu_sampler_stop();
+    if (imu_sampler_wait_idle() != 0) {
+        printf("ERROR: IMU read did not finish, command '%c' dropped.\r\n", g_app_ctx.cmd_received);
+        g_app_ctx.cmd_received = 0xFF;
+        jy61p_sampler_restart();
+        return;
+    }
+
     switch (g_app_ctx.cmd_received) {
         case 'a':  // 加速度计校准
             printf("Starting accelerometer calibration...\r\n");
@@ -344,20 +589,12 @@ static void jy61p_cmd_process(void)
 
         case 'u':  // 设置带宽为5Hz
             printf("Setting bandwidth to 5Hz...\r\n");
-            if (WitSetBandwidth(BANDWIDTH_5HZ) != WIT_HAL_OK) {
-                printf("ERROR: Set bandwidth failed!\r\n");
-            } else {
-                printf("Bandwidth set to 5Hz successfully.\r\n");
-            }
+            jy61p_apply_bandwidth(BANDWIDTH_5HZ);
             break;
 
         case 'U':  // 设置带宽为256Hz
             printf("Setting bandwidth to 256Hz...\r\n");
-            if (WitSetBandwidth(BANDWIDTH_256HZ) != WIT_HAL_OK) {
-                printf("ERROR: Set bandwidth failed!\r\n");
-            } else {
-                printf("Bandwidth set to 256Hz successfully.\r\n");
-            }
+            jy61p_apply_bandwidth(BANDWIDTH_256HZ);
             break;
 
         case 'B':  // 设置JY61P串口波特率为115200
@@ -378,13 +615,46 @@ static void jy61p_cmd_process(void)
             }
             break;
 
+        case 't':  // 切换文本/二进制遥测输出
+            // 进入二进制前先打印提示，退出二进制后再打印，提示文本不混入帧流
+            if (!g_app_ctx.binary_output) {
+                printf("Output mode: binary telemetry\r\n");
+            }
+            g_app_ctx.binary_output = !g_app_ctx.binary_output;
+            telemetry_set_binary(g_app_ctx.binary_output);
+            if (!g_app_ctx.binary_output) {
+                printf("Output mode: text\r\n");
+            }
+            break;
+
+        case 'k':  // 切换姿态滤波增益
+        {
+            static uint8_t s_fast_gain = 0;
+            attitude_stats_t att_stats;
+            s_fast_gain = !s_fast_gain;
+            attitude_filter_set_gain(s_fast_gain ? JY61P_ATT_KP_FAST : JY61P_ATT_KP_NORMAL, 0.0f);
+            attitude_filter_get_stats(&att_stats);
+            printf("Attitude Kp = %.1f, update cycles last/max = %lu/%lu, over budget = %lu\r\n",
+                   s_fast_gain ? JY61P_ATT_KP_FAST : JY61P_ATT_KP_NORMAL,
+                   (unsigned long)att_stats.last_cycles, (unsigned long)att_stats.max_cycles,
+                   (unsigned long)att_stats.budget_overruns);
+            break;
+        }
+
+        case 'c':  // 转换耗时对比
+        {
+            imu_convert_bench_t bench;
+            imu_convert_benchmark(&sReg[AX], &bench);
+            printf("Convert cycles: legacy %lu, f32 %lu, fixed %lu\r\n",
+                   (unsigned long)bench.legacy_cycles, (unsigned long)bench.f32_cycles,
+                   (unsigned long)bench.fixed_cycles);
+            break;
+        }
+
         case 'h':  // 显示帮助信息
             jy61p_show_help();
             break;
 
-        case 0xFF:  // 无效命令，不处理
-            return;
-
         default:
             printf("Unknown command: '%c'. Send 'h' for help.\r\n", g_app_ctx.cmd_received);
             break;
@@ -392,6 +662,39 @@ static void jy61p_cmd_process(void)
 
     // 命令处理完毕，复位命令变量
     g_app_ctx.cmd_received = 0xFF;
+
+    jy61p_sampler_restart();
+}
+
+/**
+ * @brief 命令处理后恢复定时采样
+ * @note 失败时采样保持停止，每条命令都会再次尝试
+ */
+static void jy61p_sampler_restart(void)
+{
+    if (imu_sampler_start(JY61P_SAMPLE_RATE_HZ) != 0) {
+        printf("ERROR: IMU sampler restart failed, sampling stopped!\r\n");
+    }
+}
+
+/**
+ * @brief 以配置事务设置带宽
+ * @param bandwidth 带宽 (BANDWIDTH_*)
+ * @note 先回读寄存器，值已相同则不解锁、不写入，切换驱动模式时可重复调用
+ */
+static void jy61p_apply_bandwidth(int32_t bandwidth)
+{
+    wit_cfg_txn_t txn;
+
+    WitCfgBegin(&txn);
+    WitCfgStage(&txn, BANDWIDTH, (uint16_t)bandwidth);
+    if (WitCfgCommit(&txn, WIT_CFG_SKIP_SAME) != WIT_HAL_OK) {
+        printf("ERROR: Set bandwidth failed!\r\n");
+    } else if (txn.ucWritten == 0) {
+        printf("Bandwidth already set, nothing written.\r\n");
+    } else {
+        printf("Bandwidth set successfully.\r\n");
+    }
 }
 
 /**
@@ -411,6 +714,9 @@ static void jy61p_show_help(void)
     printf("  U\\r\\n  - Set bandwidth to 256Hz\r\n");
     printf("  b\\r\\n  - Set JY61P UART baud to 9600\r\n");
     printf("  B\\r\\n  - Set JY61P UART baud to 115200\r\n");
+    printf("  t\\r\\n  - Toggle text / binary telemetry output\r\n");
+    printf("  k\\r\\n  - Toggle attitude filter gain (Kp 1.0 / 5.0)\r\n");
+    printf("  c\\r\\n  - Show raw-to-physical conversion cycle counts\r\n");
     printf("  h\\r\\n  - Show this help information\r\n");
     printf("**************************************************************************\r\n");
     printf("Data Format:\r\n");
@@ -418,6 +724,7 @@ static void jy61p_show_help(void)
     printf("  GYRO: X Y Z (°/s)    - Angular velocity in degrees per second\r\n");
     printf("  ANGLE: X Y Z (°)     - Euler angles in degrees\r\n");
     printf("  MAG : X Y Z (raw)    - Magnetic field raw values\r\n");
+    printf("  ATT : X Y Z (°)      - On-MCU attitude filter Euler angles\r\n");
     printf("**************************************************************************\r\n");
     printf("\r\n");
 }
@@ -481,10 +788,41 @@ int32_t jy61p_get_sensor_data(jy61p_data_t *data)
         return -1;
     }
 
-    memcpy(data, &g_app_ctx.sensor_data, sizeof(jy61p_data_t));
+    uint8_t idx;
+    uint32_t seq;
+    do {
+        idx = s_latest_slot;
+        if (idx >= JY61P_SLOT_NUM) {
+            return -1;  // 尚无样本
+        }
+        seq = s_data_slots[idx].seq;
+        __COMPILER_BARRIER();
+        memcpy(data, &s_data_slots[idx].data, sizeof(jy61p_data_t));
+        __COMPILER_BARRIER();
+        // 拷贝前正在写入或拷贝期间被改写则重读
+    } while ((seq & 1U) != 0 || s_data_slots[idx].seq != seq);
+
     return 0;
 }
 
+/**
+ * @brief 借用最新的JY61P传感器数据 (零拷贝)
+ * @return 最新样本指针，尚无样本时返回NULL
+ * @note 先登记借用再使用: 采样中断选择写入槽时会避开已登记的槽，
+ *       登记之前即使被新样本抢占，该槽中也是一份完整的样本
+ */
+const jy61p_data_t *jy61p_borrow_latest(void)
+{
+    uint8_t idx = s_latest_slot;
+
+    if (idx >= JY61P_SLOT_NUM) {
+        return NULL;
+    }
+
+    s_borrowed_slot = idx;
+    return &s_data_slots[idx].data;
+}
+
 /**
  * @brief 检查JY61P传感器是否已连接
  * @return 1: 已连接, 0: 未连接
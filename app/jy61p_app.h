@@ -38,6 +38,10 @@ typedef struct {
     float angle[3];  /**< 三轴角度 [Roll, Pitch, Yaw] (°) */
     int16_t mag[3];  /**< 三轴磁场 [X, Y, Z] (原始值) */
     int16_t temp;    /**< 温度 (原始值) */
+    float q[4];      /**< 机载姿态滤波四元数 [w, x, y, z] */
+    float attitude[3]; /**< 机载姿态滤波欧拉角 [Roll, Pitch, Yaw] (°) */
+    uint32_t timestamp; /**< 采样时刻的CPU周期计数 */
+    uint32_t seq;       /**< 样本序号 */
 } jy61p_data_t;
 
 /* ========================================================================== */
@@ -47,8 +51,10 @@ typedef struct {
 /**
  * @brief 获取当前JY61P传感器数据
  * @param data 输出参数，存储JY61P传感器数据的指针
- * @return 0: 成功获取数据, -1: 失败（传感器未连接或参数无效）
- * @note 此函数返回最新的JY61P传感器数据，数据已转换为标准物理单位
+ * @return 0: 成功获取数据, -1: 失败（传感器未连接、尚无样本或参数无效）
+ * @note 此函数返回最新的JY61P传感器数据，数据已转换为标准物理单位。
+ *       数据在采样中断中发布，拷贝期间若被新样本覆盖会自动重读，
+ *       保证各字段来自同一样本，无需关中断，可在任意上下文调用
  * 
  * @code
  * jy61p_data_t data;
@@ -59,6 +65,22 @@ typedef struct {
  */
 int32_t jy61p_get_sensor_data(jy61p_data_t *data);
 
+/**
+ * @brief 借用最新的JY61P传感器数据 (零拷贝)
+ * @return const jy61p_data_t* 最新样本指针，尚无样本时返回NULL
+ * @note 返回的数据在下一次调用本函数之前保持不变，不会被采样中断改写。
+ *       仅允许单一调用者(如控制循环)使用，其他模块请使用jy61p_get_sensor_data()
+ *
+ * @code
+ * // 1kHz控制循环中
+ * const jy61p_data_t *imu = jy61p_borrow_latest();
+ * if (imu != NULL) {
+ *     yaw_rate = imu->gyro[2];
+ * }
+ * @endcode
+ */
+const jy61p_data_t *jy61p_borrow_latest(void);
+
 /**
  * @brief 检查JY61P传感器是否已连接
  * @return 1: JY61P传感器已连接并正常工作, 0: 传感器未连接
@@ -130,6 +152,9 @@ int jy61p_app_main(void);
  * - 'U' + \r\n: 设置带宽为256Hz
  * - 'b' + \r\n: 设置传感器串口波特率为9600
  * - 'B' + \r\n: 设置传感器串口波特率为115200
+ * - 't' + \r\n: 切换文本/二进制遥测输出
+ * - 'k' + \r\n: 切换姿态滤波增益 (Kp 1.0 / 5.0)
+ * - 'c' + \r\n: 显示原始值转换耗时对比 (CPU周期)
  * - 'h' + \r\n: 显示帮助信息
  * 
  * @section jy61p_data_format 数据格式
@@ -138,6 +163,10 @@ int jy61p_app_main(void);
  * - GYRO: X Y Z (°/s) - 角速度，单位为度每秒
  * - ANGLE: X Y Z (°) - 欧拉角，单位为度
  * - MAG : X Y Z (raw) - 磁场原始值
+ * - ATT : X Y Z (°) - 机载姿态滤波欧拉角 (由原始角速度/加速度解算)
+ *
+ * 二进制遥测模式下输出COBS编码的帧 (格式见telemetry.h)，
+ * 主机端使用 tools/telemetry_decode.py 解码。
  */
 
 #ifdef __cplusplus
@@ -0,0 +1,308 @@
+/**
+ * @file key_input.c
+ * @brief 非阻塞按键扫描与事件队列实现
+ * @details 节拍中断读取一次按键口，垂直计数器消抖后按边沿和计时生成事件入队。
+ * @date 2026-10-16
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "cmsis_compiler.h"
+#include "key_input.h"
+
+extern void key_port_init(void);
+extern uint8_t key_port_read(void);
+extern int32_t tick_port_key_start(uint32_t rate_hz, void (*cb)(void));
+extern void tick_port_key_stop(void);
+extern uint32_t tick_port_cycles(void);
+extern uint32_t tick_port_uptime_ms(void);
+extern uint32_t tick_port_ms_to_ticks(uint32_t ms, uint32_t rate_hz);
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+#define KEY_INPUT_QUEUE_MASK        (KEY_INPUT_QUEUE_SIZE - 1U)
+#define KEY_INPUT_ALL               ((uint8_t)((1U << KEY_INPUT_NUM) - 1U))
+#define KEY_INPUT_HELD_MAX          0xFFFFU
+
+/* ========================================================================== */
+/*                              私有数据结构                                  */
+/* ========================================================================== */
+
+/**
+ * @brief SPSC事件队列
+ */
+typedef struct {
+    key_event_t buf[KEY_INPUT_QUEUE_SIZE];
+    volatile uint32_t head;     /**< 写索引 (仅生产者修改) */
+    volatile uint32_t tail;     /**< 读索引 (仅消费者修改) */
+} key_event_queue_t;
+
+/**
+ * @brief 扫描状态 (仅节拍中断读写，启动时在节拍停止后初始化)
+ * @note 按位的字段中位i对应KEY i
+ */
+typedef struct {
+    volatile uint8_t state;     /**< 消抖后的状态，1为按下 */
+    uint8_t ct0;                /**< 垂直计数器低位 */
+    uint8_t ct1;                /**< 垂直计数器高位 */
+    uint8_t long_sent;          /**< 本次按下已产生长按事件 */
+    uint8_t click_pending;      /**< 短按已松开，等待双击的第二次按下 */
+    uint8_t second_press;       /**< 本次按下是双击的第二次，松开后不再等待双击 */
+    uint16_t held[KEY_INPUT_NUM];   /**< 按住的节拍数 */
+    uint16_t gap[KEY_INPUT_NUM];    /**< 短按松开后的节拍数 */
+    uint16_t long_ticks;        /**< 长按节拍数 */
+    uint16_t double_ticks;      /**< 双击间隔节拍数 */
+    uint32_t rate_hz;           /**< 扫描频率 */
+} key_scan_t;
+
+/* ========================================================================== */
+/*                              私有变量                                      */
+/* ========================================================================== */
+
+static key_event_queue_t s_queue;
+static key_scan_t s_scan;
+static key_input_stats_t s_stats;
+
+/* ========================================================================== */
+/*                              私有函数声明                                  */
+/* ========================================================================== */
+
+static void key_input_tick(void);
+static void key_input_key(uint8_t key, uint8_t pressed, uint8_t released, uint32_t now_ms);
+static void key_input_emit(uint8_t key, uint8_t type, uint16_t held_ticks, uint32_t now_ms);
+
+/* ========================================================================== */
+/*                              公共函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 启动按键扫描
+ */
+int32_t key_input_start(uint32_t rate_hz, uint32_t long_ms, uint32_t double_ms)
+{
+    uint32_t long_ticks;
+    uint32_t double_ticks;
+
+    if (rate_hz == 0) {
+        rate_hz = KEY_INPUT_DEFAULT_RATE_HZ;
+    }
+    if (long_ms == 0) {
+        long_ms = KEY_INPUT_DEFAULT_LONG_MS;
+    }
+    if (double_ms == 0) {
+        double_ms = KEY_INPUT_DEFAULT_DOUBLE_MS;
+    }
+    if (rate_hz < KEY_INPUT_RATE_MIN_HZ || rate_hz > KEY_INPUT_RATE_MAX_HZ) {
+        return -1;
+    }
+
+    long_ticks = tick_port_ms_to_ticks(long_ms, rate_hz);
+    double_ticks = tick_port_ms_to_ticks(double_ms, rate_hz);
+
+    tick_port_key_stop();
+    key_port_init();
+
+    /* 计数器全1: 任一位须连续4次与状态不同才翻转 */
+    memset(&s_scan, 0, sizeof(s_scan));
+    s_scan.ct0 = 0xFFU;
+    s_scan.ct1 = 0xFFU;
+    /* 按住计数为16位，超出部分取上限 */
+    s_scan.long_ticks = (uint16_t)((long_ticks < KEY_INPUT_HELD_MAX) ? long_ticks : KEY_INPUT_HELD_MAX);
+    s_scan.double_ticks = (uint16_t)((double_ticks < KEY_INPUT_HELD_MAX) ? double_ticks : KEY_INPUT_HELD_MAX);
+    s_scan.rate_hz = rate_hz;
+
+    s_queue.head = 0;
+    s_queue.tail = 0;
+
+    if (tick_port_key_start(rate_hz, key_input_tick) != 0) {
+        return -2;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 停止按键扫描
+ */
+void key_input_stop(void)
+{
+    tick_port_key_stop();
+}
+
+/**
+ * @brief 从队列取出一个事件
+ */
+int32_t key_input_pop(key_event_t *event)
+{
+    uint32_t tail = s_queue.tail;
+
+    if (event == NULL || tail == s_queue.head) {
+        return -1;
+    }
+    __COMPILER_BARRIER();   /* 看到写索引之后才读槽位 */
+
+    *event = s_queue.buf[tail & KEY_INPUT_QUEUE_MASK];
+
+    /* 先完成数据拷贝再释放槽位 */
+    __COMPILER_BARRIER();
+    s_queue.tail = tail + 1U;
+    return 0;
+}
+
+/**
+ * @brief 当前队列中的事件数
+ */
+uint32_t key_input_available(void)
+{
+    return s_queue.head - s_queue.tail;
+}
+
+/**
+ * @brief 读取消抖后的按键状态
+ */
+uint8_t key_input_state(void)
+{
+    return s_scan.state;
+}
+
+/**
+ * @brief 获取扫描统计
+ */
+void key_input_get_stats(key_input_stats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+    *stats = s_stats;
+}
+
+/**
+ * @brief 清零扫描统计
+ */
+void key_input_reset_stats(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+/* ========================================================================== */
+/*                              私有函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 扫描节拍回调 (定时器中断上下文)
+ * @note 垂直计数器: 与状态相同的位计数器复位为3，不同的位每节拍减1，
+ *       从0再减即翻转状态；只有有边沿、按住或等待双击的按键才进入逐键处理
+ */
+static void key_input_tick(void)
+{
+    uint32_t entry = tick_port_cycles();
+    uint32_t exec, now_ms;
+    uint8_t sample, diff, toggled, active;
+    uint8_t i;
+
+    sample = key_port_read();
+
+    diff = (uint8_t)(s_scan.state ^ sample);
+    s_scan.ct0 = (uint8_t)~(s_scan.ct0 & diff);
+    s_scan.ct1 = (uint8_t)(s_scan.ct0 ^ (s_scan.ct1 & diff));
+    toggled = (uint8_t)(diff & s_scan.ct0 & s_scan.ct1 & KEY_INPUT_ALL);
+    s_scan.state ^= toggled;
+
+    active = (uint8_t)(toggled | s_scan.state | s_scan.click_pending);
+    if (active != 0U) {
+        now_ms = tick_port_uptime_ms();
+        for (i = 0; i < KEY_INPUT_NUM; i++) {
+            if ((active & (1U << i)) != 0U) {
+                key_input_key(i, (uint8_t)(toggled & s_scan.state & (1U << i)),
+                              (uint8_t)(toggled & ~s_scan.state & (1U << i)), now_ms);
+            }
+        }
+    }
+
+    s_stats.ticks++;
+    exec = tick_port_cycles() - entry;
+    if (exec > s_stats.exec_cycles_max) {
+        s_stats.exec_cycles_max = exec;
+    }
+}
+
+/**
+ * @brief 单个按键的计时与事件
+ * @param pressed 本节拍消抖后按下 (非0)
+ * @param released 本节拍消抖后松开 (非0)
+ */
+static void key_input_key(uint8_t key, uint8_t pressed, uint8_t released, uint32_t now_ms)
+{
+    uint8_t bit = (uint8_t)(1U << key);
+
+    if (pressed) {
+        s_scan.held[key] = 0;
+        s_scan.long_sent &= (uint8_t)~bit;
+        key_input_emit(key, KEY_EVENT_PRESS, 0, now_ms);
+        if ((s_scan.click_pending & bit) != 0U) {
+            s_scan.click_pending &= (uint8_t)~bit;
+            s_scan.second_press |= bit;
+            key_input_emit(key, KEY_EVENT_DOUBLE, 0, now_ms);
+        } else {
+            s_scan.second_press &= (uint8_t)~bit;
+        }
+        return;
+    }
+
+    if (released) {
+        key_input_emit(key, KEY_EVENT_RELEASE, s_scan.held[key], now_ms);
+        /* 长按或双击的第二次松开后不再等待双击，三连击不会产生两次双击 */
+        if ((s_scan.long_sent & bit) == 0U && (s_scan.second_press & bit) == 0U) {
+            s_scan.click_pending |= bit;
+            s_scan.gap[key] = 0;
+        }
+        return;
+    }
+
+    if ((s_scan.state & bit) != 0U) {
+        if (s_scan.held[key] < KEY_INPUT_HELD_MAX) {
+            s_scan.held[key]++;
+        }
+        if (s_scan.held[key] == s_scan.long_ticks && (s_scan.long_sent & bit) == 0U) {
+            s_scan.long_sent |= bit;
+            key_input_emit(key, KEY_EVENT_LONG, s_scan.held[key], now_ms);
+        }
+        return;
+    }
+
+    /* 等待双击 */
+    if (++s_scan.gap[key] >= s_scan.double_ticks) {
+        s_scan.click_pending &= (uint8_t)~bit;
+    }
+}
+
+/**
+ * @brief 事件入队 (仅生产者调用)
+ */
+static void key_input_emit(uint8_t key, uint8_t type, uint16_t held_ticks, uint32_t now_ms)
+{
+    uint32_t head = s_queue.head;
+    uint32_t held_ms;
+    key_event_t *ev;
+
+    if ((head - s_queue.tail) >= KEY_INPUT_QUEUE_MASK) {
+        s_stats.queue_overruns++;
+        return;
+    }
+    __COMPILER_BARRIER();   /* 确认槽位已被释放之后才写入 */
+
+    held_ms = ((uint32_t)held_ticks * 1000UL) / s_scan.rate_hz;
+
+    ev = &s_queue.buf[head & KEY_INPUT_QUEUE_MASK];
+    ev->key = key;
+    ev->type = type;
+    ev->held_ms = (uint16_t)((held_ms < KEY_INPUT_HELD_MAX) ? held_ms : KEY_INPUT_HELD_MAX);
+    ev->time_ms = now_ms;
+
+    /* 先写数据再发布写索引 */
+    __COMPILER_BARRIER();
+    s_queue.head = head + 1U;
+    s_stats.events++;
+}
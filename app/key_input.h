@@ -0,0 +1,140 @@
+/**
+ * @file key_input.h
+ * @brief 非阻塞按键扫描与事件队列接口
+ * @details 定时器节拍(TIM14，默认5ms)中一次读取全部按键，用垂直计数器按位并行消抖:
+ *          每个按键一个2位计数器，分别存放在两个字节的对应位上，连续4次采样与当前状态
+ *          不同才翻转，4个按键只需几次位运算。消抖后的边沿生成事件:
+ *          - 按下 / 松开 (松开事件带按住时长)
+ *          - 长按: 按住达到long_ms时产生一次
+ *          - 双击: 上一次短按松开后double_ms内再次按下，紧随该次按下事件产生
+ *          事件写入单生产者/单消费者(SPSC)无锁队列，由主循环取出，
+ *          模式选择和调参不再需要HAL_Delay消抖。
+ * @date 2026-10-16
+ *
+ * @note 生产者: 按键节拍中断; 消费者: 主循环(或单一低优先级任务)
+ *       同一时刻只允许一个消费者调用key_input_pop()
+ */
+
+#ifndef KEY_INPUT_H__
+#define KEY_INPUT_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/*                              配置参数                                      */
+/* ========================================================================== */
+
+#define KEY_INPUT_NUM               4U      /**< 按键数 (PF2-PF5) */
+#define KEY_INPUT_RATE_MIN_HZ       200U    /**< 最低扫描频率 (5ms) */
+#define KEY_INPUT_RATE_MAX_HZ       1000U   /**< 最高扫描频率 (1ms) */
+#define KEY_INPUT_DEFAULT_RATE_HZ   200U    /**< 默认扫描频率，消抖时间为4个节拍即20ms */
+#define KEY_INPUT_DEFAULT_LONG_MS   800U    /**< 默认长按时间 */
+#define KEY_INPUT_DEFAULT_DOUBLE_MS 300U    /**< 默认双击间隔 */
+
+/**
+ * @brief 事件队列深度 (必须为2的幂)
+ * @note 实际可用容量为 KEY_INPUT_QUEUE_SIZE - 1
+ */
+#ifndef KEY_INPUT_QUEUE_SIZE
+#define KEY_INPUT_QUEUE_SIZE        16U
+#endif
+
+#if (KEY_INPUT_QUEUE_SIZE & (KEY_INPUT_QUEUE_SIZE - 1U)) != 0U
+#error "KEY_INPUT_QUEUE_SIZE must be a power of two"
+#endif
+
+/* ========================================================================== */
+/*                              数据结构定义                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 按键事件类型
+ */
+typedef enum {
+    KEY_EVENT_PRESS = 0,            /**< 按下 (消抖后) */
+    KEY_EVENT_RELEASE,              /**< 松开 */
+    KEY_EVENT_LONG,                 /**< 长按 (每次按下最多一次) */
+    KEY_EVENT_DOUBLE                /**< 双击 (紧随第二次按下事件) */
+} key_event_type_t;
+
+/**
+ * @brief 按键事件
+ */
+typedef struct {
+    uint8_t key;                    /**< 按键编号 (0: PF2 ... 3: PF5) */
+    uint8_t type;                   /**< key_event_type_t */
+    uint16_t held_ms;               /**< 已按住时长 (松开/长按事件有效，上限65535) */
+    uint32_t time_ms;               /**< 事件时刻 (上电以来的毫秒数) */
+} key_event_t;
+
+/**
+ * @brief 扫描统计
+ */
+typedef struct {
+    uint32_t ticks;                 /**< 扫描次数 */
+    uint32_t events;                /**< 成功写入队列的事件数 */
+    uint32_t queue_overruns;        /**< 队列满而丢弃的事件数 */
+    uint32_t exec_cycles_max;       /**< 单次扫描最大耗时 (DWT周期) */
+} key_input_stats_t;
+
+/* ========================================================================== */
+/*                              API接口                                       */
+/* ========================================================================== */
+
+/**
+ * @brief 启动按键扫描
+ * @param rate_hz 扫描频率 (Hz)，范围: 200-1000，0表示KEY_INPUT_DEFAULT_RATE_HZ
+ * @param long_ms 长按时间 (ms)，0表示KEY_INPUT_DEFAULT_LONG_MS
+ * @param double_ms 双击间隔 (ms)，0表示KEY_INPUT_DEFAULT_DOUBLE_MS
+ * @return int32_t 错误码
+ * @retval 0 启动成功
+ * @retval -1 参数无效
+ * @retval -2 节拍定时器启动失败
+ * @note 使能按键上拉并清空队列；启动时已按住的按键在消抖后产生按下事件
+ */
+int32_t key_input_start(uint32_t rate_hz, uint32_t long_ms, uint32_t double_ms);
+
+/**
+ * @brief 停止按键扫描 (队列中已有的事件保留)
+ */
+void key_input_stop(void);
+
+/**
+ * @brief 从队列取出一个事件
+ * @param event 输出事件
+ * @return int32_t 0: 取出成功, -1: 队列为空或参数无效
+ */
+int32_t key_input_pop(key_event_t *event);
+
+/**
+ * @brief 当前队列中的事件数
+ * @return uint32_t 事件数
+ */
+uint32_t key_input_available(void);
+
+/**
+ * @brief 读取消抖后的按键状态
+ * @return uint8_t 位i为KEY i，1表示按下
+ */
+uint8_t key_input_state(void);
+
+/**
+ * @brief 获取扫描统计
+ * @param stats 输出统计信息
+ */
+void key_input_get_stats(key_input_stats_t *stats);
+
+/**
+ * @brief 清零扫描统计
+ */
+void key_input_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KEY_INPUT_H__ */
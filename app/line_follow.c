@@ -0,0 +1,264 @@
+/**
+ * @file line_follow.c
+ * @brief 巡线控制器实现
+ * @date 2026-10-16
+ */
+
+#include <stddef.h>
+#include "line_follow.h"
+
+/* 端口层接口 (ports/stm32f407/tick_port.c) */
+extern uint32_t tick_port_ms_to_ticks(uint32_t ms, uint32_t rate_hz);
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+#define LINE_FOLLOW_PI              3.14159265f
+#define LINE_FOLLOW_CORNER_COUNT    4U      /**< 只触及一侧最外探头且压线数≥4视为直角弯 */
+#define LINE_FOLLOW_REACQUIRE_POS   64      /**< 搜索中线回到该范围内才恢复跟线 */
+#define LINE_FOLLOW_OUTER_LEFT      0x01U   /**< 最左侧探头 */
+#define LINE_FOLLOW_OUTER_RIGHT     0x80U   /**< 最右侧探头 */
+
+/* ========================================================================== */
+/*                              私有函数                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 切换状态
+ * @param pos 当前位置，切回跟线时作为微分的起点，避免切换瞬间的微分冲击
+ */
+static void line_follow_enter(line_follow_t *lf, line_follow_mode_t mode, float pos)
+{
+    lf->mode = (uint8_t)mode;
+    lf->mode_ticks = 0;
+    if (mode == LINE_FOLLOW_TRACK) {
+        lf->err_prev = pos;
+        lf->d_filt = 0.0f;
+    }
+}
+
+/**
+ * @brief 识别路口和直角弯
+ * @return int8_t 0: 普通线, 2: 路口, -1/+1: 向左/右的直角弯
+ */
+static int8_t line_follow_junction(const line_sensor_reading_t *reading)
+{
+    uint8_t cls = reading->decoded.line_class;
+    uint8_t outer;
+
+    if (cls != LINE_CLASS_CROSS &&
+        !(cls == LINE_CLASS_EDGE && reading->decoded.count >= LINE_FOLLOW_CORNER_COUNT)) {
+        return 0;
+    }
+
+    outer = reading->raw & (LINE_FOLLOW_OUTER_LEFT | LINE_FOLLOW_OUTER_RIGHT);
+    if (outer == LINE_FOLLOW_OUTER_LEFT) {
+        return -1;
+    }
+    if (outer == LINE_FOLLOW_OUTER_RIGHT) {
+        return 1;
+    }
+    return 2;
+}
+
+/**
+ * @brief 两轮同速直行
+ */
+static void line_follow_straight(line_follow_output_t *out, int32_t cps)
+{
+    out->left_cps = cps;
+    out->right_cps = cps;
+}
+
+/**
+ * @brief 向side一侧原地转向
+ */
+static void line_follow_pivot(const line_follow_t *lf, line_follow_output_t *out)
+{
+    out->left_cps = lf->side * lf->cfg.turn_cps;
+    out->right_cps = -lf->side * lf->cfg.turn_cps;
+}
+
+/**
+ * @brief PD跟线
+ */
+static void line_follow_track(line_follow_t *lf, float pos, line_follow_output_t *out)
+{
+    const line_follow_config_t *cfg = &lf->cfg;
+    float err_abs = (pos >= 0.0f) ? pos : -pos;
+    float d_raw, diff, slow;
+
+    d_raw = (pos - lf->err_prev) * lf->rate_hz;
+    lf->err_prev = pos;
+    lf->d_filt += lf->d_alpha * (d_raw - lf->d_filt);
+    diff = cfg->kp * pos + cfg->kd * lf->d_filt;
+
+    /* 基础速度随误差线性降低，误差大时留出转向余量 */
+    slow = err_abs / (float)cfg->slow_error;
+    if (slow > 1.0f) {
+        slow = 1.0f;
+    }
+    lf->base_cps = lf->speed_max_cps - (int32_t)((float)(lf->speed_max_cps - cfg->speed_min_cps) * slow);
+
+    out->left_cps = lf->base_cps + (int32_t)diff;
+    out->right_cps = lf->base_cps - (int32_t)diff;
+}
+
+/* ========================================================================== */
+/*                              公共函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化巡线实例
+ */
+int32_t line_follow_init(line_follow_t *lf, const line_follow_config_t *cfg, uint32_t rate_hz)
+{
+    float rc, dt;
+
+    if (lf == NULL || cfg == NULL || rate_hz == 0) {
+        return -1;
+    }
+
+    if (cfg->speed_min_cps < 0 || cfg->speed_max_cps < cfg->speed_min_cps || cfg->turn_cps < 0 ||
+        cfg->slow_error <= 0 || cfg->slow_error > LINE_SENSOR_POS_MAX || !(cfg->d_cutoff_hz >= 0.0f)) {
+        return -1;
+    }
+
+    lf->cfg = *cfg;
+    lf->rate_hz = (float)rate_hz;
+
+    /* 一阶低通: alpha = dt / (RC + dt) */
+    if (cfg->d_cutoff_hz > 0.0f) {
+        dt = 1.0f / lf->rate_hz;
+        rc = 1.0f / (2.0f * LINE_FOLLOW_PI * cfg->d_cutoff_hz);
+        lf->d_alpha = dt / (rc + dt);
+    } else {
+        lf->d_alpha = 1.0f;
+    }
+
+    lf->hold_ticks = tick_port_ms_to_ticks(cfg->cross_hold_ms, rate_hz);
+    lf->lost_ticks = tick_port_ms_to_ticks(cfg->lost_timeout_ms, rate_hz);
+
+    line_follow_reset(lf);
+
+    return 0;
+}
+
+/**
+ * @brief 回到跟线状态并清除微分历史
+ */
+void line_follow_reset(line_follow_t *lf)
+{
+    if (lf == NULL) {
+        return;
+    }
+
+    line_follow_enter(lf, LINE_FOLLOW_TRACK, 0.0f);
+    lf->speed_max_cps = lf->cfg.speed_max_cps;
+    lf->base_cps = lf->cfg.speed_min_cps;
+    lf->side = 1;
+}
+
+/**
+ * @brief 修改直道基础速度
+ */
+void line_follow_set_speed_max(line_follow_t *lf, int32_t cps)
+{
+    lf->speed_max_cps = (cps > lf->cfg.speed_min_cps) ? cps : lf->cfg.speed_min_cps;
+}
+
+/**
+ * @brief 更新一个周期
+ */
+void line_follow_update(line_follow_t *lf, const line_sensor_reading_t *reading, line_follow_output_t *out)
+{
+    uint8_t cls = reading->decoded.line_class;
+    float pos = (float)reading->decoded.position;
+    int8_t junction;
+
+    out->junction = 0;
+    out->lost = 0;
+    lf->mode_ticks++;
+
+    switch (lf->mode) {
+    case LINE_FOLLOW_CROSS:
+        /* 路口内读数不可信，保持直行 */
+        if (lf->mode_ticks < lf->hold_ticks) {
+            line_follow_straight(out, lf->base_cps);
+            return;
+        }
+        line_follow_enter(lf, LINE_FOLLOW_TRACK, pos);
+        break;
+
+    case LINE_FOLLOW_CORNER:
+        if (cls == LINE_CLASS_LOST) {
+            /* 冲出直角弯的拐点: 向记下的一侧转向 */
+            line_follow_enter(lf, LINE_FOLLOW_SEARCH, pos);
+            line_follow_pivot(lf, out);
+            return;
+        }
+        if (line_follow_junction(reading) == 2) {
+            line_follow_enter(lf, LINE_FOLLOW_CROSS, pos);
+            out->junction = 1;
+            line_follow_straight(out, lf->base_cps);
+            return;
+        }
+        if (cls != LINE_CLASS_CENTERED && lf->mode_ticks < lf->hold_ticks) {
+            line_follow_straight(out, lf->cfg.speed_min_cps);
+            return;
+        }
+        /* 前方仍有线 (T字路口的直行分支) 或确认超时 */
+        line_follow_enter(lf, LINE_FOLLOW_TRACK, pos);
+        break;
+
+    case LINE_FOLLOW_SEARCH:
+        if (cls != LINE_CLASS_LOST && pos <= (float)LINE_FOLLOW_REACQUIRE_POS &&
+            pos >= -(float)LINE_FOLLOW_REACQUIRE_POS) {
+            line_follow_enter(lf, LINE_FOLLOW_TRACK, pos);
+            break;
+        }
+        if (lf->mode_ticks >= lf->lost_ticks) {
+            line_follow_enter(lf, LINE_FOLLOW_STOPPED, pos);
+            line_follow_straight(out, 0);
+            return;
+        }
+        line_follow_pivot(lf, out);
+        return;
+
+    case LINE_FOLLOW_STOPPED:
+        line_follow_straight(out, 0);
+        return;
+
+    default:
+        break;
+    }
+
+    /* 跟线 */
+    if (cls == LINE_CLASS_LOST) {
+        line_follow_enter(lf, LINE_FOLLOW_SEARCH, pos);
+        out->lost = 1;
+        line_follow_pivot(lf, out);
+        return;
+    }
+
+    junction = line_follow_junction(reading);
+    if (junction == 2) {
+        line_follow_enter(lf, LINE_FOLLOW_CROSS, pos);
+        out->junction = 1;
+        line_follow_straight(out, lf->base_cps);
+        return;
+    }
+    if (junction != 0) {
+        lf->side = junction;
+        line_follow_enter(lf, LINE_FOLLOW_CORNER, pos);
+        lf->base_cps = lf->cfg.speed_min_cps;
+        line_follow_straight(out, lf->base_cps);
+        return;
+    }
+
+    if (reading->decoded.position != 0) {
+        lf->side = (int8_t)((reading->decoded.position > 0) ? 1 : -1);
+    }
+    line_follow_track(lf, pos, out);
+}
@@ -0,0 +1,124 @@
+/**
+ * @file line_follow.h
+ * @brief 巡线控制器 (PD转向、按误差调整基础速度、路口/直角弯/丢线处理)
+ * @details 输入为八路循迹的一次读数(line_sensor.h)，输出为左右轮目标速度(计数/秒)，
+ *          由电机应用在控制节拍中断中调用并交给速度闭环执行:
+ *          - 跟线: 差速 = kp·e + kd·ė，ė经过一阶低通滤波；基础速度随|e|线性降低
+ *          - 路口: 两侧最外探头同时压线或多段压线时按当前速度直行一段时间，不响应转向
+ *          - 直角弯: 压线过宽且只触及一侧最外探头时记下该侧并降到最低速度，
+ *                   随后丢线即向该侧原地转向；线在中间重新出现则视为T字路口继续直行
+ *          - 丢线: 向最后一次看到线的一侧原地转向搜索，超时后停车
+ *          状态全部在实例内，单次更新为固定的几次浮点运算。
+ * @date 2026-10-16
+ *
+ * @note 位置正值表示线在车体右侧，此时左轮加速、右轮减速
+ */
+
+#ifndef LINE_FOLLOW_H__
+#define LINE_FOLLOW_H__
+
+#include <stdint.h>
+#include "line_sensor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/*                              数据结构定义                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 巡线配置
+ * @note 位置单位为1/32探头间距 (line_sensor.h)，速度单位为计数/秒
+ */
+typedef struct {
+    float kp;                       /**< 比例增益: 差速 / 位置 */
+    float kd;                       /**< 微分增益: 差速 / (位置/秒) */
+    float d_cutoff_hz;              /**< 微分低通截止频率 (Hz)，0表示不滤波 */
+    int32_t speed_max_cps;          /**< 误差为0时的基础速度 */
+    int32_t speed_min_cps;          /**< 误差达到slow_error时的基础速度 */
+    int32_t slow_error;             /**< 基础速度降到最低的误差 (1~LINE_SENSOR_POS_MAX) */
+    int32_t turn_cps;               /**< 直角弯/丢线搜索时原地转向的轮速 */
+    uint32_t cross_hold_ms;         /**< 路口直行和直角弯确认的保持时间 (ms) */
+    uint32_t lost_timeout_ms;       /**< 丢线搜索超时 (ms)，超时后停车 */
+} line_follow_config_t;
+
+/**
+ * @brief 巡线状态
+ */
+typedef enum {
+    LINE_FOLLOW_TRACK = 0,          /**< PD跟线 */
+    LINE_FOLLOW_CROSS,              /**< 通过路口，直行保持 */
+    LINE_FOLLOW_CORNER,             /**< 检测到直角弯，低速前行等待丢线 */
+    LINE_FOLLOW_SEARCH,             /**< 丢线，向最后一侧原地转向 */
+    LINE_FOLLOW_STOPPED             /**< 搜索超时，停车 */
+} line_follow_mode_t;
+
+/**
+ * @brief 巡线实例
+ */
+typedef struct {
+    line_follow_config_t cfg;       /**< 配置 */
+    float rate_hz;                  /**< 更新频率 */
+    float d_alpha;                  /**< 微分低通系数 */
+    float err_prev;                 /**< 上一周期误差 */
+    float d_filt;                   /**< 滤波后的误差变化率 (位置/秒) */
+    int32_t speed_max_cps;          /**< 当前直道基础速度 (初始为cfg.speed_max_cps) */
+    int32_t base_cps;               /**< 最近一次基础速度 */
+    uint32_t hold_ticks;            /**< 路口/直角弯保持节拍数 */
+    uint32_t lost_ticks;            /**< 丢线超时节拍数 */
+    uint32_t mode_ticks;            /**< 进入当前状态后的节拍数 */
+    uint8_t mode;                   /**< line_follow_mode_t */
+    int8_t side;                    /**< 最后一次看到线的一侧 (-1左, +1右) */
+} line_follow_t;
+
+/**
+ * @brief 单次更新的输出
+ */
+typedef struct {
+    int32_t left_cps;               /**< 左轮目标速度 */
+    int32_t right_cps;              /**< 右轮目标速度 */
+    uint8_t junction;               /**< 本周期进入路口 */
+    uint8_t lost;                   /**< 本周期开始丢线搜索 */
+} line_follow_output_t;
+
+/* ========================================================================== */
+/*                              接口函数                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化巡线实例
+ * @param lf 实例
+ * @param cfg 配置
+ * @param rate_hz 更新频率 (Hz)
+ * @return int32_t 0: 成功, -1: 参数无效
+ */
+int32_t line_follow_init(line_follow_t *lf, const line_follow_config_t *cfg, uint32_t rate_hz);
+
+/**
+ * @brief 回到跟线状态并清除微分历史 (保留配置)
+ * @param lf 实例
+ */
+void line_follow_reset(line_follow_t *lf);
+
+/**
+ * @brief 修改直道基础速度 (按赛道位置规划速度时每周期调用)
+ * @param lf 实例
+ * @param cps 基础速度，低于cfg.speed_min_cps时取speed_min_cps
+ */
+void line_follow_set_speed_max(line_follow_t *lf, int32_t cps);
+
+/**
+ * @brief 更新一个周期
+ * @param lf 实例
+ * @param reading 本周期的循迹读数
+ * @param out 输出左右轮目标速度和事件
+ */
+void line_follow_update(line_follow_t *lf, const line_sensor_reading_t *reading, line_follow_output_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LINE_FOLLOW_H__ */
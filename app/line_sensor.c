@@ -0,0 +1,277 @@
+/**
+ * @file line_sensor.c
+ * @brief 八路循迹传感器解码实现
+ * @date 2026-10-16
+ */
+
+#include <stddef.h>
+#include "line_sensor.h"
+
+/* 端口层接口 (ports/stm32f407/line_port.c, tick_port.c) */
+extern uint8_t line_port_read(void);
+extern int32_t line_port_capture_start(uint32_t rate_hz, void (*cb)(const uint8_t *samples, uint32_t n));
+extern void line_port_capture_stop(void);
+extern uint8_t line_port_invert_mask(void);
+extern uint32_t tick_port_cycles(void);
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+#define LINE_PUB_SEQ_SHIFT          8U          /**< 发布字: 高24位序号，低8位状态 */
+
+/* ========================================================================== */
+/*                              解码表生成                                    */
+/* ========================================================================== */
+
+/* 第i路状态 */
+#define LS_BIT(b, i)                (((b) >> (i)) & 1)
+
+/* 压线探头数 */
+#define LS_CNT(b)                   (LS_BIT(b, 0) + LS_BIT(b, 1) + LS_BIT(b, 2) + LS_BIT(b, 3) + \
+                                     LS_BIT(b, 4) + LS_BIT(b, 5) + LS_BIT(b, 6) + LS_BIT(b, 7))
+
+/* 压线段数: 每段的最左一位满足"本位为1且左邻为0" */
+#define LS_GROUPS(b)                LS_CNT((b) & ~((b) << 1) & 0xFF)
+
+/* 权重和: 第i路权重为2i-7 */
+#define LS_WSUM(b)                  (-7 * LS_BIT(b, 0) - 5 * LS_BIT(b, 1) - 3 * LS_BIT(b, 2) - LS_BIT(b, 3) + \
+                                     LS_BIT(b, 4) + 3 * LS_BIT(b, 5) + 5 * LS_BIT(b, 6) + 7 * LS_BIT(b, 7))
+
+#define LS_POS(b)                   ((LS_CNT(b) == 0) ? 0 : (LS_WSUM(b) * 16) / LS_CNT(b))
+
+/* 两段以上或5路以上同时压线视为路口/直角弯 (单根线最多覆盖3~4路) */
+#define LS_CLASS(b)                 ((LS_CNT(b) == 0) ? LINE_CLASS_LOST : \
+                                     (LS_GROUPS(b) > 1 || LS_CNT(b) >= 5) ? LINE_CLASS_CROSS : \
+                                     (((b) & 0x81) != 0) ? LINE_CLASS_EDGE : LINE_CLASS_CENTERED)
+
+#define LS_CONF(b)                  ((LS_CLASS(b) == LINE_CLASS_LOST) ? 0 : \
+                                     (LS_CLASS(b) == LINE_CLASS_CROSS) ? 64 : \
+                                     (LS_CLASS(b) == LINE_CLASS_EDGE) ? 128 : \
+                                     (LS_CNT(b) <= 2) ? 255 : (LS_CNT(b) == 3) ? 224 : 192)
+
+#define LS_E(b)                     { (int8_t)LS_POS(b), (uint8_t)LS_CONF(b), (uint8_t)LS_CLASS(b), (uint8_t)LS_CNT(b) }
+#define LS_R4(b)                    LS_E(b), LS_E((b) + 1), LS_E((b) + 2), LS_E((b) + 3)
+#define LS_R16(b)                   LS_R4(b), LS_R4((b) + 4), LS_R4((b) + 8), LS_R4((b) + 12)
+#define LS_R64(b)                   LS_R16(b), LS_R16((b) + 16), LS_R16((b) + 32), LS_R16((b) + 48)
+
+static const line_sensor_entry_t k_line_table[256] = {
+    LS_R64(0), LS_R64(64), LS_R64(128), LS_R64(192)
+};
+
+/* ========================================================================== */
+/*                              私有变量                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 连续采集状态
+ */
+static struct {
+    volatile uint32_t published;            /**< 最近一次读数 (序号<<8 | 状态) */
+    uint32_t seq;                           /**< 下一块序号 */
+    uint8_t invert;                         /**< 原始采样极性掩码 */
+    line_sensor_capture_stats_t stats;      /**< 统计 (仅DMA中断写) */
+} g_line_capture;
+
+/* ========================================================================== */
+/*                              私有函数                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 把8位展开为每位占一个4位组 (位i → 位4i)
+ */
+static inline uint32_t line_sensor_spread(uint32_t x)
+{
+    x = (x | (x << 12)) & 0x000F000FU;
+    x = (x | (x << 6)) & 0x03030303U;
+    x = (x | (x << 3)) & 0x11111111U;
+    return x;
+}
+
+/**
+ * @brief line_sensor_spread的逆变换 (取每个4位组的最低位)
+ */
+static inline uint8_t line_sensor_gather(uint32_t x)
+{
+    x &= 0x11111111U;
+    x = (x | (x >> 3)) & 0x03030303U;
+    x = (x | (x >> 6)) & 0x000F000FU;
+    x = (x | (x >> 12)) & 0x000000FFU;
+    return (uint8_t)x;
+}
+
+/**
+ * @brief 对已展开的计数做多数判决
+ * @note 每组计数加上(8-阈值)后第3位即为"计数≥阈值"；n≤15时每组不会溢出
+ */
+static inline uint8_t line_sensor_majority(uint32_t sum, uint32_t n)
+{
+    uint32_t thresh = n / 2U + 1U;
+
+    sum += (8U - thresh) * 0x11111111U;
+    return line_sensor_gather(sum >> 3);
+}
+
+/**
+ * @brief DMA块回调: 表决半缓冲并发布
+ * @note DMA中断上下文；同时用或/与累加判断块内是否有通道抖动
+ */
+static void line_sensor_block_cb(const uint8_t *samples, uint32_t n)
+{
+    uint32_t start = tick_port_cycles();
+    uint32_t sum = 0;
+    uint32_t any = 0;
+    uint32_t all = 0xFFU;
+    uint32_t seq, elapsed;
+    uint8_t s;
+    uint32_t i;
+
+    if (n > LINE_SENSOR_VOTE_MAX) {
+        n = LINE_SENSOR_VOTE_MAX;
+    }
+
+    for (i = 0; i < n; i++) {
+        s = (uint8_t)(samples[i] ^ g_line_capture.invert);
+        sum += line_sensor_spread(s);
+        any |= s;
+        all &= s;
+    }
+
+    seq = (g_line_capture.seq + 1U) & (0xFFFFFFFFU >> LINE_PUB_SEQ_SHIFT);
+    if (seq == 0) {
+        seq = 1;
+    }
+    g_line_capture.seq = seq;
+    g_line_capture.published = (seq << LINE_PUB_SEQ_SHIFT) | line_sensor_majority(sum, n);
+
+    g_line_capture.stats.blocks++;
+    if (any != all) {
+        g_line_capture.stats.unstable_blocks++;
+    }
+    elapsed = tick_port_cycles() - start;
+    if (elapsed > g_line_capture.stats.filter_cycles_max) {
+        g_line_capture.stats.filter_cycles_max = elapsed;
+    }
+}
+
+/* ========================================================================== */
+/*                              公共函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 解码一个8路状态字节
+ */
+line_sensor_entry_t line_sensor_decode(uint8_t raw)
+{
+    return k_line_table[raw];
+}
+
+/**
+ * @brief 按位多数表决
+ */
+uint8_t line_sensor_vote(const uint8_t *samples, uint32_t n)
+{
+    uint32_t sum = 0;
+    uint32_t i;
+
+    if (samples == NULL || n == 0) {
+        return 0;
+    }
+    if (n > LINE_SENSOR_VOTE_MAX) {
+        n = LINE_SENSOR_VOTE_MAX;
+    }
+
+    for (i = 0; i < n; i++) {
+        sum += line_sensor_spread(samples[i]);
+    }
+    return line_sensor_majority(sum, n);
+}
+
+/**
+ * @brief 读取一次并解码
+ */
+void line_sensor_read(line_sensor_reading_t *reading)
+{
+    if (reading == NULL) {
+        return;
+    }
+
+    reading->raw = line_port_read();
+    reading->decoded = k_line_table[reading->raw];
+}
+
+/**
+ * @brief 连续读取n次，按位多数表决后解码
+ * @note 读取与累加交替进行，不需要缓存原始采样
+ */
+void line_sensor_read_voted(line_sensor_reading_t *reading, uint32_t n)
+{
+    uint32_t sum = 0;
+    uint32_t i;
+
+    if (reading == NULL) {
+        return;
+    }
+    if (n == 0) {
+        n = 1;
+    } else if (n > LINE_SENSOR_VOTE_MAX) {
+        n = LINE_SENSOR_VOTE_MAX;
+    }
+
+    for (i = 0; i < n; i++) {
+        sum += line_sensor_spread(line_port_read());
+    }
+    reading->raw = line_sensor_majority(sum, n);
+    reading->decoded = k_line_table[reading->raw];
+}
+
+/**
+ * @brief 启动DMA连续采集
+ */
+int32_t line_sensor_capture_start(uint32_t rate_hz)
+{
+    line_port_capture_stop();
+
+    g_line_capture.published = 0;
+    g_line_capture.seq = 0;
+    g_line_capture.invert = line_port_invert_mask();
+    g_line_capture.stats.blocks = 0;
+    g_line_capture.stats.unstable_blocks = 0;
+    g_line_capture.stats.filter_cycles_max = 0;
+
+    return line_port_capture_start(rate_hz, line_sensor_block_cb);
+}
+
+/**
+ * @brief 停止DMA连续采集
+ */
+void line_sensor_capture_stop(void)
+{
+    line_port_capture_stop();
+}
+
+/**
+ * @brief 获取最近一次表决后的读数
+ */
+uint32_t line_sensor_get_filtered(line_sensor_reading_t *reading)
+{
+    uint32_t word = g_line_capture.published;
+
+    if (reading != NULL) {
+        reading->raw = (uint8_t)word;
+        reading->decoded = k_line_table[(uint8_t)word];
+    }
+    return word >> LINE_PUB_SEQ_SHIFT;
+}
+
+/**
+ * @brief 获取连续采集统计
+ */
+void line_sensor_get_capture_stats(line_sensor_capture_stats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    *stats = g_line_capture.stats;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file line_sensor.h
+ * @brief 八路循迹传感器解码 (查表求位置/置信度/类型，多次采样多数表决)
+ * @details 8路探头的状态组成一个字节，256种组合的解码结果在编译期生成常量表，
+ *          每次采样只需一次端口读取和一次查表:
+ *          - 位置: 压线探头权重(-7,-5,...,+7)的平均值，单位为1/32探头间距，范围±112，
+ *                  负值表示线在车体左侧 (bit0为最左侧探头)
+ *          - 类型: 居中/边缘/丢线/路口(十字、T字、直角)
+ *          - 置信度: 0~255，单根细线居中最高，边缘、路口依次降低，丢线为0
+ *          多数表决把N次采样按位并行计数 (每路占4位)，表决开销与N成正比、与通道数无关。
+ *          连续采集时由端口层的定时器触发DMA按固定频率(默认20kHz)采样，每半缓冲在DMA中断中
+ *          表决成一个读数并发布，控制节拍只需无锁读取最近一次结果。
+ * @date 2026-10-16
+ *
+ * @note 只依赖端口层line_port.c (单次读取与DMA连续采集)，解码函数本身可在任意上下文调用
+ */
+
+#ifndef LINE_SENSOR_H__
+#define LINE_SENSOR_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/*                              配置参数                                      */
+/* ========================================================================== */
+
+#define LINE_SENSOR_CHANNELS        8U
+#define LINE_SENSOR_POS_MAX         112     /**< 最外侧探头对应的位置值 */
+#define LINE_SENSOR_VOTE_MAX        15U     /**< 单次表决的最大采样数 (每路4位计数) */
+
+/* ========================================================================== */
+/*                              数据结构定义                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 线型分类
+ */
+typedef enum {
+    LINE_CLASS_LOST = 0,            /**< 没有探头压线 */
+    LINE_CLASS_CENTERED,            /**< 单根线，未触及最外侧探头 */
+    LINE_CLASS_EDGE,                /**< 单根线，触及最外侧探头 (即将丢线) */
+    LINE_CLASS_CROSS                /**< 多段压线或压线过宽: 十字/T字路口、直角弯 */
+} line_class_t;
+
+/**
+ * @brief 单次采样的解码结果 (4字节，可按值返回)
+ */
+typedef struct {
+    int8_t position;                /**< 线位置 (1/32探头间距)，丢线时为0 */
+    uint8_t confidence;             /**< 置信度 0~255 */
+    uint8_t line_class;             /**< line_class_t */
+    uint8_t count;                  /**< 压线探头数 */
+} line_sensor_entry_t;
+
+/**
+ * @brief 一次读取的结果
+ */
+typedef struct {
+    uint8_t raw;                    /**< 8路状态 (位i为第i路，1表示压线) */
+    line_sensor_entry_t decoded;    /**< 解码结果 */
+} line_sensor_reading_t;
+
+/**
+ * @brief 连续采集统计
+ */
+typedef struct {
+    uint32_t blocks;                /**< 已表决的块数 */
+    uint32_t unstable_blocks;       /**< 块内有通道采样不一致(被表决滤掉抖动)的块数 */
+    uint32_t filter_cycles_max;     /**< 单块表决+发布的最大CPU周期数 */
+} line_sensor_capture_stats_t;
+
+/* ========================================================================== */
+/*                              接口函数                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 解码一个8路状态字节
+ * @param raw 8路状态
+ * @return line_sensor_entry_t 查表结果
+ */
+line_sensor_entry_t line_sensor_decode(uint8_t raw);
+
+/**
+ * @brief 按位多数表决
+ * @param samples 采样值数组
+ * @param n 采样数 (1~LINE_SENSOR_VOTE_MAX，超出部分忽略)
+ * @return uint8_t 超过半数采样为1的通道置1 (偶数采样平票记为0)
+ */
+uint8_t line_sensor_vote(const uint8_t *samples, uint32_t n);
+
+/**
+ * @brief 读取一次并解码
+ * @param reading 输出结果
+ */
+void line_sensor_read(line_sensor_reading_t *reading);
+
+/**
+ * @brief 连续读取n次，按位多数表决后解码
+ * @param reading 输出结果
+ * @param n 采样数 (1~LINE_SENSOR_VOTE_MAX)，抑制探头在线边缘的抖动和单次毛刺
+ */
+void line_sensor_read_voted(line_sensor_reading_t *reading, uint32_t n);
+
+/**
+ * @brief 启动DMA连续采集
+ * @param rate_hz 采样频率 (Hz)，0表示使用端口层默认值 (LINE_DMA_RATE_HZ)
+ * @return int32_t 0: 成功, -1: 参数无效, -2: 定时器或DMA初始化失败
+ * @note 输出频率为采样频率/每块采样数 (默认20kHz/10 = 2kHz)
+ */
+int32_t line_sensor_capture_start(uint32_t rate_hz);
+
+/**
+ * @brief 停止DMA连续采集
+ */
+void line_sensor_capture_stop(void);
+
+/**
+ * @brief 获取最近一次表决后的读数
+ * @param reading 输出结果
+ * @return uint32_t 读数序号 (每块加1，24位回绕)，0表示尚无读数
+ * @note 读数和序号打包在一个32位字中发布，任意上下文可调用；序号不变说明没有新块
+ */
+uint32_t line_sensor_get_filtered(line_sensor_reading_t *reading);
+
+/**
+ * @brief 获取连续采集统计
+ * @param stats 输出统计
+ */
+void line_sensor_get_capture_stats(line_sensor_capture_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LINE_SENSOR_H__ */
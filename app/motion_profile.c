@@ -0,0 +1,193 @@
+/**
+ * @file motion_profile.c
+ * @brief 加速度/加加速度受限的占空比运动规划实现
+ * @date 2026-10-16
+ */
+
+#include <stddef.h>
+#include <math.h>
+#include "motion_profile.h"
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+#define MOTION_PROFILE_Q16_ONE      65536LL
+
+/* ========================================================================== */
+/*                              私有函数                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 把每秒的量换算为Q16每节拍增量，限制在int32范围内
+ */
+static int32_t motion_profile_per_tick(uint64_t value_q16, uint64_t divisor)
+{
+    uint64_t step = value_q16 / divisor;
+
+    if (value_q16 != 0 && step == 0) {
+        step = 1;  /* 限值很小时至少每节拍变化一个最小单位 */
+    }
+    if (step > (uint64_t)INT32_MAX) {
+        step = (uint64_t)INT32_MAX;
+    }
+
+    return (int32_t)step;
+}
+
+/**
+ * @brief Q16四舍五入为整数
+ */
+static int32_t motion_profile_round(int64_t value_q16)
+{
+    if (value_q16 >= 0) {
+        return (int32_t)((value_q16 + MOTION_PROFILE_Q16_ONE / 2) / MOTION_PROFILE_Q16_ONE);
+    }
+    return (int32_t)((value_q16 - MOTION_PROFILE_Q16_ONE / 2) / MOTION_PROFILE_Q16_ONE);
+}
+
+/* ========================================================================== */
+/*                              公共函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 由每秒限值计算每节拍增量
+ */
+void motion_profile_config(motion_profile_config_t *cfg, uint32_t accel, uint32_t jerk, uint32_t rate_hz)
+{
+    if (cfg == NULL) {
+        return;
+    }
+
+    if (rate_hz == 0) {
+        rate_hz = 1;
+    }
+
+    cfg->rate_hz = rate_hz;
+    cfg->step_max_q16 = motion_profile_per_tick((uint64_t)accel * MOTION_PROFILE_Q16_ONE, rate_hz);
+    cfg->jerk_q16 = motion_profile_per_tick((uint64_t)jerk * MOTION_PROFILE_Q16_ONE,
+                                            (uint64_t)rate_hz * rate_hz);
+}
+
+/**
+ * @brief 复位规划器到静止状态
+ */
+void motion_profile_reset(motion_profile_t *p, int32_t value)
+{
+    p->value_q16 = (int64_t)value * MOTION_PROFILE_Q16_ONE;
+    p->step_q16 = 0;
+    p->target = value;
+}
+
+/**
+ * @brief 设置目标值
+ */
+void motion_profile_set_target(motion_profile_t *p, int32_t target)
+{
+    p->target = target;
+}
+
+/**
+ * @brief 推进一个节拍
+ * @note S曲线: 剩余距离大于"从当前斜率减到0所走的距离"时加大斜率，否则减小斜率；
+ *       斜率方向与剩余距离相反(目标反向)时先按加加速度减速再反向
+ */
+int32_t motion_profile_update(motion_profile_t *p, const motion_profile_config_t *cfg)
+{
+    int64_t err = (int64_t)p->target * MOTION_PROFILE_Q16_ONE - p->value_q16;
+    int64_t step = p->step_q16;
+    int64_t step_max = cfg->step_max_q16;
+    int64_t jerk = cfg->jerk_q16;
+    int64_t err_abs = (err >= 0) ? err : -err;
+    int64_t step_abs;
+    int64_t stop;
+    int64_t dir;
+
+    /* 不限制或已静止在目标上 */
+    if (step_max <= 0 || (err == 0 && step == 0)) {
+        motion_profile_reset(p, p->target);
+        return p->target;
+    }
+
+    /* 朝向目标的方向；已在目标上但仍有斜率时按减速处理 */
+    if (err != 0) {
+        dir = (err > 0) ? 1 : -1;
+    } else {
+        dir = (step > 0) ? -1 : 1;
+    }
+
+    if (jerk <= 0) {
+        /* 梯形: 斜率直接取上限 */
+        step = dir * step_max;
+    } else if (step * dir < 0) {
+        /* 正在远离目标: 先减速反向 */
+        step += dir * jerk;
+    } else {
+        /* 从当前斜率s减到0所走的距离: s + (s-j) + ... ≈ s²/(2j) + s/2 */
+        step_abs = step * dir;
+        stop = (step_abs * step_abs) / (2 * jerk) + step_abs / 2;
+        if (err_abs <= stop) {
+            step_abs = (step_abs > jerk) ? (step_abs - jerk) : 0;
+        } else {
+            step_abs = (step_abs + jerk < step_max) ? (step_abs + jerk) : step_max;
+        }
+        step = dir * step_abs;
+    }
+
+    if (step > step_max) {
+        step = step_max;
+    } else if (step < -step_max) {
+        step = -step_max;
+    }
+
+    step_abs = (step >= 0) ? step : -step;
+
+    /* 剩余距离不超过一步(或斜率已减到0且剩余不超过一个加加速度步)时直接到位 */
+    if ((step * dir >= 0 && err_abs <= step_abs) || (step == 0 && err_abs <= jerk)) {
+        motion_profile_reset(p, p->target);
+        return p->target;
+    }
+
+    p->value_q16 += step;
+    p->step_q16 = (int32_t)step;
+
+    return motion_profile_round(p->value_q16);
+}
+
+/**
+ * @brief 估计到达目标还需的节拍数
+ * @note 把当前状态折算为"从静止出发、距离为d"的S曲线: d = |e| + s²/(2j)，
+ *       斜率朝向目标时减去已用的加速时间s/j，背离目标时加上减速时间s/j
+ */
+uint32_t motion_profile_eta_ticks(const motion_profile_t *p, const motion_profile_config_t *cfg)
+{
+    float err = (float)((int64_t)p->target * MOTION_PROFILE_Q16_ONE - p->value_q16);
+    float step = (float)p->step_q16;
+    float a = (float)cfg->step_max_q16;
+    float j = (float)cfg->jerk_q16;
+    float d;
+    float t;
+
+    if (cfg->step_max_q16 <= 0 || (err == 0.0f && p->step_q16 == 0)) {
+        return 0;
+    }
+
+    if (cfg->jerk_q16 <= 0) {
+        return (uint32_t)ceilf(fabsf(err) / a);
+    }
+
+    d = fabsf(err) + (step * step) / (2.0f * j);
+    if (d >= a * a / j) {
+        t = d / a + a / j;
+    } else {
+        t = 2.0f * sqrtf(d / j);
+    }
+
+    if (step * err > 0.0f) {
+        t -= fabsf(step) / j;
+    } else {
+        t += fabsf(step) / j;
+    }
+
+    return (t > 0.0f) ? (uint32_t)ceilf(t) : 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file motion_profile.h
+ * @brief 加速度/加加速度受限的占空比运动规划 (梯形/S曲线)
+ * @details 把阶跃的目标值变成斜坡: 只限加速度时为梯形规划，同时限加加速度时为S曲线。
+ *          配置时把每秒的限值换算成每个节拍的增量(Q16)，节拍中只做整数加减和比较，
+ *          适合在1kHz控制节拍中断中执行。量纲由调用者决定，电机应用中为Q15占空比。
+ * @date 2026-10-16
+ *
+ * @note 每个车轮使用独立的规划实例，实例之间无共享状态；
+ *       目标值可随时修改，规划器从当前值和当前斜率平滑过渡到新目标
+ */
+
+#ifndef MOTION_PROFILE_H__
+#define MOTION_PROFILE_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/*                              数据结构定义                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 规划配置 (每节拍增量，由motion_profile_config()计算)
+ */
+typedef struct {
+    int32_t step_max_q16;       /**< 每节拍最大变化量 (Q16)，0表示不限制(阶跃) */
+    int32_t jerk_q16;           /**< 每节拍变化量的最大变化 (Q16)，0表示梯形规划 */
+    uint32_t rate_hz;           /**< 节拍频率 */
+} motion_profile_config_t;
+
+/**
+ * @brief 规划状态
+ */
+typedef struct {
+    int64_t value_q16;          /**< 当前输出 (Q16) */
+    int32_t step_q16;           /**< 当前每节拍变化量 (Q16，带符号) */
+    int32_t target;             /**< 目标值 */
+} motion_profile_t;
+
+/* ========================================================================== */
+/*                              接口函数                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 由每秒限值计算每节拍增量
+ * @param cfg 输出配置
+ * @param accel 最大变化率 (单位/秒)，0表示不限制
+ * @param jerk 变化率的最大变化率 (单位/秒²)，0表示梯形规划
+ * @param rate_hz 节拍频率
+ */
+void motion_profile_config(motion_profile_config_t *cfg, uint32_t accel, uint32_t jerk, uint32_t rate_hz);
+
+/**
+ * @brief 复位规划器到静止状态
+ * @param p 规划状态
+ * @param value 当前值 (同时作为目标值)
+ */
+void motion_profile_reset(motion_profile_t *p, int32_t value);
+
+/**
+ * @brief 设置目标值
+ * @param p 规划状态
+ * @param target 目标值
+ */
+void motion_profile_set_target(motion_profile_t *p, int32_t target);
+
+/**
+ * @brief 推进一个节拍
+ * @param p 规划状态
+ * @param cfg 规划配置
+ * @return int32_t 本节拍输出
+ */
+int32_t motion_profile_update(motion_profile_t *p, const motion_profile_config_t *cfg);
+
+/**
+ * @brief 估计到达目标还需的节拍数
+ * @param p 规划状态
+ * @param cfg 规划配置
+ * @return uint32_t 节拍数，已到达时为0
+ * @note 按连续时间S曲线闭式解计算，包含从当前斜率反向或减速所需的时间，
+ *       与实际离散规划相差不超过几个节拍
+ */
+uint32_t motion_profile_eta_ticks(const motion_profile_t *p, const motion_profile_config_t *cfg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MOTION_PROFILE_H__ */
@@ -8,10 +8,33 @@
  * @version 1.0.0
  */
 
+#include "cmsis_compiler.h"
 #include "motor_control_app.h"
+#include "speed_ctrl.h"
+#include "motion_profile.h"
+#include "actuation_map.h"
+#include "wheel_encoder.h"
+#include "odometry.h"
+#include "line_sensor.h"
 #include "../hardware/motor_drivers/tb6612fng/tb6612fng.h"
 #include <string.h>
 #include <stdlib.h>
+#include <math.h>
+
+/* 端口层接口 */
+extern int32_t tick_port_ctrl_start(uint32_t rate_hz, void (*cb)(void));
+extern void tick_port_ctrl_stop(void);
+extern void tick_port_ctrl_mask(uint8_t masked);
+extern uint32_t tick_port_cycles(void);
+extern uint32_t tick_port_cycles_per_us(void);
+extern uint32_t tick_port_uptime_ms(void);
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+/* 租约剩余节拍的特殊值: 不受租约约束 */
+#define MOTOR_LEASE_NONE            0xFFFFFFFFUL
 
 /* ========================================================================== */
 /*                              私有变量定义                                  */
@@ -22,6 +45,122 @@
  */
 static motor_app_status_t g_motor_app_status = {0};
 
+/**
+ * @brief 控制节拍与速度闭环运行数据
+ * @note 控制节拍在初始化后一直运行 (编码器测速、里程计)，active只控制PID是否驱动电机；
+ *       除active/setpoint_seq/target外仅由控制节拍中断读写
+ */
+typedef struct {
+    volatile bool active;               /**< 速度闭环是否驱动电机 */
+    volatile uint32_t setpoint_seq;     /**< 目标值顺序锁，奇数表示主循环正在写 */
+    volatile int32_t target[2];         /**< 主循环写入的目标速度 (计数/秒) */
+    int32_t applied[2];                 /**< 中断中正在使用的目标速度 */
+    int32_t speed[2];                   /**< 测量速度 (计数/秒) */
+    int16_t output[2];                  /**< 控制输出 (Q15占空比) */
+    int32_t command[2];                 /**< 经过执行映射前的最近一次指令 (Q15，带符号) */
+    uint16_t last_duty[2];              /**< 上次下发的占空比 (Q15)，相同则不重复下发 */
+    tb6612_direction_t last_dir[2];     /**< 上次下发的方向 */
+    speed_ctrl_pid_t pid[2];            /**< 左右轮PID */
+    speed_ctrl_config_t config;         /**< PID配置 (两轮相同) */
+    uint32_t last_entry;                /**< 上次进入中断的周期计数 */
+    volatile bool stats_reset;          /**< 请求在下个周期清零统计 */
+    motor_speed_stats_t stats;          /**< 执行时间与抖动统计 */
+} motor_speed_loop_t;
+
+static motor_speed_loop_t g_speed_loop = {
+    .config = {
+        .kp_q16 = MOTOR_SPEED_DEFAULT_KP_Q16,
+        .ki_q16 = MOTOR_SPEED_DEFAULT_KI_Q16,
+        .kd_q16 = MOTOR_SPEED_DEFAULT_KD_Q16,
+        .out_min = -(int32_t)TB6612_DUTY_FULL,
+        .out_max = (int32_t)TB6612_DUTY_FULL,
+        .rate_hz = MOTOR_SPEED_RATE_HZ,
+    },
+};
+
+/**
+ * @brief 开环指令运动规划运行数据
+ * @note 开环指令只写目标占空比，由控制节拍按加速度/加加速度限值逐步下发；
+ *       除active/target_seq/target外仅由控制节拍中断读写
+ */
+typedef struct {
+    volatile bool active;               /**< 运动规划是否驱动电机 */
+    volatile uint32_t target_seq;       /**< 目标值顺序锁，奇数表示主循环正在写 */
+    volatile int32_t target[2];         /**< 目标占空比 (Q15，带符号) */
+    motion_profile_t prof[2];           /**< 左右轮规划状态 */
+    motion_profile_config_t config;     /**< 规划限值 (两轮相同) */
+    volatile uint32_t eta_ticks;        /**< 到达目标的剩余节拍数 (中断写) */
+} motor_profile_state_t;
+
+static motor_profile_state_t g_profile = {0};
+
+/**
+ * @brief 底盘运动学换算系数 (motor_ctrl_start中由车轮几何参数算出)
+ */
+typedef struct {
+    float counts_per_m;                 /**< 每米对应的归一化计数 */
+    float half_base_counts;             /**< 半轮距对应的归一化计数 (计数/弧度) */
+} motor_kinematics_t;
+
+static motor_kinematics_t g_kinematics = {0};
+
+/**
+ * @brief 执行映射 (控制节拍中断只在速度闭环或运动规划运行时读取)
+ */
+typedef struct {
+    volatile bool enabled;              /**< 是否经过映射下发 */
+    actuation_map_t map[2];             /**< 左右轮映射 */
+} motor_actuation_t;
+
+static motor_actuation_t g_actuation = {0};
+
+/**
+ * @brief 指令租约状态
+ */
+typedef enum {
+    MOTOR_LEASE_IDLE = 0,               /**< 未启用或已停止 */
+    MOTOR_LEASE_ARMED,                  /**< 租约计时中 */
+    MOTOR_LEASE_RAMP,                   /**< 已到期，正在减速 */
+    MOTOR_LEASE_BRAKED                  /**< 已到期，两轮已制动 */
+} motor_lease_state_t;
+
+/**
+ * @brief 指令租约运行数据
+ * @note remaining由主循环续约时写入、控制节拍递减 (单个32位字段)；
+ *       到期后的减速和制动只在控制节拍中断中进行
+ */
+typedef struct {
+    volatile uint32_t lease_ms;         /**< 租约时长 (ms)，0表示不启用 */
+    volatile uint32_t remaining;        /**< 剩余节拍数，MOTOR_LEASE_NONE表示不计时 */
+    volatile uint8_t state;             /**< motor_lease_state_t */
+    uint32_t ramp_ticks;                /**< 到期后经过的节拍数 (中断) */
+    motor_lease_stats_t stats;          /**< 统计 (failsafe/lease_ms在读取时填写) */
+} motor_lease_t;
+
+static motor_lease_t g_lease = {0};
+
+/**
+ * @brief 巡线运行数据
+ * @note active在速度闭环之上叠加: 两者都为真时控制节拍用巡线输出覆盖目标速度；
+ *       除active/stats_reset外仅由控制节拍中断读写 (启动时在active为假时初始化)
+ */
+typedef struct {
+    volatile bool active;               /**< 巡线是否给出目标速度 */
+    volatile bool stats_reset;          /**< 请求在下个周期清零统计 */
+    line_follow_t lf;                   /**< 巡线控制器 */
+    uint32_t junctions_per_lap;         /**< 每圈路口数，0表示不计圈 */
+    uint32_t last_seq;                  /**< 上次读数序号 */
+    uint32_t ticks;                     /**< 巡线节拍计数 (计圈时基) */
+    uint32_t lap_start;                 /**< 本圈起点的节拍计数 */
+    uint32_t lap_junctions;             /**< 本圈已经过的路口数 */
+    bool lap_started;                   /**< 是否已经过起终点线 */
+    volatile bool track_enabled;        /**< 赛道记忆是否启用 */
+    track_map_t track;                  /**< 赛道表 (启用时仅由控制节拍中断写) */
+    motor_line_stats_t stats;           /**< 统计 (active在读取时填写) */
+} motor_line_t;
+
+static motor_line_t g_line = {0};
+
 /* ========================================================================== */
 /*                              私有函数声明                                  */
 /* ========================================================================== */
@@ -43,6 +182,111 @@ static void update_motor_status(uint8_t motor, uint16_t speed, int8_t direction)
  */
 static bool is_valid_speed(uint16_t speed);
 
+/**
+ * @brief 启动编码器、里程计和控制节拍
+ * @return int32_t 0: 成功, -1: 启动失败
+ */
+static int32_t motor_ctrl_start(void);
+
+/**
+ * @brief 进入速度闭环 (已在闭环中则直接返回)
+ * @return int32_t 0: 成功
+ */
+static int32_t speed_loop_engage(void);
+
+/**
+ * @brief 退出速度闭环，返回后控制中断不再驱动电机
+ */
+static void speed_loop_release(void);
+
+/**
+ * @brief 下发一条开环指令: 退出闭环，更新规划目标并启动运动规划
+ * @param left 左轮目标占空比 (Q15，带符号)
+ * @param right 右轮目标占空比 (Q15，带符号)
+ * @return int32_t 0: 成功
+ */
+static int32_t profile_command(int32_t left, int32_t right);
+
+/**
+ * @brief 停止运动规划，返回后控制中断不再驱动电机
+ */
+static void profile_release(void);
+
+/**
+ * @brief 续约: 在下发一条运动指令之前调用 (主循环上下文)
+ * @note 先续约再写目标值，中断不会在新指令之后又按旧租约到期
+ */
+static void lease_renew(void);
+
+/**
+ * @brief 结束租约 (停止后不再计时)
+ */
+static void lease_disarm(void);
+
+/**
+ * @brief 租约到期: 退出闭环，从当前指令按运动规划减速到0 (中断上下文)
+ */
+static void lease_expire(void);
+
+/**
+ * @brief 退出巡线，返回后控制中断不再覆盖目标速度
+ */
+static void line_mode_release(void);
+
+/**
+ * @brief 巡线一个周期: 取最近一次循迹读数，更新目标速度和计圈 (中断上下文)
+ */
+static void line_mode_tick(void);
+
+/**
+ * @brief 赛道记忆一个周期: 起终点对齐、第一圈记录、分批规划 (中断上下文)
+ * @param pose 本周期里程计
+ * @param out 本周期巡线输出
+ * @param lap_mark 本周期经过起终点线
+ */
+static void line_track_tick(const odometry_pose_t *pose, const line_follow_output_t *out, bool lap_mark);
+
+/**
+ * @brief 控制节拍回调 (中断上下文)
+ */
+static void motor_ctrl_tick(void);
+
+/**
+ * @brief 在中断中暂存一个车轮的输出
+ * @param wheel 车轮 (0=左/电机A, 1=右/电机B)
+ * @param output 输出 (Q15占空比，带符号)
+ * @return bool 与上次下发的值是否不同
+ */
+static bool motor_ctrl_stage_output(uint8_t wheel, int32_t output);
+
+/**
+ * @brief 在中断中把一个车轮的指令经过执行映射
+ * @param wheel 车轮 (0=左/电机A, 1=右/电机B)
+ * @param command 指令 (Q15占空比，带符号)
+ * @return int32_t 下发占空比 (Q15，带符号)
+ */
+static int32_t motor_ctrl_actuate(uint8_t wheel, int32_t command);
+
+/**
+ * @brief 按默认配置生成两轮的执行映射
+ */
+static void actuation_init_default(void);
+
+/**
+ * @brief 忙等待指定毫秒数 (主循环上下文)
+ */
+static void motor_app_wait_ms(uint32_t ms);
+
+/**
+ * @brief 百分比换算为Q15占空比
+ */
+static int32_t percent_to_q15(int32_t percent);
+
+/**
+ * @brief Q15占空比换算为百分比 (四舍五入)
+ */
+static uint16_t q15_to_percent(uint16_t duty);
+
 /* ========================================================================== */
 /*                              应用层API接口实现                            */
 /* ========================================================================== */
@@ -73,6 +317,13 @@ int32_t motor_app_init(void)
     /* 确保电机初始状态为停止 */
     tb6612_stop_all();
     
+    /* 启动编码器测速、里程计和1kHz控制节拍 */
+    if (motor_ctrl_start() != 0) {
+        tb6612_deinit();
+        memset(&g_motor_app_status, 0, sizeof(motor_app_status_t));
+        return -1;
+    }
+    
     return 0;  /* 初始化成功 */
 }
 
@@ -86,7 +337,10 @@ int32_t motor_app_deinit(void)
         return 0;  /* 未初始化，直接返回成功 */
     }
     
-    /* 停止所有电机 */
+    /* 停止控制节拍并停止所有电机 */
+    tick_port_ctrl_stop();
+    speed_loop_release();
+    profile_release();
     tb6612_stop_all();
     
     /* 反初始化TB6612FNG驱动层 */
@@ -143,34 +397,66 @@ int32_t motor_app_control_motors(const motor_control_t *control)
     if (!g_motor_app_status.initialized) {
         return -1;
     }
-    
-    /* 处理左轮控制 */
-    uint16_t left_speed = (uint16_t)abs(control->left_speed);
-    tb6612_direction_t left_dir = TB6612_STOP;
-    if (control->left_speed > 0) {
-        left_dir = TB6612_FORWARD;
-    } else if (control->left_speed < 0) {
-        left_dir = TB6612_BACKWARD;
+
+    if (control->left_speed < -100 || control->left_speed > 100 ||
+        control->right_speed < -100 || control->right_speed > 100) {
+        return -1;
     }
     
-    /* 处理右轮控制 */
-    uint16_t right_speed = (uint16_t)abs(control->right_speed);
+    /* 由控制节拍按运动规划限值逐步下发 */
+    lease_renew();
+    return profile_command(percent_to_q15(control->left_speed), percent_to_q15(control->right_speed));
+}
+
+/**
+ * @brief 以Q15占空比控制双电机
+ */
+int32_t motor_app_control_motors_raw(int16_t left_duty, int16_t right_duty)
+{
+    tb6612_direction_t left_dir = TB6612_STOP;
     tb6612_direction_t right_dir = TB6612_STOP;
-    if (control->right_speed > 0) {
-        right_dir = TB6612_FORWARD;
-    } else if (control->right_speed < 0) {
-        right_dir = TB6612_BACKWARD;
+    int8_t left_sign = (int8_t)((left_duty > 0) - (left_duty < 0));
+    int8_t right_sign = (int8_t)((right_duty > 0) - (right_duty < 0));
+    uint16_t left_abs = (uint16_t)abs(left_duty);
+    uint16_t right_abs = (uint16_t)abs(right_duty);
+    tb6612_error_t ret;
+
+    /* 参数检查 (-32768没有对称的正值) */
+    if (left_duty == INT16_MIN || right_duty == INT16_MIN) {
+        return -1;
     }
-    
+
+    if (!g_motor_app_status.initialized) {
+        return -1;
+    }
+
+    if (left_sign != 0) {
+        left_dir = (left_sign > 0) ? TB6612_FORWARD : TB6612_BACKWARD;
+    }
+    if (right_sign != 0) {
+        right_dir = (right_sign > 0) ? TB6612_FORWARD : TB6612_BACKWARD;
+    }
+
+    /* 从续约到写完输出屏蔽控制节拍: 租约若在其间到期，中断会启动运动规划减速
+     * 并与这里同时写同一对通道；挂起的节拍在恢复后执行，到期处理从新指令开始 */
+    tick_port_ctrl_mask(1);
+    lease_renew();
+    speed_loop_release();
+    profile_release();
+    g_speed_loop.command[0] = left_duty;
+    g_speed_loop.command[1] = right_duty;
+
     /* 调用TB6612FNG驱动层接口 */
-    if (tb6612_set_motor_pair(left_speed, left_dir, right_speed, right_dir) != TB6612_OK) {
+    ret = tb6612_set_motor_pair_raw(left_abs, left_dir, right_abs, right_dir);
+    tick_port_ctrl_mask(0);
+    if (ret != TB6612_OK) {
         return -1;
     }
-    
-    /* 更新状态信息 */
-    update_motor_status(0, left_speed, (control->left_speed > 0) ? 1 : ((control->left_speed < 0) ? -1 : 0));
-    update_motor_status(1, right_speed, (control->right_speed > 0) ? 1 : ((control->right_speed < 0) ? -1 : 0));
-    
+
+    /* 更新状态信息 (百分比) */
+    update_motor_status(0, q15_to_percent(left_abs), left_sign);
+    update_motor_status(1, q15_to_percent(right_abs), right_sign);
+
     return 0;
 }
 
@@ -191,17 +477,9 @@ int32_t motor_app_move_forward(uint16_t speed)
     if (!g_motor_app_status.initialized) {
         return -1;
     }
-    
-    /* 调用TB6612FNG驱动层接口 */
-    if (tb6612_move_forward(speed) != TB6612_OK) {
-        return -1;
-    }
-    
-    /* 更新状态信息 */
-    update_motor_status(0, speed, 1);  /* 电机A前进 */
-    update_motor_status(1, speed, 1);  /* 电机B前进 */
-    
-    return 0;
+
+    lease_renew();
+    return profile_command(percent_to_q15(speed), percent_to_q15(speed));
 }
 
 /**
@@ -217,17 +495,9 @@ int32_t motor_app_move_backward(uint16_t speed)
     if (!g_motor_app_status.initialized) {
         return -1;
     }
-    
-    /* 调用TB6612FNG驱动层接口 */
-    if (tb6612_move_backward(speed) != TB6612_OK) {
-        return -1;
-    }
-    
-    /* 更新状态信息 */
-    update_motor_status(0, speed, -1);  /* 电机A后退 */
-    update_motor_status(1, speed, -1);  /* 电机B后退 */
-    
-    return 0;
+
+    lease_renew();
+    return profile_command(-percent_to_q15(speed), -percent_to_q15(speed));
 }
 
 /**
@@ -243,17 +513,10 @@ int32_t motor_app_turn_left(uint16_t speed)
     if (!g_motor_app_status.initialized) {
         return -1;
     }
-    
-    /* 调用TB6612FNG驱动层接口 */
-    if (tb6612_turn_left(speed) != TB6612_OK) {
-        return -1;
-    }
-    
-    /* 更新状态信息 */
-    update_motor_status(0, speed, -1);  /* 电机A后退 */
-    update_motor_status(1, speed, 1);   /* 电机B前进 */
-    
-    return 0;
+
+    /* 与tb6612_turn_left()一致: 左轮停、右轮前进 */
+    lease_renew();
+    return profile_command(0, percent_to_q15(speed));
 }
 
 /**
@@ -269,17 +532,10 @@ int32_t motor_app_turn_right(uint16_t speed)
     if (!g_motor_app_status.initialized) {
         return -1;
     }
-    
-    /* 调用TB6612FNG驱动层接口 */
-    if (tb6612_turn_right(speed) != TB6612_OK) {
-        return -1;
-    }
-    
-    /* 更新状态信息 */
-    update_motor_status(0, speed, 1);   /* 电机A前进 */
-    update_motor_status(1, speed, -1);  /* 电机B后退 */
-    
-    return 0;
+
+    /* 与tb6612_turn_right()一致: 左轮前进、右轮停 */
+    lease_renew();
+    return profile_command(percent_to_q15(speed), 0);
 }
 
 /**
@@ -290,6 +546,12 @@ int32_t motor_app_stop_all(void)
     if (!g_motor_app_status.initialized) {
         return -1;
     }
+
+    lease_disarm();
+    speed_loop_release();
+    profile_release();
+    g_speed_loop.command[0] = 0;
+    g_speed_loop.command[1] = 0;
     
     /* 调用TB6612FNG驱动层接口 */
     if (tb6612_stop_all() != TB6612_OK) {
@@ -304,29 +566,1085 @@ int32_t motor_app_stop_all(void)
 }
 
 /* ========================================================================== */
-/*                              私有函数实现                                  */
+/*                              速度闭环接口实现                              */
 /* ========================================================================== */
 
 /**
- * @brief 更新电机状态信息
+ * @brief 设置左右轮目标速度并进入闭环控制
  */
-static void update_motor_status(uint8_t motor, uint16_t speed, int8_t direction)
+int32_t motor_app_set_wheel_velocity(int32_t left_cps, int32_t right_cps)
 {
-    if (motor == 0) {  /* 电机A */
-        g_motor_app_status.current_speed_a = speed;
-        g_motor_app_status.current_dir_a = direction;
-    } else if (motor == 1) {  /* 电机B */
-        g_motor_app_status.current_speed_b = speed;
-        g_motor_app_status.current_dir_b = direction;
+    /* 参数检查 */
+    if (!g_motor_app_status.initialized) {
+        return -1;
+    }
+
+    if (labs(left_cps) > MOTOR_SPEED_MAX_CPS || labs(right_cps) > MOTOR_SPEED_MAX_CPS) {
+        return -1;
     }
+
+    lease_renew();
+    line_mode_release();
+
+    /* 顺序锁写入，中断读到奇数序号时沿用上一组目标值 */
+    g_speed_loop.setpoint_seq++;
+    __COMPILER_BARRIER();
+    g_speed_loop.target[0] = left_cps;
+    g_speed_loop.target[1] = right_cps;
+    __COMPILER_BARRIER();
+    g_speed_loop.setpoint_seq++;
+
+    return speed_loop_engage();
 }
 
 /**
- * @brief 参数有效性检查
+ * @brief 以米/秒设置左右轮目标速度
  */
-static bool is_valid_speed(uint16_t speed)
+int32_t motor_app_set_wheel_velocity_mps(float left_mps, float right_mps)
 {
-    return (speed <= 100);
+    float counts_per_m;
+    float left_cps;
+    float right_cps;
+
+    if (!g_motor_app_status.initialized) {
+        return -1;
+    }
+
+    counts_per_m = 1.0f / wheel_enc_m_per_count();
+    left_cps = left_mps * counts_per_m;
+    right_cps = right_mps * counts_per_m;
+
+    /* 先在浮点域检查范围，避免转换为整数时溢出 */
+    if (left_cps > (float)MOTOR_SPEED_MAX_CPS || left_cps < -(float)MOTOR_SPEED_MAX_CPS ||
+        right_cps > (float)MOTOR_SPEED_MAX_CPS || right_cps < -(float)MOTOR_SPEED_MAX_CPS) {
+        return -1;
+    }
+
+    return motor_app_set_wheel_velocity((int32_t)left_cps, (int32_t)right_cps);
+}
+
+/**
+ * @brief 以线速度和角速度驱动底盘
+ * @note 饱和时两轮共用一个缩放系数，左右轮速度之比(即曲率)不变
+ */
+int32_t motor_app_set_body_velocity(float v_mps, float omega_rps)
+{
+    float base_cps;
+    float diff_cps;
+    float left_cps;
+    float right_cps;
+    float peak;
+    float scale;
+
+    if (!g_motor_app_status.initialized) {
+        return -1;
+    }
+
+    /* NaN/Inf在比较中均为假，可一并拒绝 */
+    if (!(v_mps > -1.0e6f && v_mps < 1.0e6f) || !(omega_rps > -1.0e6f && omega_rps < 1.0e6f)) {
+        return -1;
+    }
+
+    base_cps = v_mps * g_kinematics.counts_per_m;
+    diff_cps = omega_rps * g_kinematics.half_base_counts;
+    left_cps = base_cps - diff_cps;
+    right_cps = base_cps + diff_cps;
+
+    peak = (fabsf(left_cps) > fabsf(right_cps)) ? fabsf(left_cps) : fabsf(right_cps);
+    if (peak > (float)MOTOR_SPEED_MAX_CPS) {
+        scale = (float)MOTOR_SPEED_MAX_CPS / peak;
+        left_cps *= scale;
+        right_cps *= scale;
+    }
+
+    /* 截断取整，缩放后的值不会超出±MOTOR_SPEED_MAX_CPS */
+    return motor_app_set_wheel_velocity((int32_t)left_cps, (int32_t)right_cps);
+}
+
+/**
+ * @brief 设置速度闭环PID增益
+ */
+int32_t motor_app_set_speed_gains(int32_t kp_q16, int32_t ki_q16, int32_t kd_q16)
+{
+    bool was_active = g_speed_loop.active;
+
+    /* 参数检查 */
+    if (kp_q16 < 0 || ki_q16 < 0 || kd_q16 < 0) {
+        return -1;
+    }
+
+    /* 先退出闭环再修改，避免中断读到一半更新的配置 */
+    g_speed_loop.active = false;
+    __COMPILER_BARRIER();
+
+    g_speed_loop.config.kp_q16 = kp_q16;
+    g_speed_loop.config.ki_q16 = ki_q16;
+    g_speed_loop.config.kd_q16 = kd_q16;
+
+    if (was_active) {
+        return speed_loop_engage();
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 获取速度闭环状态
+ */
+int32_t motor_app_get_speed_status(motor_speed_status_t *status)
+{
+    /* 参数检查 */
+    if (status == NULL || !g_motor_app_status.initialized) {
+        return -1;
+    }
+
+    status->active = g_speed_loop.active;
+    status->target_left = g_speed_loop.target[0];
+    status->target_right = g_speed_loop.target[1];
+    status->speed_left = g_speed_loop.speed[0];
+    status->speed_right = g_speed_loop.speed[1];
+    status->output_left = g_speed_loop.output[0];
+    status->output_right = g_speed_loop.output[1];
+
+    return 0;
+}
+
+/**
+ * @brief 获取速度闭环执行时间与抖动统计
+ */
+int32_t motor_app_get_speed_stats(motor_speed_stats_t *stats)
+{
+    /* 参数检查 */
+    if (stats == NULL) {
+        return -1;
+    }
+
+    /* 统计字段在中断中各自独立累加，彼此无一致性约束，无需序号保护，直接整体复制即可 (其余统计快照同此) */
+    *stats = g_speed_loop.stats;
+    stats->nominal_cycles = tick_port_cycles_per_us() * (1000000UL / MOTOR_SPEED_RATE_HZ);
+
+    return 0;
+}
+
+/**
+ * @brief 清零速度闭环统计
+ */
+void motor_app_reset_speed_stats(void)
+{
+    if (g_motor_app_status.initialized) {
+        g_speed_loop.stats_reset = true;
+    } else {
+        memset(&g_speed_loop.stats, 0, sizeof(g_speed_loop.stats));
+    }
+}
+
+/* ========================================================================== */
+/*                              巡线接口实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 启动巡线
+ */
+int32_t motor_app_start_line_follow(const line_follow_config_t *config, uint32_t junctions_per_lap)
+{
+    static const line_follow_config_t k_default = {
+        .kp = MOTOR_LINE_DEFAULT_KP,
+        .kd = MOTOR_LINE_DEFAULT_KD,
+        .d_cutoff_hz = MOTOR_LINE_DEFAULT_D_HZ,
+        .speed_max_cps = MOTOR_LINE_DEFAULT_VMAX,
+        .speed_min_cps = MOTOR_LINE_DEFAULT_VMIN,
+        .slow_error = MOTOR_LINE_DEFAULT_SLOW_ERR,
+        .turn_cps = MOTOR_LINE_DEFAULT_TURN,
+        .cross_hold_ms = MOTOR_LINE_DEFAULT_HOLD_MS,
+        .lost_timeout_ms = MOTOR_LINE_DEFAULT_LOST_MS,
+    };
+
+    if (!g_motor_app_status.initialized) {
+        return -1;
+    }
+
+    /* 控制中断在active为false时不访问巡线状态，可安全重置 */
+    line_mode_release();
+    if (line_follow_init(&g_line.lf, (config != NULL) ? config : &k_default, MOTOR_SPEED_RATE_HZ) != 0) {
+        return -1;
+    }
+    g_line.junctions_per_lap = junctions_per_lap;
+    g_line.last_seq = 0;
+    g_line.ticks = 0;
+    g_line.lap_start = 0;
+    g_line.lap_junctions = 0;
+    g_line.lap_started = false;
+    memset(&g_line.stats, 0, sizeof(g_line.stats));
+    g_line.stats_reset = false;
+
+    if (line_sensor_capture_start(0) != 0) {
+        return -2;
+    }
+
+    /* 自主运行，不受遥控租约约束；闭环目标从0开始，由巡线逐周期覆盖 */
+    lease_disarm();
+    g_speed_loop.setpoint_seq++;
+    __COMPILER_BARRIER();
+    g_speed_loop.target[0] = 0;
+    g_speed_loop.target[1] = 0;
+    __COMPILER_BARRIER();
+    g_speed_loop.setpoint_seq++;
+
+    speed_loop_engage();
+
+    __COMPILER_BARRIER();
+    g_line.active = true;
+
+    return 0;
+}
+
+/**
+ * @brief 停止巡线并停车
+ */
+int32_t motor_app_stop_line_follow(void)
+{
+    return motor_app_stop_all();
+}
+
+/**
+ * @brief 获取巡线统计
+ */
+int32_t motor_app_get_line_stats(motor_line_stats_t *stats)
+{
+    if (stats == NULL) {
+        return -1;
+    }
+
+    *stats = g_line.stats;
+    stats->active = g_line.active && g_speed_loop.active;
+    stats->track_state = g_line.track.state;
+    stats->track_bins = g_line.track.count;
+    stats->track_plan_ms = (g_line.track.state == TRACK_MAP_READY) ?
+                           (uint32_t)(g_line.track.plan_time_s * 1000.0f) : 0U;
+
+    return 0;
+}
+
+/**
+ * @brief 清零巡线统计
+ * @note 圈速基准(当前圈起点)不变，清零后下一圈仍完整计时
+ */
+void motor_app_reset_line_stats(void)
+{
+    if (g_motor_app_status.initialized) {
+        g_line.stats_reset = true;
+    } else {
+        memset(&g_line.stats, 0, sizeof(g_line.stats));
+    }
+}
+
+/**
+ * @brief 启用赛道记忆
+ */
+int32_t motor_app_enable_track_learning(const track_map_config_t *config)
+{
+    static const track_map_config_t k_default = {
+        .bin_m = MOTOR_TRACK_DEFAULT_BIN_M,
+        .v_max = MOTOR_TRACK_DEFAULT_VMAX,
+        .v_min = MOTOR_TRACK_DEFAULT_VMIN,
+        .a_lat = MOTOR_TRACK_DEFAULT_A_LAT,
+        .a_accel = MOTOR_TRACK_DEFAULT_ACCEL,
+        .a_brake = MOTOR_TRACK_DEFAULT_BRAKE,
+        .lookahead_s = MOTOR_TRACK_DEFAULT_LOOK_S,
+    };
+    int32_t ret;
+
+    if (!g_motor_app_status.initialized) {
+        return -1;
+    }
+
+    /* 控制中断在track_enabled为false时不访问赛道表，可安全重置 */
+    g_line.track_enabled = false;
+    __COMPILER_BARRIER();
+    ret = track_map_init(&g_line.track, (config != NULL) ? config : &k_default);
+    if (ret != 0) {
+        return ret;
+    }
+    __COMPILER_BARRIER();
+    g_line.track_enabled = true;
+
+    return 0;
+}
+
+/**
+ * @brief 停用赛道记忆
+ */
+void motor_app_disable_track_learning(void)
+{
+    g_line.track_enabled = false;
+    __COMPILER_BARRIER();
+}
+
+/**
+ * @brief 获取赛道表
+ */
+const track_map_t *motor_app_get_track_map(void)
+{
+    return &g_line.track;
+}
+
+/* ========================================================================== */
+/*                              运动规划接口实现                              */
+/* ========================================================================== */
+
+/**
+ * @brief 设置开环指令的运动规划限值
+ */
+int32_t motor_app_set_profile_limits(uint32_t accel, uint32_t jerk)
+{
+    bool was_active = g_profile.active;
+
+    if (!g_motor_app_status.initialized) {
+        return -1;
+    }
+
+    /* 先停止规划再修改，避免中断读到一半更新的配置；电机保持当前占空比 */
+    profile_release();
+    motion_profile_config(&g_profile.config, accel, jerk, MOTOR_SPEED_RATE_HZ);
+
+    if (was_active) {
+        return profile_command(g_profile.target[0], g_profile.target[1]);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 获取当前开环指令到达目标的剩余时间
+ */
+uint32_t motor_app_get_profile_eta_ms(void)
+{
+    return (g_profile.eta_ticks * 1000UL) / MOTOR_SPEED_RATE_HZ;
+}
+
+/* ========================================================================== */
+/*                              指令租约接口实现                              */
+/* ========================================================================== */
+
+/**
+ * @brief 设置运动指令的租约时长
+ */
+int32_t motor_app_set_command_lease(uint32_t lease_ms)
+{
+    if (!g_motor_app_status.initialized) {
+        return -1;
+    }
+
+    g_lease.lease_ms = lease_ms;
+
+    return 0;
+}
+
+/**
+ * @brief 获取指令租约统计
+ */
+int32_t motor_app_get_lease_stats(motor_lease_stats_t *stats)
+{
+    uint8_t state = g_lease.state;
+
+    if (stats == NULL) {
+        return -1;
+    }
+
+    *stats = g_lease.stats;
+    stats->failsafe = (state == MOTOR_LEASE_RAMP || state == MOTOR_LEASE_BRAKED);
+    stats->lease_ms = g_lease.lease_ms;
+
+    return 0;
+}
+
+/**
+ * @brief 清零指令租约统计
+ * @note 诊断用，与中断中的更新并发时可能丢失一次计数
+ */
+void motor_app_reset_lease_stats(void)
+{
+    memset(&g_lease.stats, 0, sizeof(g_lease.stats));
+    g_lease.stats.margin_min_ms = UINT32_MAX;
+}
+
+/* ========================================================================== */
+/*                              执行映射接口实现                              */
+/* ========================================================================== */
+
+/**
+ * @brief 启用或关闭执行映射
+ */
+int32_t motor_app_set_actuation_enabled(bool enable)
+{
+    if (!g_motor_app_status.initialized) {
+        return -1;
+    }
+
+    g_actuation.enabled = enable;
+
+    return 0;
+}
+
+/**
+ * @brief 提供电机电源电压
+ * @note 补偿增益为单个16位字段，中断中读到的总是完整的新值或旧值
+ */
+int32_t motor_app_set_supply_voltage(uint32_t supply_mv)
+{
+    if (!g_motor_app_status.initialized) {
+        return -1;
+    }
+
+    actuation_map_set_supply(&g_actuation.map[0], supply_mv, MOTOR_ACT_NOMINAL_MV);
+    actuation_map_set_supply(&g_actuation.map[1], supply_mv, MOTOR_ACT_NOMINAL_MV);
+
+    return 0;
+}
+
+/**
+ * @brief 扫描占空比并拟合两轮的执行映射
+ * @note 每级先等待稳定，再用时间窗口内的位置增量测速 (比瞬时速度噪声小)；
+ *       扫描经过原始占空比接口，不经过映射和运动规划
+ */
+int32_t motor_app_characterize(motor_act_report_t *report)
+{
+    static uint16_t duty[MOTOR_ACT_CAL_STEPS + 1U];
+    static int32_t vel[2][MOTOR_ACT_CAL_STEPS + 1U];
+    motor_act_report_t result;
+    actuation_map_t fitted;
+    wheel_enc_snapshot_t snap;
+    tb6612_config_t config;
+    int64_t start[2];
+    uint16_t max_duty;
+    uint32_t lease_ms;
+    int32_t ret = 0;
+    uint32_t step;
+    uint8_t i;
+
+    if (!g_motor_app_status.initialized || tb6612_get_config(&config) != TB6612_OK) {
+        return -1;
+    }
+
+    memset(&result, 0, sizeof(result));
+    max_duty = (uint16_t)percent_to_q15(config.max_duty_cycle);
+
+    /* 扫描中每级间隔较长，暂停租约以免中途触发失效保护 */
+    lease_ms = g_lease.lease_ms;
+    g_lease.lease_ms = 0;
+
+    for (step = 0; step <= MOTOR_ACT_CAL_STEPS; step++) {
+        duty[step] = (uint16_t)(((uint32_t)max_duty * step) / MOTOR_ACT_CAL_STEPS);
+        if (motor_app_control_motors_raw((int16_t)duty[step], (int16_t)duty[step]) != 0) {
+            motor_app_stop_all();
+            g_lease.lease_ms = lease_ms;
+            return -1;
+        }
+        motor_app_wait_ms(MOTOR_ACT_CAL_SETTLE_MS);
+
+        wheel_enc_get(&snap);
+        for (i = 0; i < 2; i++) {
+            start[i] = snap.wheel[i].position;
+        }
+        motor_app_wait_ms(MOTOR_ACT_CAL_SAMPLE_MS);
+        wheel_enc_get(&snap);
+        for (i = 0; i < 2; i++) {
+            vel[i][step] = (int32_t)(((snap.wheel[i].position - start[i]) * 1000) / MOTOR_ACT_CAL_SAMPLE_MS);
+        }
+    }
+
+    motor_app_stop_all();
+    g_lease.lease_ms = lease_ms;
+
+    /* 已停止，控制中断不再读取映射，可直接替换 */
+    for (i = 0; i < 2; i++) {
+        fitted = g_actuation.map[i];
+        result.full_cps[i] = vel[i][MOTOR_ACT_CAL_STEPS];
+        if (actuation_map_fit(&fitted, duty, vel[i], MOTOR_ACT_CAL_STEPS + 1U) != 0) {
+            ret = -1;
+            continue;
+        }
+        g_actuation.map[i] = fitted;
+        result.fitted[i] = true;
+        result.coulomb[i] = fitted.lut[0];
+        result.breakaway[i] = (uint16_t)(fitted.lut[0] + fitted.kick);
+    }
+
+    if (report != NULL) {
+        *report = result;
+    }
+
+    return ret;
+}
+
+/* ========================================================================== */
+/*                              私有函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 更新电机状态信息
+ */
+static void update_motor_status(uint8_t motor, uint16_t speed, int8_t direction)
+{
+    if (motor == 0) {  /* 电机A */
+        g_motor_app_status.current_speed_a = speed;
+        g_motor_app_status.current_dir_a = direction;
+    } else if (motor == 1) {  /* 电机B */
+        g_motor_app_status.current_speed_b = speed;
+        g_motor_app_status.current_dir_b = direction;
+    }
+}
+
+/**
+ * @brief 参数有效性检查
+ */
+static bool is_valid_speed(uint16_t speed)
+{
+    return (speed <= 100);
+}
+
+/**
+ * @brief 启动编码器、里程计和控制节拍
+ */
+static int32_t motor_ctrl_start(void)
+{
+    g_speed_loop.active = false;
+    memset(&g_speed_loop.stats, 0, sizeof(g_speed_loop.stats));
+    g_speed_loop.stats_reset = false;
+
+    memset(g_speed_loop.command, 0, sizeof(g_speed_loop.command));
+    actuation_init_default();
+
+    memset(&g_lease, 0, sizeof(g_lease));
+    g_lease.lease_ms = MOTOR_LEASE_DEFAULT_MS;
+    g_lease.remaining = MOTOR_LEASE_NONE;
+    g_lease.stats.margin_min_ms = UINT32_MAX;
+
+    memset(&g_profile, 0, sizeof(g_profile));
+    motion_profile_config(&g_profile.config, MOTOR_PROFILE_DEFAULT_ACCEL, MOTOR_PROFILE_DEFAULT_JERK,
+                          MOTOR_SPEED_RATE_HZ);
+
+    if (wheel_enc_init(MOTOR_SPEED_RATE_HZ) != 0) {
+        return -1;
+    }
+
+    g_kinematics.counts_per_m = 1.0f / wheel_enc_m_per_count();
+    g_kinematics.half_base_counts = 0.5f * wheel_enc_wheel_base() * g_kinematics.counts_per_m;
+
+    if (odometry_init(MOTOR_SPEED_RATE_HZ, ODOM_DEFAULT_GYRO_WEIGHT) != 0) {
+        return -1;
+    }
+
+    if (tick_port_ctrl_start(MOTOR_SPEED_RATE_HZ, motor_ctrl_tick) != 0) {
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 进入速度闭环
+ */
+static int32_t speed_loop_engage(void)
+{
+    uint8_t i;
+
+    if (g_speed_loop.active) {
+        return 0;
+    }
+
+    profile_release();
+
+    /* 控制中断在active为false时不访问PID和输出缓存，可安全重置 */
+    for (i = 0; i < 2; i++) {
+        speed_ctrl_pid_init(&g_speed_loop.pid[i], &g_speed_loop.config);
+        g_speed_loop.output[i] = 0;
+        g_speed_loop.last_duty[i] = 0xFFFF;     /* 强制第一个周期下发 */
+        g_speed_loop.last_dir[i] = TB6612_STOP;
+    }
+
+    __COMPILER_BARRIER();
+    g_speed_loop.active = true;
+
+    return 0;
+}
+
+/**
+ * @brief 退出速度闭环
+ */
+static void speed_loop_release(void)
+{
+    line_mode_release();
+    g_speed_loop.active = false;
+    __COMPILER_BARRIER();
+}
+
+/**
+ * @brief 下发一条开环指令
+ */
+static int32_t profile_command(int32_t left, int32_t right)
+{
+    uint32_t eta;
+    uint8_t i;
+
+    speed_loop_release();
+
+    /* 顺序锁写入，中断读到奇数序号时沿用上一组目标值 */
+    g_profile.target_seq++;
+    __COMPILER_BARRIER();
+    g_profile.target[0] = left;
+    g_profile.target[1] = right;
+    __COMPILER_BARRIER();
+    g_profile.target_seq++;
+
+    if (g_profile.active) {
+        return 0;
+    }
+
+    /* 控制中断在active为false时不访问规划状态，从当前指令(映射前)开始规划 */
+    g_profile.eta_ticks = 0;
+    for (i = 0; i < 2; i++) {
+        motion_profile_reset(&g_profile.prof[i], g_speed_loop.command[i]);
+        motion_profile_set_target(&g_profile.prof[i], g_profile.target[i]);
+        g_speed_loop.last_duty[i] = 0xFFFF;     /* 强制第一个周期下发 */
+        g_speed_loop.last_dir[i] = TB6612_STOP;
+        eta = motion_profile_eta_ticks(&g_profile.prof[i], &g_profile.config);
+        if (eta > g_profile.eta_ticks) {
+            g_profile.eta_ticks = eta;
+        }
+    }
+
+    __COMPILER_BARRIER();
+    g_profile.active = true;
+
+    return 0;
+}
+
+/**
+ * @brief 停止运动规划
+ */
+static void profile_release(void)
+{
+    g_profile.active = false;
+    __COMPILER_BARRIER();
+    g_profile.eta_ticks = 0;
+}
+
+/**
+ * @brief 续约
+ */
+static void lease_renew(void)
+{
+    uint32_t lease_ms = g_lease.lease_ms;
+    uint32_t left = g_lease.remaining;
+    uint32_t ticks;
+    uint32_t margin;
+
+    if (lease_ms == 0) {
+        g_lease.remaining = MOTOR_LEASE_NONE;
+        g_lease.state = MOTOR_LEASE_IDLE;
+        return;
+    }
+
+    /* 仍在计时中的续约: 记录距离到期还剩多少，评估链路抖动余量 */
+    if (g_lease.state == MOTOR_LEASE_ARMED && left != MOTOR_LEASE_NONE) {
+        margin = (left * 1000UL) / MOTOR_SPEED_RATE_HZ;
+        if (margin < g_lease.stats.margin_min_ms) {
+            g_lease.stats.margin_min_ms = margin;
+        }
+    }
+
+    ticks = (lease_ms * MOTOR_SPEED_RATE_HZ + 999UL) / 1000UL;
+    g_lease.remaining = (ticks > 0) ? ticks : 1;
+    __COMPILER_BARRIER();
+    g_lease.state = MOTOR_LEASE_ARMED;
+    g_lease.stats.renewals++;
+}
+
+/**
+ * @brief 结束租约
+ */
+static void lease_disarm(void)
+{
+    g_lease.remaining = MOTOR_LEASE_NONE;
+    __COMPILER_BARRIER();
+    g_lease.state = MOTOR_LEASE_IDLE;
+}
+
+/**
+ * @brief 租约到期
+ * @note 绕过顺序锁直接写0目标: 主循环若正在写目标值，说明已先续约，
+ *       其写完的新指令会覆盖这里的0目标
+ */
+static void lease_expire(void)
+{
+    uint8_t i;
+
+    g_line.active = false;
+    g_speed_loop.active = false;
+
+    for (i = 0; i < 2; i++) {
+        if (!g_profile.active) {
+            motion_profile_reset(&g_profile.prof[i], g_speed_loop.command[i]);
+        }
+        g_profile.target[i] = 0;
+        motion_profile_set_target(&g_profile.prof[i], 0);
+    }
+    g_profile.active = true;
+
+    g_lease.state = MOTOR_LEASE_RAMP;
+    g_lease.ramp_ticks = 0;
+    g_lease.stats.expiries++;
+}
+
+/**
+ * @brief 退出巡线
+ */
+static void line_mode_release(void)
+{
+    g_line.active = false;
+    __COMPILER_BARRIER();
+}
+
+/**
+ * @brief 巡线一个周期
+ * @note 输出超出±MOTOR_SPEED_MAX_CPS时两轮同比例缩小，保持转向比例；
+ *       直接写入本周期使用的目标速度(applied)，主循环的目标值不参与
+ */
+static void line_mode_tick(void)
+{
+    motor_line_stats_t *st = &g_line.stats;
+    uint32_t entry = tick_port_cycles();
+    line_sensor_reading_t reading;
+    line_follow_output_t out;
+    odometry_pose_t pose;
+    uint32_t seq, exec, lap_ms;
+    int32_t peak;
+    bool lap_mark = false;
+
+    if (g_line.stats_reset) {
+        memset(st, 0, sizeof(*st));
+        g_line.stats_reset = false;
+    }
+    g_line.ticks++;
+
+    seq = line_sensor_get_filtered(&reading);
+    if (seq == g_line.last_seq) {
+        st->stale_readings++;
+    }
+    g_line.last_seq = seq;
+
+    /* 速度曲线就绪且本次运行已对齐起终点后，按路程设置直道基础速度 */
+    odometry_get(&pose);
+    if (g_line.track_enabled && g_line.lap_started && g_line.track.state == TRACK_MAP_READY) {
+        line_follow_set_speed_max(&g_line.lf,
+            (int32_t)(track_map_speed(&g_line.track, pose.distance, pose.v) * g_kinematics.counts_per_m));
+    } else {
+        line_follow_set_speed_max(&g_line.lf, g_line.lf.cfg.speed_max_cps);
+    }
+
+    line_follow_update(&g_line.lf, &reading, &out);
+
+    peak = (labs(out.left_cps) > labs(out.right_cps)) ? labs(out.left_cps) : labs(out.right_cps);
+    if (peak > MOTOR_SPEED_MAX_CPS) {
+        out.left_cps = (int32_t)(((int64_t)out.left_cps * MOTOR_SPEED_MAX_CPS) / peak);
+        out.right_cps = (int32_t)(((int64_t)out.right_cps * MOTOR_SPEED_MAX_CPS) / peak);
+    }
+    g_speed_loop.applied[0] = out.left_cps;
+    g_speed_loop.applied[1] = out.right_cps;
+
+    if (out.lost) {
+        st->losses++;
+    }
+
+    /* 计圈: 第一个路口开始计时，每junctions_per_lap个路口一圈 */
+    if (out.junction) {
+        st->junctions++;
+        if (g_line.junctions_per_lap != 0) {
+            if (!g_line.lap_started) {
+                g_line.lap_started = true;
+                g_line.lap_start = g_line.ticks;
+                g_line.lap_junctions = 0;
+                lap_mark = true;
+            } else if (++g_line.lap_junctions >= g_line.junctions_per_lap) {
+                lap_mark = true;
+                lap_ms = ((g_line.ticks - g_line.lap_start) * 1000UL) / MOTOR_SPEED_RATE_HZ;
+                g_line.lap_start = g_line.ticks;
+                g_line.lap_junctions = 0;
+                st->laps++;
+                st->lap_ms_last = lap_ms;
+                if (st->lap_ms_best == 0 || lap_ms < st->lap_ms_best) {
+                    st->lap_ms_best = lap_ms;
+                }
+            }
+        }
+    }
+
+    st->mode = g_line.lf.mode;
+    st->position = reading.decoded.position;
+    if (g_line.track_enabled) {
+        line_track_tick(&pose, &out, lap_mark);
+    }
+    st->cycles++;
+    exec = tick_port_cycles() - entry;
+    st->exec_cycles_last = exec;
+    if (exec > st->exec_cycles_max) {
+        st->exec_cycles_max = exec;
+    }
+}
+
+/**
+ * @brief 赛道记忆一个周期
+ * @note 路口保持和丢线搜索期间的采样带上标记，规划时这些段取最低速度；
+ *       直角弯原地转向时路程几乎不变，航向变化集中在一两段内，曲率很大，同样取最低速度
+ */
+static void line_track_tick(const odometry_pose_t *pose, const line_follow_output_t *out, bool lap_mark)
+{
+    track_map_t *map = &g_line.track;
+    uint8_t flags = 0;
+
+    if (lap_mark) {
+        track_map_lap_mark(map, pose->distance);
+    }
+
+    switch (map->state) {
+    case TRACK_MAP_RECORDING:
+        if (out->junction || g_line.lf.mode == LINE_FOLLOW_CROSS) {
+            flags |= TRACK_MAP_FLAG_JUNCTION;
+        }
+        if (out->lost || g_line.lf.mode == LINE_FOLLOW_SEARCH) {
+            flags |= TRACK_MAP_FLAG_LOST;
+        }
+        track_map_record(map, pose->distance, pose->omega, 1.0f / (float)MOTOR_SPEED_RATE_HZ,
+                         g_line.stats.position, flags);
+        break;
+
+    case TRACK_MAP_PLANNING:
+        track_map_plan_step(map, MOTOR_TRACK_PLAN_BUDGET);
+        break;
+
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 控制节拍回调
+ * @note 执行顺序: 统计周期 → 租约计时 → 编码器采样与M/T测速 → 里程计 → 巡线 → PID或运动规划
+ *       → 到期减速完成时制动 → 下发输出 → 统计耗时
+ */
+static void motor_ctrl_tick(void)
+{
+    motor_speed_stats_t *st = &g_speed_loop.stats;
+    uint32_t entry = tick_port_cycles();
+    uint32_t nominal = tick_port_cycles_per_us() * (1000000UL / MOTOR_SPEED_RATE_HZ);
+    uint32_t period, jitter, exec;
+    uint32_t seq;
+    uint32_t eta, eta_max;
+    uint32_t left;
+    int32_t out;
+    bool changed;
+    uint8_t i;
+
+    if (g_speed_loop.stats_reset) {
+        memset(st, 0, sizeof(*st));
+        g_speed_loop.stats_reset = false;
+    }
+
+    /* 周期抖动 (第一个周期没有上一次进入时刻) */
+    if (st->ticks != 0) {
+        period = entry - g_speed_loop.last_entry;
+        jitter = (period > nominal) ? (period - nominal) : (nominal - period);
+        if (st->period_cycles_min == 0 || period < st->period_cycles_min) {
+            st->period_cycles_min = period;
+        }
+        if (period > st->period_cycles_max) {
+            st->period_cycles_max = period;
+        }
+        if (jitter > st->jitter_cycles_max) {
+            st->jitter_cycles_max = jitter;
+        }
+    }
+    g_speed_loop.last_entry = entry;
+
+    /* 目标值: 主循环写入过程中被打断时沿用上一组 */
+    seq = g_speed_loop.setpoint_seq;
+    if ((seq & 1U) == 0U) {
+        __COMPILER_BARRIER();
+        g_speed_loop.applied[0] = g_speed_loop.target[0];
+        g_speed_loop.applied[1] = g_speed_loop.target[1];
+    }
+
+    /* 租约计时，到期时切换到减速规划 */
+    left = g_lease.remaining;
+    if (left != MOTOR_LEASE_NONE && left != 0) {
+        g_lease.remaining = left - 1U;
+        if (left == 1U) {
+            lease_expire();
+        }
+    }
+
+    wheel_enc_update();
+    odometry_update();
+
+    for (i = 0; i < 2; i++) {
+        g_speed_loop.speed[i] = wheel_enc_velocity(i);
+    }
+
+    if (g_line.active && g_speed_loop.active) {
+        line_mode_tick();
+    }
+
+    changed = false;
+    if (g_speed_loop.active) {
+        for (i = 0; i < 2; i++) {
+            g_speed_loop.output[i] = (int16_t)speed_ctrl_pid_update(&g_speed_loop.pid[i],
+                                                                   g_speed_loop.applied[i],
+                                                                   g_speed_loop.speed[i]);
+            changed |= motor_ctrl_stage_output(i, motor_ctrl_actuate(i, g_speed_loop.output[i]));
+        }
+    } else if (g_profile.active) {
+        seq = g_profile.target_seq;
+        if ((seq & 1U) == 0U) {
+            __COMPILER_BARRIER();
+            motion_profile_set_target(&g_profile.prof[0], g_profile.target[0]);
+            motion_profile_set_target(&g_profile.prof[1], g_profile.target[1]);
+        }
+
+        eta_max = 0;
+        for (i = 0; i < 2; i++) {
+            out = motion_profile_update(&g_profile.prof[i], &g_profile.config);
+            changed |= motor_ctrl_stage_output(i, motor_ctrl_actuate(i, out));
+            eta = motion_profile_eta_ticks(&g_profile.prof[i], &g_profile.config);
+            if (eta > eta_max) {
+                eta_max = eta;
+            }
+        }
+        g_profile.eta_ticks = eta_max;
+
+        /* 到期减速完成 (期间没有新指令续约): 两轮短路制动并停止规划 */
+        if (g_lease.state == MOTOR_LEASE_RAMP) {
+            g_lease.ramp_ticks++;
+            if (eta_max == 0 && g_speed_loop.command[0] == 0 && g_speed_loop.command[1] == 0) {
+                g_profile.active = false;
+                for (i = 0; i < 2; i++) {
+                    g_speed_loop.last_duty[i] = 0;
+                    g_speed_loop.last_dir[i] = TB6612_BRAKE;
+                }
+                changed = true;
+                g_lease.state = MOTOR_LEASE_BRAKED;
+                eta = (g_lease.ramp_ticks * 1000UL) / MOTOR_SPEED_RATE_HZ;
+                g_lease.stats.reaction_ms_last = eta;
+                if (eta > g_lease.stats.reaction_ms_max) {
+                    g_lease.stats.reaction_ms_max = eta;
+                }
+            }
+        }
+    }
+
+    if (changed) {
+        tb6612_set_motor_pair_raw(g_speed_loop.last_duty[0], g_speed_loop.last_dir[0],
+                                  g_speed_loop.last_duty[1], g_speed_loop.last_dir[1]);
+        for (i = 0; i < 2; i++) {
+            update_motor_status(i, q15_to_percent(g_speed_loop.last_duty[i]),
+                                (int8_t)((g_speed_loop.last_dir[i] == TB6612_FORWARD) -
+                                         (g_speed_loop.last_dir[i] == TB6612_BACKWARD)));
+        }
+    }
+
+    exec = tick_port_cycles() - entry;
+    st->exec_cycles_last = exec;
+    if (exec > st->exec_cycles_max) {
+        st->exec_cycles_max = exec;
+    }
+    st->ticks++;
+}
+
+/**
+ * @brief 在中断中下发一个车轮的控制输出
+ * @note 输出(经过执行映射后)在±TB6612_DUTY_FULL内，直接作为原始占空比下发
+ */
+static bool motor_ctrl_stage_output(uint8_t wheel, int32_t output)
+{
+    uint16_t duty = (uint16_t)abs(output);
+    tb6612_direction_t dir = TB6612_STOP;
+
+    if (duty > 0) {
+        dir = (output > 0) ? TB6612_FORWARD : TB6612_BACKWARD;
+    }
+
+    if (duty == g_speed_loop.last_duty[wheel] && dir == g_speed_loop.last_dir[wheel]) {
+        return false;
+    }
+
+    g_speed_loop.last_duty[wheel] = duty;
+    g_speed_loop.last_dir[wheel] = dir;
+    return true;
+}
+
+/**
+ * @brief 在中断中把一个车轮的指令经过执行映射
+ * @note 静止判断用本周期的M/T法测速，低速时不会量化为0
+ */
+static int32_t motor_ctrl_actuate(uint8_t wheel, int32_t command)
+{
+    g_speed_loop.command[wheel] = command;
+
+    if (!g_actuation.enabled) {
+        return command;
+    }
+
+    return actuation_map_apply(&g_actuation.map[wheel], command,
+                               (uint8_t)(labs(g_speed_loop.speed[wheel]) < MOTOR_ACT_STATIONARY_CPS));
+}
+
+/**
+ * @brief 按默认配置生成两轮的执行映射
+ * @note 非零指令至少输出min_duty_cycle，最大不超过max_duty_cycle；静摩擦附加量需自标定得到
+ */
+static void actuation_init_default(void)
+{
+    tb6612_config_t config;
+    uint16_t coulomb = 0;
+    uint16_t max_duty = TB6612_DUTY_FULL;
+    uint8_t i;
+
+    if (tb6612_get_config(&config) == TB6612_OK) {
+        coulomb = (uint16_t)percent_to_q15(config.min_duty_cycle);
+        max_duty = (uint16_t)percent_to_q15(config.max_duty_cycle);
+    }
+
+    for (i = 0; i < 2; i++) {
+        actuation_map_init_linear(&g_actuation.map[i], coulomb, 0, max_duty);
+    }
+    g_actuation.enabled = true;
+}
+
+/**
+ * @brief 忙等待指定毫秒数
+ */
+static void motor_app_wait_ms(uint32_t ms)
+{
+    uint32_t start = tick_port_uptime_ms();
+
+    while ((tick_port_uptime_ms() - start) < ms) {
+    }
+}
+
+/**
+ * @brief 百分比换算为Q15占空比
+ */
+static int32_t percent_to_q15(int32_t percent)
+{
+    return (percent * (int32_t)TB6612_DUTY_FULL) / 100;
+}
+
+/**
+ * @brief Q15占空比换算为百分比
+ */
+static uint16_t q15_to_percent(uint16_t duty)
+{
+    return (uint16_t)(((uint32_t)duty * 100U + TB6612_DUTY_FULL / 2U) / TB6612_DUTY_FULL);
 }
 
 /* ========================================================================== */
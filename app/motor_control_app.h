@@ -26,11 +26,60 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "line_follow.h"
+#include "track_map.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* ========================================================================== */
+/*                              速度闭环配置                                  */
+/* ========================================================================== */
+
+#define MOTOR_SPEED_RATE_HZ         1000U   /**< 速度闭环控制频率 */
+#define MOTOR_SPEED_MAX_CPS         30000L  /**< 目标速度绝对值上限 (计数/秒) */
+
+/* 默认PID增益 (Q16，见speed_ctrl.h；输出单位为Q15占空比) */
+#define MOTOR_SPEED_DEFAULT_KP_Q16  85852L  /**< 1.31 Q15/(计数/秒) */
+#define MOTOR_SPEED_DEFAULT_KI_Q16  858522L /**< 13.1 Q15/计数 */
+#define MOTOR_SPEED_DEFAULT_KD_Q16  0L      /**< 默认PI控制 */
+
+/* 开环指令的默认运动规划限值 (Q15占空比，见motion_profile.h) */
+#define MOTOR_PROFILE_DEFAULT_ACCEL 109223UL    /**< 0→100%约0.3秒 (Q15/秒) */
+#define MOTOR_PROFILE_DEFAULT_JERK  1092233UL   /**< 加速度从0到上限约0.1秒 (Q15/秒²) */
+
+/* 指令租约 (无线链路失效保护) */
+#define MOTOR_LEASE_DEFAULT_MS      0U      /**< 默认租约时长 (ms)，0表示指令一直有效 */
+
+/* 执行映射 (死区跳变、静/动摩擦前馈、电压补偿，见actuation_map.h) */
+#define MOTOR_ACT_STATIONARY_CPS    100L    /**< 低于该速度视为静止，叠加静摩擦占空比 (计数/秒) */
+#define MOTOR_ACT_NOMINAL_MV        7400U   /**< 映射对应的标称电机电源电压 (mV) */
+#define MOTOR_ACT_CAL_STEPS         32U     /**< 自标定扫描的占空比级数 */
+#define MOTOR_ACT_CAL_SETTLE_MS     200U    /**< 每级等待速度稳定的时间 */
+#define MOTOR_ACT_CAL_SAMPLE_MS     100U    /**< 每级测速的时间窗口 */
+
+/* 巡线默认参数 (位置单位1/32探头间距，速度单位计数/秒，见line_follow.h) */
+#define MOTOR_LINE_DEFAULT_KP       60.0f   /**< 线在最外侧(112)时差速约6700计数/秒 */
+#define MOTOR_LINE_DEFAULT_KD       0.3f    /**< 差速 / (位置/秒)，位置跳变一格(16~32)时微分冲击约2000计数/秒 */
+#define MOTOR_LINE_DEFAULT_D_HZ     40.0f   /**< 微分低通截止频率 */
+#define MOTOR_LINE_DEFAULT_VMAX     12000L  /**< 直道基础速度 */
+#define MOTOR_LINE_DEFAULT_VMIN     4000L   /**< 大误差/直角弯时的基础速度 */
+#define MOTOR_LINE_DEFAULT_SLOW_ERR 64L     /**< 基础速度降到最低的误差 */
+#define MOTOR_LINE_DEFAULT_TURN     5000L   /**< 原地转向轮速 */
+#define MOTOR_LINE_DEFAULT_HOLD_MS  60U     /**< 路口直行保持时间 */
+#define MOTOR_LINE_DEFAULT_LOST_MS  1500U   /**< 丢线搜索超时 */
+
+/* 赛道记忆默认参数 (见track_map.h，m、m/s、m/s²) */
+#define MOTOR_TRACK_DEFAULT_BIN_M   0.02f   /**< 分段长度，1024段可记录约20m */
+#define MOTOR_TRACK_DEFAULT_VMAX    1.2f    /**< 直道速度上限 (约24000计数/秒) */
+#define MOTOR_TRACK_DEFAULT_VMIN    0.2f    /**< 急弯/丢线处速度 (与巡线默认最低速度相当) */
+#define MOTOR_TRACK_DEFAULT_A_LAT   3.0f    /**< 横向加速度上限 */
+#define MOTOR_TRACK_DEFAULT_ACCEL   2.0f    /**< 加速度上限 */
+#define MOTOR_TRACK_DEFAULT_BRAKE   3.0f    /**< 减速度上限 */
+#define MOTOR_TRACK_DEFAULT_LOOK_S  0.05f   /**< 查表前视时间 (速度环滞后) */
+#define MOTOR_TRACK_PLAN_BUDGET     64U     /**< 每个控制节拍规划的段数 */
+
 /* ========================================================================== */
 /*                              数据结构定义                                  */
 /* ========================================================================== */
@@ -58,6 +107,79 @@ typedef struct {
     int8_t current_dir_b;       /**< 电机B当前方向 (-1:后退, 0:停止, 1:前进) */
 } motor_app_status_t;
 
+/**
+ * @brief 速度闭环状态
+ */
+typedef struct {
+    bool active;                /**< 闭环是否运行 */
+    int32_t target_left;        /**< 左轮目标速度 (归一化计数/秒) */
+    int32_t target_right;       /**< 右轮目标速度 (归一化计数/秒) */
+    int32_t speed_left;         /**< 左轮测量速度 (归一化计数/秒，M/T法) */
+    int32_t speed_right;        /**< 右轮测量速度 (归一化计数/秒，M/T法) */
+    int16_t output_left;        /**< 左轮控制输出 (Q15占空比，带符号) */
+    int16_t output_right;       /**< 右轮控制输出 (Q15占空比，带符号) */
+} motor_speed_status_t;
+
+/**
+ * @brief 速度闭环执行时间与抖动统计 (DWT周期)
+ * @note CPU占用 ≈ exec_cycles_max / nominal_cycles
+ */
+typedef struct {
+    uint32_t ticks;             /**< 控制周期执行次数 */
+    uint32_t nominal_cycles;    /**< 标称控制周期 */
+    uint32_t exec_cycles_last;  /**< 最近一次执行耗时 */
+    uint32_t exec_cycles_max;   /**< 最大执行耗时 */
+    uint32_t period_cycles_min; /**< 相邻两次进入中断的最小间隔 */
+    uint32_t period_cycles_max; /**< 相邻两次进入中断的最大间隔 */
+    uint32_t jitter_cycles_max; /**< 间隔与标称周期的最大偏差 */
+} motor_speed_stats_t;
+
+/**
+ * @brief 指令租约统计
+ * @note 用margin_min_ms与租约时长比较可评估链路抖动余量
+ */
+typedef struct {
+    bool failsafe;              /**< 当前是否处于租约到期后的失效保护 (减速或已制动) */
+    uint32_t lease_ms;          /**< 当前租约时长 (ms)，0表示不启用 */
+    uint32_t renewals;          /**< 续约(收到运动指令)次数 */
+    uint32_t expiries;          /**< 租约到期次数 */
+    uint32_t margin_min_ms;     /**< 续约时租约剩余时间的最小值 (ms)，尚无续约时为UINT32_MAX */
+    uint32_t reaction_ms_last;  /**< 最近一次从到期到两轮制动的时间 (ms) */
+    uint32_t reaction_ms_max;   /**< 从到期到两轮制动的最大时间 (ms) */
+} motor_lease_stats_t;
+
+/**
+ * @brief 执行映射自标定结果 (下标0为左轮/电机A，1为右轮/电机B)
+ */
+typedef struct {
+    bool fitted[2];             /**< 是否拟合成功并已应用 */
+    uint16_t breakaway[2];      /**< 起转占空比 (Q15) */
+    uint16_t coulomb[2];        /**< 动摩擦占空比 (Q15)，即非零指令的最小输出 */
+    int32_t full_cps[2];        /**< 最大扫描占空比下的稳态速度 (归一化计数/秒) */
+} motor_act_report_t;
+
+/**
+ * @brief 巡线运行统计
+ * @note 计圈以路口为标记: 第一个路口(起终点线)开始计时，之后每junctions_per_lap个路口记一圈
+ */
+typedef struct {
+    bool active;                /**< 巡线是否运行 */
+    uint8_t mode;               /**< 当前状态 (line_follow_mode_t) */
+    int8_t position;            /**< 最近一次线位置 */
+    uint32_t cycles;            /**< 巡线更新次数 */
+    uint32_t exec_cycles_last;  /**< 最近一次巡线更新耗时 (DWT周期，含读数和解码) */
+    uint32_t exec_cycles_max;   /**< 巡线更新最大耗时 */
+    uint32_t stale_readings;    /**< 读数序号未更新的周期数 (采集停止或过慢) */
+    uint32_t junctions;         /**< 经过的路口数 */
+    uint32_t losses;            /**< 跟线中丢线的次数 */
+    uint32_t laps;              /**< 完成的圈数 */
+    uint32_t lap_ms_last;       /**< 最近一圈用时 (ms) */
+    uint32_t lap_ms_best;       /**< 最快一圈用时 (ms)，尚无完整一圈时为0 */
+    uint8_t track_state;        /**< 赛道记忆状态 (track_map_state_t)，未启用时为IDLE */
+    uint32_t track_bins;        /**< 已记录的分段数 */
+    uint32_t track_plan_ms;     /**< 按规划速度估计的圈速 (ms)，READY后有效 */
+} motor_line_stats_t;
+
 /* ========================================================================== */
 /*                              应用层API接口                                 */
 /* ========================================================================== */
@@ -68,7 +190,8 @@ typedef struct {
  * @retval 0 初始化成功
  * @retval -1 初始化失败
  * 
- * @note 此函数会初始化TB6612FNG驱动层和端口层
+ * @note 此函数会初始化TB6612FNG驱动层和端口层，并启动编码器测速、
+ *       里程计(odometry.h)和1kHz控制节拍；速度闭环默认不驱动电机
  */
 int32_t motor_app_init(void);
 
@@ -111,10 +234,25 @@ int32_t motor_app_get_status(motor_app_status_t *status);
  * @retval -1 控制失败
  * 
  * @note 正值表示前进，负值表示后退，0表示停止
- *       函数会自动处理方向转换和速度设置
+ *       函数会自动处理方向转换和速度设置；占空比按运动规划限值
+ *       (motor_app_set_profile_limits)在控制节拍中逐步变化到目标，
+ *       前进/后退/转向接口同样经过运动规划
  */
 int32_t motor_app_control_motors(const motor_control_t *control);
 
+/**
+ * @brief 以Q15占空比控制双电机
+ * @param left_duty 左轮占空比 (-32767 到 +32767，32767对应100%)
+ * @param right_duty 右轮占空比 (-32767 到 +32767)
+ * @return int32_t 错误码
+ * @retval 0 控制成功
+ * @retval -1 控制失败（参数无效或未初始化）
+ *
+ * @note 正值表示前进，负值表示后退，0表示停止；分辨率为PWM周期计数，
+ *       不经过百分比量化，也不经过运动规划。属于开环接口，调用后退出速度闭环
+ */
+int32_t motor_app_control_motors_raw(int16_t left_duty, int16_t right_duty);
+
 /* ========================================================================== */
 /*                              2轮驱动运动控制接口                          */
 /* ========================================================================== */
@@ -160,9 +298,212 @@ int32_t motor_app_turn_right(uint16_t speed);
  * @return int32_t 错误码
  * @retval 0 停止成功
  * @retval -1 停止失败
+ *
+ * @note 立即停止，不经过运动规划
  */
 int32_t motor_app_stop_all(void);
 
+/**
+ * @brief 设置开环指令的运动规划限值
+ * @param accel 占空比最大变化率 (Q15/秒)，0表示不限制 (直接阶跃)
+ * @param jerk 变化率的最大变化率 (Q15/秒²)，0表示梯形规划
+ * @return int32_t 0: 成功, -1: 未初始化
+ * @note 规划进行中修改时从当前占空比按新限值重新规划
+ */
+int32_t motor_app_set_profile_limits(uint32_t accel, uint32_t jerk);
+
+/**
+ * @brief 获取当前开环指令到达目标的剩余时间
+ * @return uint32_t 两轮中较大的剩余时间 (毫秒)，已到达或未在规划时为0
+ * @note 上层可据此提前下发下一条指令，实现指令流水
+ */
+uint32_t motor_app_get_profile_eta_ms(void);
+
+/* ========================================================================== */
+/*                              指令租约接口                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 设置运动指令的租约时长
+ * @param lease_ms 每条运动指令的有效期 (ms)，0表示指令一直有效
+ * @return int32_t 0: 成功, -1: 未初始化
+ * @note 之后的每条运动指令(开环、Q15、速度闭环、(v, ω))都会把租约续到lease_ms后；
+ *       到期时控制节拍按运动规划限值把两轮减速到0并短路制动，无需主循环轮询。
+ *       失效保护后下一条运动指令即恢复正常；motor_app_stop_all()结束租约
+ */
+int32_t motor_app_set_command_lease(uint32_t lease_ms);
+
+/**
+ * @brief 获取指令租约统计
+ * @param stats 输出统计
+ * @return int32_t 0: 成功, -1: 参数无效
+ */
+int32_t motor_app_get_lease_stats(motor_lease_stats_t *stats);
+
+/**
+ * @brief 清零指令租约统计 (到期次数、续约余量、反应时间)
+ */
+void motor_app_reset_lease_stats(void);
+
+/* ========================================================================== */
+/*                              执行映射接口                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 启用或关闭执行映射
+ * @param enable true: 速度闭环和运动规划的输出经过映射后下发; false: 直接下发
+ * @return int32_t 0: 成功, -1: 未初始化
+ * @note 初始化后默认启用，映射按tb6612配置的min/max_duty_cycle生成 (无静摩擦附加量)；
+ *       motor_app_control_motors_raw()始终不经过映射
+ */
+int32_t motor_app_set_actuation_enabled(bool enable);
+
+/**
+ * @brief 提供电机电源电压，用于电压补偿
+ * @param supply_mv 电机电源电压 (mV)，0表示关闭补偿
+ * @return int32_t 0: 成功, -1: 未初始化
+ * @note 输出按MOTOR_ACT_NOMINAL_MV / supply_mv等比放大，可在主循环中周期调用
+ */
+int32_t motor_app_set_supply_voltage(uint32_t supply_mv);
+
+/**
+ * @brief 扫描占空比并拟合两轮的执行映射 (阻塞)
+ * @param report 输出标定结果，可为NULL
+ * @return int32_t 0: 两轮都拟合成功, -1: 未初始化或有车轮拟合失败 (该轮映射不变)
+ * @warning 车轮须离地。两轮以MOTOR_ACT_CAL_STEPS级占空比同时正转，
+ *          耗时约(MOTOR_ACT_CAL_STEPS+1)×(MOTOR_ACT_CAL_SETTLE_MS+MOTOR_ACT_CAL_SAMPLE_MS)，结束后停止
+ * @note 只扫描正转，反转使用同一映射
+ */
+int32_t motor_app_characterize(motor_act_report_t *report);
+
+/* ========================================================================== */
+/*                              速度闭环接口                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 设置左右轮目标速度并进入闭环控制
+ * @param left_cps 左轮目标速度 (归一化计数/秒，4096/转)，正值前进
+ * @param right_cps 右轮目标速度 (归一化计数/秒，4096/转)，正值前进
+ * @return int32_t 错误码
+ * @retval 0 设置成功
+ * @retval -1 未初始化、参数超出±MOTOR_SPEED_MAX_CPS或控制节拍启动失败
+ *
+ * @note 首次调用时进入闭环；之后只更新目标值，可在主循环中频繁调用。
+ *       调用任何开环接口(motor_app_control_motors、前进/转向、停止)会退出闭环
+ */
+int32_t motor_app_set_wheel_velocity(int32_t left_cps, int32_t right_cps);
+
+/**
+ * @brief 以米/秒设置左右轮目标速度
+ * @param left_mps 左轮目标线速度 (m/s)
+ * @param right_mps 右轮目标线速度 (m/s)
+ * @return int32_t 错误码，同motor_app_set_wheel_velocity()
+ * @note 按stm32f407_port_config.h中的轮径换算 (wheel_enc_m_per_count())
+ */
+int32_t motor_app_set_wheel_velocity_mps(float left_mps, float right_mps);
+
+/**
+ * @brief 以线速度和角速度驱动底盘 (速度闭环)
+ * @param v_mps 线速度 (m/s)，正值前进
+ * @param omega_rps 角速度 (rad/s)，逆时针(左转)为正
+ * @return int32_t 错误码
+ * @retval 0 设置成功
+ * @retval -1 未初始化或参数不是有限值
+ *
+ * @note 按轮距换算为左右轮目标速度: v∓ω·b/2。任一轮超出±MOTOR_SPEED_MAX_CPS时
+ *       两轮按同一比例缩小，保持转弯曲率(ω/v)不变，而不是各自限幅；
+ *       换算系数在初始化时预先算好，可在控制循环中每周期调用
+ */
+int32_t motor_app_set_body_velocity(float v_mps, float omega_rps);
+
+/**
+ * @brief 设置速度闭环PID增益 (两轮相同)
+ * @param kp_q16 比例增益 (Q16)
+ * @param ki_q16 积分增益 (Q16)
+ * @param kd_q16 微分增益 (Q16)
+ * @return int32_t 0: 成功, -1: 参数无效
+ * @note 闭环运行中修改会清除积分
+ */
+int32_t motor_app_set_speed_gains(int32_t kp_q16, int32_t ki_q16, int32_t kd_q16);
+
+/**
+ * @brief 获取速度闭环状态
+ * @param status 输出状态
+ * @return int32_t 0: 成功, -1: 参数无效或未初始化
+ */
+int32_t motor_app_get_speed_status(motor_speed_status_t *status);
+
+/**
+ * @brief 获取速度闭环执行时间与抖动统计
+ * @param stats 输出统计
+ * @return int32_t 0: 成功, -1: 参数无效
+ */
+int32_t motor_app_get_speed_stats(motor_speed_stats_t *stats);
+
+/**
+ * @brief 清零速度闭环统计 (在下一个控制周期生效)
+ */
+void motor_app_reset_speed_stats(void);
+
+/* ========================================================================== */
+/*                              巡线接口                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 启动巡线
+ * @param config 巡线配置，NULL表示使用MOTOR_LINE_DEFAULT_*
+ * @param junctions_per_lap 每圈经过的路口数(含起终点线)，0表示不自动计圈
+ * @return int32_t 错误码
+ * @retval 0 启动成功
+ * @retval -1 未初始化或配置无效
+ * @retval -2 循迹DMA采集启动失败
+ *
+ * @note 启动循迹DMA采集并进入速度闭环，之后每个控制节拍由巡线控制器给出两轮目标速度；
+ *       巡线是自主运行，启动时结束指令租约。调用任何运动接口或停止接口即退出巡线
+ */
+int32_t motor_app_start_line_follow(const line_follow_config_t *config, uint32_t junctions_per_lap);
+
+/**
+ * @brief 停止巡线并停车
+ * @return int32_t 同motor_app_stop_all()
+ */
+int32_t motor_app_stop_line_follow(void);
+
+/**
+ * @brief 获取巡线统计
+ * @param stats 输出统计
+ * @return int32_t 0: 成功, -1: 参数无效
+ */
+int32_t motor_app_get_line_stats(motor_line_stats_t *stats);
+
+/**
+ * @brief 清零巡线统计 (耗时、丢线、计圈，在下一个控制周期生效)
+ */
+void motor_app_reset_line_stats(void);
+
+/**
+ * @brief 启用赛道记忆 (清空已有记录)
+ * @param config 记录与规划配置，NULL表示使用MOTOR_TRACK_DEFAULT_*
+ * @return int32_t 0: 成功, -1: 未初始化或配置无效
+ *
+ * @note 以计圈的起终点路口为标记: 第一圈沿路程记录曲率，到达终点后在之后的控制节拍中
+ *       分批规划速度曲线；之后每圈按路程查表设置巡线的直道基础速度(转向仍由PD完成)。
+ *       需要motor_app_start_line_follow()的junctions_per_lap不为0。
+ *       记录在停止/重新启动巡线后保留，下次经过起终点线时重新对齐路程
+ */
+int32_t motor_app_enable_track_learning(const track_map_config_t *config);
+
+/**
+ * @brief 停用赛道记忆，恢复巡线配置的直道基础速度 (保留已有记录)
+ */
+void motor_app_disable_track_learning(void);
+
+/**
+ * @brief 获取赛道表 (只读，用于打印分段表供tools/track_replay.c回放)
+ * @return const track_map_t* 赛道表，状态为READY时内容不再变化
+ */
+const track_map_t *motor_app_get_track_map(void);
+
 /* ========================================================================== */
 /*                              基础测试接口                                  */
 /* ========================================================================== */
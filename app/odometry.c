@@ -0,0 +1,243 @@
+/**
+ * @file odometry.c
+ * @brief 差速底盘里程计实现
+ * @date 2026-10-16
+ */
+
+#include <math.h>
+#include <string.h>
+#include "cmsis_compiler.h"
+#include "odometry.h"
+#include "wheel_encoder.h"
+
+extern uint32_t tick_port_cycles(void);
+extern uint32_t tick_port_cycles_per_us(void);
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+#define ODOM_PI                     3.14159265358979f
+#define ODOM_DEG_TO_RAD             (ODOM_PI / 180.0f)
+
+/* ========================================================================== */
+/*                              私有变量                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 积分状态 (仅控制节拍中断访问)
+ */
+typedef struct {
+    float x;
+    float y;
+    float theta;
+    float c;                        /* cos(theta) */
+    float s;                        /* sin(theta) */
+    float distance;
+    int64_t last_pos[WHEEL_ENC_NUM];/* 上一周期的归一化位置 */
+    uint8_t has_last;
+    float dt;                       /* 控制周期 (s) */
+    float m_per_count;              /* 每归一化计数的行程 (m) */
+    float inv_wheel_base;           /* 1 / 轮距 */
+    float gyro_weight;              /* 陀螺航向权重 */
+    uint32_t gyro_timeout_cycles;   /* 陀螺超时 (CPU周期) */
+} odom_state_t;
+
+static odom_state_t s_odom;
+
+/* 陀螺输入 (IMU中断写入，两字段分别为32位原子写) */
+static volatile float s_gyro_z_rad = 0.0f;
+static volatile uint32_t s_gyro_cycles = 0;
+static volatile uint8_t s_gyro_seen = 0;
+
+/* 复位请求 (主循环写入，控制节拍中应用) */
+static volatile uint8_t s_reset_pending = 0;
+static float s_reset_pose[3];
+
+/* 位姿快照 */
+static volatile uint32_t s_pose_seq = 0;
+static odometry_pose_t s_pose;
+
+/* ========================================================================== */
+/*                              私有函数声明                                  */
+/* ========================================================================== */
+
+static void odom_set_heading(float theta);
+static void odom_rotate(float *c, float *s, float angle);
+
+/* ========================================================================== */
+/*                              公共函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化里程计
+ */
+int32_t odometry_init(uint32_t rate_hz, float gyro_weight)
+{
+    float wheel_base = wheel_enc_wheel_base();
+
+    /* 参数检查 */
+    if (rate_hz == 0 || !(gyro_weight >= 0.0f && gyro_weight <= 1.0f) || !(wheel_base > 0.0f)) {
+        return -1;
+    }
+
+    memset(&s_odom, 0, sizeof(s_odom));
+    memset(&s_pose, 0, sizeof(s_pose));
+    odom_set_heading(0.0f);
+
+    s_odom.dt = 1.0f / (float)rate_hz;
+    s_odom.m_per_count = wheel_enc_m_per_count();
+    s_odom.inv_wheel_base = 1.0f / wheel_base;
+    s_odom.gyro_weight = gyro_weight;
+    s_odom.gyro_timeout_cycles = tick_port_cycles_per_us() * 1000UL * ODOM_GYRO_TIMEOUT_MS;
+    s_reset_pending = 0;
+
+    return 0;
+}
+
+/**
+ * @brief 请求把位姿设为给定值
+ */
+void odometry_reset(float x, float y, float theta)
+{
+    s_reset_pose[0] = x;
+    s_reset_pose[1] = y;
+    s_reset_pose[2] = theta;
+    __COMPILER_BARRIER();
+    s_reset_pending = 1;
+}
+
+/**
+ * @brief 提供最新的陀螺仪Z轴角速度
+ */
+void odometry_feed_gyro_z(float gyro_z_dps)
+{
+    s_gyro_z_rad = gyro_z_dps * ODOM_DEG_TO_RAD;
+    s_gyro_cycles = tick_port_cycles();
+    s_gyro_seen = 1;
+}
+
+/**
+ * @brief 积分一个控制周期
+ * @note 中点法: 先转半个航向增量再沿该方向前进，最后转完剩余半个增量
+ */
+void odometry_update(void)
+{
+    wheel_enc_snapshot_t enc;
+    float d_left, d_right, ds, dtheta_enc, dtheta;
+    uint32_t now = tick_port_cycles();
+    uint8_t gyro_valid;
+    uint8_t i;
+
+    wheel_enc_get(&enc);
+
+    if (s_reset_pending) {
+        s_odom.x = s_reset_pose[0];
+        s_odom.y = s_reset_pose[1];
+        odom_set_heading(s_reset_pose[2]);
+        s_odom.distance = 0.0f;
+        s_reset_pending = 0;
+    }
+
+    if (!s_odom.has_last) {
+        for (i = 0; i < WHEEL_ENC_NUM; i++) {
+            s_odom.last_pos[i] = enc.wheel[i].position;
+        }
+        s_odom.has_last = 1;
+    }
+
+    d_left = (float)(enc.wheel[WHEEL_ENC_LEFT].position - s_odom.last_pos[WHEEL_ENC_LEFT]) * s_odom.m_per_count;
+    d_right = (float)(enc.wheel[WHEEL_ENC_RIGHT].position - s_odom.last_pos[WHEEL_ENC_RIGHT]) * s_odom.m_per_count;
+    s_odom.last_pos[WHEEL_ENC_LEFT] = enc.wheel[WHEEL_ENC_LEFT].position;
+    s_odom.last_pos[WHEEL_ENC_RIGHT] = enc.wheel[WHEEL_ENC_RIGHT].position;
+
+    ds = 0.5f * (d_left + d_right);
+    dtheta_enc = (d_right - d_left) * s_odom.inv_wheel_base;
+
+    /* 航向互补融合，陀螺超时则仅用编码器 */
+    gyro_valid = s_gyro_seen && (uint32_t)(now - s_gyro_cycles) < s_odom.gyro_timeout_cycles;
+    if (gyro_valid) {
+        dtheta = s_odom.gyro_weight * (s_gyro_z_rad * s_odom.dt) + (1.0f - s_odom.gyro_weight) * dtheta_enc;
+    } else {
+        dtheta = dtheta_enc;
+    }
+
+    odom_rotate(&s_odom.c, &s_odom.s, 0.5f * dtheta);
+    s_odom.x += ds * s_odom.c;
+    s_odom.y += ds * s_odom.s;
+    odom_rotate(&s_odom.c, &s_odom.s, 0.5f * dtheta);
+
+    s_odom.theta += dtheta;
+    if (s_odom.theta > ODOM_PI) {
+        s_odom.theta -= 2.0f * ODOM_PI;
+    } else if (s_odom.theta <= -ODOM_PI) {
+        s_odom.theta += 2.0f * ODOM_PI;
+    }
+    s_odom.distance += fabsf(ds);
+
+    /* 发布快照，速度由编码器M/T速度和融合角速度得到 */
+    s_pose_seq++;
+    __COMPILER_BARRIER();
+    s_pose.x = s_odom.x;
+    s_pose.y = s_odom.y;
+    s_pose.theta = s_odom.theta;
+    s_pose.v = 0.5f * (float)(enc.wheel[WHEEL_ENC_LEFT].velocity + enc.wheel[WHEEL_ENC_RIGHT].velocity) * s_odom.m_per_count;
+    s_pose.omega = dtheta / s_odom.dt;
+    s_pose.distance = s_odom.distance;
+    s_pose.timestamp = now;
+    s_pose.updates++;
+    s_pose.gyro_valid = gyro_valid;
+    __COMPILER_BARRIER();
+    s_pose_seq++;
+}
+
+/**
+ * @brief 获取一致的位姿快照
+ */
+void odometry_get(odometry_pose_t *pose)
+{
+    uint32_t seq;
+
+    if (pose == NULL) {
+        return;
+    }
+
+    do {
+        seq = s_pose_seq;
+        __COMPILER_BARRIER();
+        *pose = s_pose;
+        __COMPILER_BARRIER();
+    } while ((seq & 1U) != 0U || seq != s_pose_seq);
+}
+
+/* ========================================================================== */
+/*                              私有函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 设置航向角和对应的单位向量 (仅初始化/复位时调用三角函数)
+ */
+static void odom_set_heading(float theta)
+{
+    s_odom.theta = theta;
+    s_odom.c = cosf(theta);
+    s_odom.s = sinf(theta);
+}
+
+/**
+ * @brief 将单位向量旋转一个小角度并归一化
+ * @note 每周期角度很小 (1kHz下远小于0.1rad)，用三阶泰勒展开即可，
+ *       归一化消除多项式截断误差的累积
+ */
+static void odom_rotate(float *c, float *s, float angle)
+{
+    float a2 = angle * angle;
+    float ca = 1.0f - 0.5f * a2;
+    float sa = angle * (1.0f - a2 * (1.0f / 6.0f));
+    float nc = *c * ca - *s * sa;
+    float ns = *s * ca + *c * sa;
+    float inv = 1.0f / sqrtf(nc * nc + ns * ns);
+
+    *c = nc * inv;
+    *s = ns * inv;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file odometry.h
+ * @brief 差速底盘里程计 (编码器 + 陀螺仪航向融合)
+ * @details 在控制节拍中按固定频率积分位姿:
+ *          - 行程: 左右轮归一化位置增量换算为米，取平均
+ *          - 航向: 陀螺仪Z轴角速度与编码器差速航向按权重互补融合，
+ *            陀螺数据超时(ODOM_GYRO_TIMEOUT_MS)时仅使用编码器
+ *          航向以单位向量(cos, sin)保存，每次按半角多项式旋转并归一化，
+ *          不调用三角函数，单次更新耗时固定。
+ * @date 2026-10-16
+ *
+ * @note 写入者: 控制节拍中断(odometry_update)、IMU完成中断(odometry_feed_gyro_z);
+ *       读取者: 任意上下文通过odometry_get()获取顺序锁快照
+ */
+
+#ifndef ODOMETRY_H__
+#define ODOMETRY_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/*                              配置参数                                      */
+/* ========================================================================== */
+
+#define ODOM_DEFAULT_GYRO_WEIGHT    0.98f   /**< 默认陀螺航向权重 (0: 仅编码器, 1: 仅陀螺) */
+#define ODOM_GYRO_TIMEOUT_MS        50U     /**< 陀螺数据超时 */
+
+/* ========================================================================== */
+/*                              数据结构定义                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 位姿与速度
+ */
+typedef struct {
+    float x;                /**< X位置 (m)，初始航向方向 */
+    float y;                /**< Y位置 (m)，初始航向左侧 */
+    float theta;            /**< 航向 (rad)，(-π, π]，逆时针为正 */
+    float v;                /**< 线速度 (m/s) */
+    float omega;            /**< 角速度 (rad/s)，融合后 */
+    float distance;         /**< 累计行驶路程 (m)，后退也计入 */
+    uint32_t timestamp;     /**< 更新时刻的CPU周期计数 */
+    uint32_t updates;       /**< 更新次数 */
+    uint8_t gyro_valid;     /**< 本次更新是否使用了陀螺数据 */
+} odometry_pose_t;
+
+/* ========================================================================== */
+/*                              API接口                                       */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化里程计，位姿清零
+ * @param rate_hz odometry_update()的调用频率 (Hz)
+ * @param gyro_weight 陀螺航向权重，范围: [0, 1]
+ * @return int32_t 0: 成功, -1: 参数无效
+ * @note 需在wheel_enc_init()之后调用 (使用其车轮几何参数)
+ */
+int32_t odometry_init(uint32_t rate_hz, float gyro_weight);
+
+/**
+ * @brief 请求把位姿设为给定值 (在下一次更新时生效)
+ * @param x X位置 (m)
+ * @param y Y位置 (m)
+ * @param theta 航向 (rad)
+ */
+void odometry_reset(float x, float y, float theta);
+
+/**
+ * @brief 提供最新的陀螺仪Z轴角速度
+ * @param gyro_z_dps Z轴角速度 (°/s)，逆时针为正
+ * @note 可在IMU采样中断中调用
+ */
+void odometry_feed_gyro_z(float gyro_z_dps);
+
+/**
+ * @brief 积分一个控制周期
+ * @note 在控制节拍中断中、wheel_enc_update()之后调用
+ */
+void odometry_update(void);
+
+/**
+ * @brief 获取一致的位姿快照
+ * @param pose 输出位姿
+ */
+void odometry_get(odometry_pose_t *pose);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ODOMETRY_H__ */
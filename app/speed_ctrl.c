@@ -0,0 +1,107 @@
+/**
+ * @file speed_ctrl.c
+ * @brief 车轮速度定点PID控制器与滑动窗口测速实现
+ * @date 2026-10-16
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "speed_ctrl.h"
+
+/* ========================================================================== */
+/*                              公共函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化PID实例
+ */
+int32_t speed_ctrl_pid_init(speed_ctrl_pid_t *pid, const speed_ctrl_config_t *config)
+{
+    /* 参数检查 */
+    if (pid == NULL || config == NULL || config->rate_hz == 0 || config->out_min >= config->out_max) {
+        return -1;
+    }
+
+    pid->cfg = *config;
+    speed_ctrl_pid_reset(pid);
+
+    return 0;
+}
+
+/**
+ * @brief 清除积分和微分历史
+ */
+void speed_ctrl_pid_reset(speed_ctrl_pid_t *pid)
+{
+    pid->integ_q16 = 0;
+    pid->prev_meas = 0;
+    pid->output = 0;
+    pid->saturated = 0;
+}
+
+/**
+ * @brief 执行一次PID计算
+ */
+int32_t speed_ctrl_pid_update(speed_ctrl_pid_t *pid, int32_t setpoint, int32_t measured)
+{
+    const speed_ctrl_config_t *cfg = &pid->cfg;
+    int64_t min_q16 = (int64_t)cfg->out_min * SPEED_CTRL_Q16_ONE;
+    int64_t max_q16 = (int64_t)cfg->out_max * SPEED_CTRL_Q16_ONE;
+    int32_t err = setpoint - measured;
+    int64_t p_q16;
+    int64_t d_q16;
+    int64_t integ_q16;
+    int64_t u_q16;
+
+    p_q16 = (int64_t)cfg->kp_q16 * err;
+    d_q16 = -(int64_t)cfg->kd_q16 * (measured - pid->prev_meas) * (int64_t)cfg->rate_hz;
+    pid->prev_meas = measured;
+
+    /* 候选积分项，限制在输出范围内 */
+    integ_q16 = pid->integ_q16 + ((int64_t)cfg->ki_q16 * err) / (int64_t)cfg->rate_hz;
+    if (integ_q16 > max_q16) {
+        integ_q16 = max_q16;
+    } else if (integ_q16 < min_q16) {
+        integ_q16 = min_q16;
+    }
+
+    u_q16 = p_q16 + integ_q16 + d_q16;
+    pid->saturated = 1;
+    if (u_q16 > max_q16) {
+        u_q16 = max_q16;
+        if (err < 0) {
+            pid->integ_q16 = integ_q16;     /* 误差在退出饱和，允许积分 */
+        }
+    } else if (u_q16 < min_q16) {
+        u_q16 = min_q16;
+        if (err > 0) {
+            pid->integ_q16 = integ_q16;
+        }
+    } else {
+        pid->integ_q16 = integ_q16;
+        pid->saturated = 0;
+    }
+
+    pid->output = (int32_t)(u_q16 / SPEED_CTRL_Q16_ONE);
+    return pid->output;
+}
+
+/**
+ * @brief 清空测速窗口
+ */
+void speed_ctrl_vel_reset(speed_ctrl_vel_t *vel)
+{
+    memset(vel, 0, sizeof(*vel));
+}
+
+/**
+ * @brief 加入一个周期的计数增量并返回窗口平均速度
+ */
+int32_t speed_ctrl_vel_update(speed_ctrl_vel_t *vel, int32_t delta, uint32_t rate_hz)
+{
+    vel->sum += delta - vel->hist[vel->idx];
+    vel->hist[vel->idx] = delta;
+    vel->idx = (uint8_t)((vel->idx + 1U) % SPEED_CTRL_VEL_WINDOW);
+
+    return (int32_t)(((int64_t)vel->sum * (int64_t)rate_hz) / (int32_t)SPEED_CTRL_VEL_WINDOW);
+}
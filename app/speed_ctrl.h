@@ -0,0 +1,123 @@
+/**
+ * @file speed_ctrl.h
+ * @brief 车轮速度定点PID控制器与滑动窗口测速
+ * @details 纯整数运算，适合在1kHz控制节拍中断中执行。增益为Q16定点数，
+ *          速度单位为编码器计数/秒，输出为带符号占空比，量纲由out_min/out_max决定
+ *          (电机应用中为Q15，±32767对应±100%)。
+ * @date 2026-10-16
+ *
+ * @note 每个车轮使用独立的控制器和测速实例，实例之间无共享状态
+ */
+
+#ifndef SPEED_CTRL_H__
+#define SPEED_CTRL_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/*                              配置参数                                      */
+/* ========================================================================== */
+
+#define SPEED_CTRL_Q16_ONE          65536L  /**< Q16定点数的1.0 */
+
+/**
+ * @brief 测速滑动窗口长度 (控制周期数)
+ * @note 1kHz下8个周期的速度分辨率为125计数/秒
+ */
+#ifndef SPEED_CTRL_VEL_WINDOW
+#define SPEED_CTRL_VEL_WINDOW       8U
+#endif
+
+/* ========================================================================== */
+/*                              数据结构定义                                  */
+/* ========================================================================== */
+
+/**
+ * @brief PID配置
+ * @note 增益均为Q16，单位以输出占空比和计数/秒为基准:
+ *       - kp: 输出 / (计数/秒)
+ *       - ki: 输出 / 计数 (误差对时间的积分)
+ *       - kd: 输出 / (计数/秒²)，微分作用于测量值，避免设定值阶跃冲击
+ */
+typedef struct {
+    int32_t kp_q16;             /**< 比例增益 (Q16) */
+    int32_t ki_q16;             /**< 积分增益 (Q16) */
+    int32_t kd_q16;             /**< 微分增益 (Q16)，0表示PI控制 */
+    int32_t out_min;            /**< 输出下限 */
+    int32_t out_max;            /**< 输出上限 */
+    uint32_t rate_hz;           /**< 控制频率 (Hz) */
+} speed_ctrl_config_t;
+
+/**
+ * @brief PID实例
+ */
+typedef struct {
+    speed_ctrl_config_t cfg;    /**< 配置 */
+    int64_t integ_q16;          /**< 积分项 (Q16输出单位)，限制在输出范围内 */
+    int32_t prev_meas;          /**< 上一周期测量值 (微分用) */
+    int32_t output;             /**< 最近一次输出 */
+    uint8_t saturated;          /**< 最近一次输出是否饱和 */
+} speed_ctrl_pid_t;
+
+/**
+ * @brief 滑动窗口测速实例
+ */
+typedef struct {
+    int32_t hist[SPEED_CTRL_VEL_WINDOW];    /**< 最近各周期的计数增量 */
+    int32_t sum;                            /**< 窗口内增量之和 */
+    uint8_t idx;                            /**< 下一个写入位置 */
+} speed_ctrl_vel_t;
+
+/* ========================================================================== */
+/*                              API接口                                       */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化PID实例
+ * @param pid PID实例
+ * @param config 配置
+ * @return int32_t 0: 成功, -1: 参数无效
+ */
+int32_t speed_ctrl_pid_init(speed_ctrl_pid_t *pid, const speed_ctrl_config_t *config);
+
+/**
+ * @brief 清除积分和微分历史
+ * @param pid PID实例
+ */
+void speed_ctrl_pid_reset(speed_ctrl_pid_t *pid);
+
+/**
+ * @brief 执行一次PID计算
+ * @param pid PID实例
+ * @param setpoint 目标速度 (计数/秒)
+ * @param measured 测量速度 (计数/秒)
+ * @return int32_t 输出，已限制在[out_min, out_max]
+ * @note 抗积分饱和: 输出饱和且误差继续推向饱和方向时本周期不累加积分，
+ *       积分项本身也被限制在输出范围内
+ */
+int32_t speed_ctrl_pid_update(speed_ctrl_pid_t *pid, int32_t setpoint, int32_t measured);
+
+/**
+ * @brief 清空测速窗口
+ * @param vel 测速实例
+ */
+void speed_ctrl_vel_reset(speed_ctrl_vel_t *vel);
+
+/**
+ * @brief 加入一个周期的计数增量并返回窗口平均速度
+ * @param vel 测速实例
+ * @param delta 本周期计数增量
+ * @param rate_hz 控制频率 (Hz)
+ * @return int32_t 速度 (计数/秒)
+ */
+int32_t speed_ctrl_vel_update(speed_ctrl_vel_t *vel, int32_t delta, uint32_t rate_hz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPEED_CTRL_H__ */
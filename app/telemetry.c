@@ -0,0 +1,212 @@
+/**
+ * @file telemetry.c
+ * @brief 二进制遥测帧实现
+ * @details 帧在栈上组装、计算CRC并COBS编码后，整帧放入端口层发送缓冲由中断发出，
+ *          避免printf逐字节阻塞发送和浮点格式化开销。
+ * @date 2026-10-16
+ */
+
+#include <string.h>
+#include "telemetry.h"
+
+/* 端口层接口声明 - 由具体端口层实现 */
+extern int32_t wit_port_uart_write_async(const uint8_t *p_ucData, uint32_t uiLen);
+extern void wit_port_uart_text_enable(uint8_t enable);
+extern uint32_t tick_port_cycles(void);
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+#define TELEMETRY_HEADER_LEN    7U      /* type + seq + timestamp */
+#define TELEMETRY_CRC_LEN       2U
+#define TELEMETRY_RAW_MAX       (TELEMETRY_HEADER_LEN + TELEMETRY_MAX_PAYLOAD + TELEMETRY_CRC_LEN)
+/* COBS最坏情况每254字节增加1字节开销，另加1字节首码和1字节分隔符 */
+#define TELEMETRY_ENC_MAX       (TELEMETRY_RAW_MAX + (TELEMETRY_RAW_MAX / 254U) + 2U)
+
+/* ========================================================================== */
+/*                              私有变量                                      */
+/* ========================================================================== */
+
+static uint16_t s_tx_seq = 0;   /* 帧序号 */
+
+/* ========================================================================== */
+/*                              私有函数声明                                  */
+/* ========================================================================== */
+
+static uint16_t telemetry_crc16(const uint8_t *data, uint32_t len);
+static uint32_t telemetry_cobs_encode(const uint8_t *src, uint32_t len, uint8_t *dst);
+static void telemetry_put_u16(uint8_t *dst, uint16_t val);
+static void telemetry_put_u32(uint8_t *dst, uint32_t val);
+
+/* ========================================================================== */
+/*                              公共函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 发送任意类型的遥测帧
+ */
+int32_t telemetry_send(uint8_t type, uint32_t timestamp, const uint8_t *payload, uint32_t len)
+{
+    uint8_t raw[TELEMETRY_RAW_MAX];
+    uint8_t enc[TELEMETRY_ENC_MAX];
+    uint32_t raw_len;
+    uint32_t enc_len;
+
+    if (len > TELEMETRY_MAX_PAYLOAD || (payload == NULL && len != 0)) {
+        return -1;
+    }
+
+    raw[0] = type;
+    telemetry_put_u16(&raw[1], s_tx_seq++);
+    telemetry_put_u32(&raw[3], timestamp);
+    if (len != 0) {
+        memcpy(&raw[TELEMETRY_HEADER_LEN], payload, len);
+    }
+    raw_len = TELEMETRY_HEADER_LEN + len;
+    telemetry_put_u16(&raw[raw_len], telemetry_crc16(raw, raw_len));
+    raw_len += TELEMETRY_CRC_LEN;
+
+    enc_len = telemetry_cobs_encode(raw, raw_len, enc);
+    enc[enc_len++] = 0x00;  /* 帧分隔符 */
+
+    /* 缓冲不足时整帧丢弃，序号已递增，主机可据此发现丢帧 */
+    if (wit_port_uart_write_async(enc, enc_len) != 0) {
+        return -2;
+    }
+    return 0;
+}
+
+/**
+ * @brief 进入或退出二进制遥测模式
+ */
+void telemetry_set_binary(uint8_t enable)
+{
+    wit_port_uart_text_enable(enable ? 0U : 1U);
+}
+
+/**
+ * @brief 发送IMU样本帧
+ */
+int32_t telemetry_send_imu(const imu_sample_t *sample)
+{
+    uint8_t payload[IMU_REG_BLOCK_NUM * 2U];
+    uint32_t i;
+
+    if (sample == NULL) {
+        return -1;
+    }
+
+    for (i = 0; i < IMU_REG_BLOCK_NUM; i++) {
+        telemetry_put_u16(&payload[i * 2U], (uint16_t)sample->reg[i]);
+    }
+
+    return telemetry_send(TELEMETRY_TYPE_IMU, sample->timestamp, payload, sizeof(payload));
+}
+
+/**
+ * @brief 发送编码器位置帧
+ */
+int32_t telemetry_send_encoder(const wheel_enc_snapshot_t *snap)
+{
+    uint8_t payload[8];
+
+    if (snap == NULL) {
+        return -1;
+    }
+
+    telemetry_put_u32(&payload[0], (uint32_t)snap->wheel[WHEEL_ENC_LEFT].position);
+    telemetry_put_u32(&payload[4], (uint32_t)snap->wheel[WHEEL_ENC_RIGHT].position);
+
+    return telemetry_send(TELEMETRY_TYPE_ENCODER, snap->timestamp, payload, sizeof(payload));
+}
+
+/**
+ * @brief 发送电机状态帧
+ */
+int32_t telemetry_send_motor(const motor_app_status_t *status)
+{
+    uint8_t payload[4];
+
+    if (status == NULL) {
+        return -1;
+    }
+
+    payload[0] = (uint8_t)status->current_speed_a;
+    payload[1] = (uint8_t)status->current_dir_a;
+    payload[2] = (uint8_t)status->current_speed_b;
+    payload[3] = (uint8_t)status->current_dir_b;
+
+    return telemetry_send(TELEMETRY_TYPE_MOTOR, tick_port_cycles(), payload, sizeof(payload));
+}
+
+/* ========================================================================== */
+/*                              私有函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief CRC-16/CCITT-FALSE
+ */
+static uint16_t telemetry_crc16(const uint8_t *data, uint32_t len)
+{
+    uint16_t crc = 0xFFFF;
+    uint32_t i;
+    uint8_t bit;
+
+    for (i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000U) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief COBS编码
+ * @return uint32_t 编码后长度 (不含分隔符)
+ */
+static uint32_t telemetry_cobs_encode(const uint8_t *src, uint32_t len, uint8_t *dst)
+{
+    uint32_t code_idx = 0;
+    uint32_t out = 1;
+    uint8_t code = 1;
+    uint32_t i;
+
+    for (i = 0; i < len; i++) {
+        if (src[i] == 0x00) {
+            dst[code_idx] = code;
+            code_idx = out++;
+            code = 1;
+        } else {
+            dst[out++] = src[i];
+            if (++code == 0xFF) {
+                dst[code_idx] = code;
+                code_idx = out++;
+                code = 1;
+            }
+        }
+    }
+    dst[code_idx] = code;
+    return out;
+}
+
+/**
+ * @brief 小端写入16位
+ */
+static void telemetry_put_u16(uint8_t *dst, uint16_t val)
+{
+    dst[0] = (uint8_t)(val & 0xFF);
+    dst[1] = (uint8_t)(val >> 8);
+}
+
+/**
+ * @brief 小端写入32位
+ */
+static void telemetry_put_u32(uint8_t *dst, uint32_t val)
+{
+    dst[0] = (uint8_t)(val & 0xFF);
+    dst[1] = (uint8_t)((val >> 8) & 0xFF);
+    dst[2] = (uint8_t)((val >> 16) & 0xFF);
+    dst[3] = (uint8_t)(val >> 24);
+}
@@ -0,0 +1,85 @@
+/**
+ * @file telemetry.h
+ * @brief 二进制遥测帧接口
+ * @details 以紧凑的二进制帧替代printf浮点文本输出，每帧包含类型、序号、
+ *          时间戳和载荷，附CRC16校验后经COBS编码，以0x00作为帧分隔符。
+ *          主机端使用 tools/telemetry_decode.py 解码为可读文本。
+ * @date 2026-10-16
+ *
+ * @note 帧格式 (COBS编码前，多字节字段均为小端):
+ *       | type(1) | seq(2) | timestamp(4) | payload(N) | crc16(2) |
+ *       - seq: 每发送一帧递增，主机可据此检测丢帧
+ *       - timestamp: CPU周期计数 (DWT->CYCCNT)
+ *       - crc16: CRC-16/CCITT-FALSE (多项式0x1021，初值0xFFFF)，覆盖type至payload
+ */
+
+#ifndef TELEMETRY_H__
+#define TELEMETRY_H__
+
+#include <stdint.h>
+#include "imu_sampler.h"
+#include "motor_control_app.h"
+#include "wheel_encoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/*                              帧类型定义                                    */
+/* ========================================================================== */
+
+#define TELEMETRY_TYPE_IMU      0x01    /**< IMU原始样本: acc[3] gyro[3] mag[3] angle[3] (int16) */
+#define TELEMETRY_TYPE_ENCODER  0x02    /**< 编码器位置: left, right (int32，归一化计数) */
+#define TELEMETRY_TYPE_MOTOR    0x03    /**< 电机状态: speed_a(u8) dir_a(i8) speed_b(u8) dir_b(i8) */
+
+#define TELEMETRY_MAX_PAYLOAD   32U     /**< 最大载荷长度 */
+
+/* ========================================================================== */
+/*                              API接口                                       */
+/* ========================================================================== */
+
+/**
+ * @brief 发送IMU样本帧
+ * @param sample IMU样本，时间戳取自样本本身
+ * @return int32_t 0: 成功, -1: 参数无效, -2: 发送缓冲已满，帧被丢弃
+ */
+int32_t telemetry_send_imu(const imu_sample_t *sample);
+
+/**
+ * @brief 发送编码器位置帧
+ * @param snap 两轮状态快照，时间戳取自快照本身
+ * @return int32_t 0: 成功, -1: 参数无效, -2: 发送缓冲已满，帧被丢弃
+ * @note 位置取低32位发送 (约107km回绕一次)，主机按差分使用
+ */
+int32_t telemetry_send_encoder(const wheel_enc_snapshot_t *snap);
+
+/**
+ * @brief 发送电机状态帧
+ * @param status 电机应用状态
+ * @return int32_t 0: 成功, -1: 参数无效, -2: 发送缓冲已满，帧被丢弃
+ */
+int32_t telemetry_send_motor(const motor_app_status_t *status);
+
+/**
+ * @brief 发送任意类型的遥测帧
+ * @param type 帧类型
+ * @param timestamp CPU周期时间戳
+ * @param payload 载荷数据
+ * @param len 载荷长度，最大TELEMETRY_MAX_PAYLOAD
+ * @return int32_t 0: 成功, -1: 参数无效, -2: 发送缓冲已满，帧被丢弃
+ */
+int32_t telemetry_send(uint8_t type, uint32_t timestamp, const uint8_t *payload, uint32_t len);
+
+/**
+ * @brief 进入或退出二进制遥测模式
+ * @param enable 1: 二进制模式，屏蔽printf文本输出; 0: 恢复文本输出
+ * @note 文本与COBS帧共用同一串口，二进制模式下文本字节会破坏帧流
+ */
+void telemetry_set_binary(uint8_t enable);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TELEMETRY_H__ */
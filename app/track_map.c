@@ -0,0 +1,341 @@
+/**
+ * @file track_map.c
+ * @brief 赛道记忆与按曲率规划的速度曲线实现
+ * @date 2026-10-16
+ */
+
+#include <stddef.h>
+#include <math.h>
+#include "track_map.h"
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+#define TRACK_MAP_MM_PER_M          1000.0f
+#define TRACK_MAP_V_CEIL            65.535f /**< v_plan (mm/s, 16位) 能表示的上限 */
+
+/**
+ * @brief 规划的各遍
+ */
+enum {
+    TRACK_PASS_LIMIT = 0,           /**< 弯道限速 */
+    TRACK_PASS_BACK1,               /**< 从后往前: 提前减速 (绕两圈) */
+    TRACK_PASS_BACK2,
+    TRACK_PASS_FWD1,                /**< 从前往后: 出弯加速 (绕两圈) */
+    TRACK_PASS_FWD2,
+    TRACK_PASS_TIME,                /**< 估计圈速 */
+    TRACK_PASS_DONE
+};
+
+/* ========================================================================== */
+/*                              私有函数                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 速度 (m/s) 存为 mm/s
+ */
+static uint16_t track_map_to_mm(float v)
+{
+    if (!(v > 0.0f)) {
+        return 0;
+    }
+    if (v >= TRACK_MAP_V_CEIL) {
+        return 0xFFFFU;
+    }
+    return (uint16_t)(v * TRACK_MAP_MM_PER_M);
+}
+
+/**
+ * @brief 读取一段的规划速度 (m/s)
+ */
+static float track_map_v(const track_map_t *map, uint32_t i)
+{
+    return (float)map->bins[i].v_plan / TRACK_MAP_MM_PER_M;
+}
+
+/**
+ * @brief 结束当前段，写入表中
+ * @note 段内没有采样(车速快到一个节拍跨过多段)时沿用上一段的值
+ */
+static void track_map_close_bin(track_map_t *map)
+{
+    track_map_bin_t *bin = &map->bins[map->count];
+    float kappa;
+
+    if (map->pos_n == 0 && map->count > 0) {
+        *bin = map->bins[map->count - 1U];
+    } else {
+        kappa = map->yaw_acc / map->cfg.bin_m * TRACK_MAP_KAPPA_SCALE;
+        if (kappa > 32767.0f) {
+            kappa = 32767.0f;
+        } else if (kappa < -32767.0f) {
+            kappa = -32767.0f;
+        }
+        bin->kappa = (int16_t)kappa;
+        bin->position = (int8_t)((map->pos_n > 0) ? (map->pos_acc / (int32_t)map->pos_n) : 0);
+        bin->flags = map->flag_acc;
+    }
+    bin->v_plan = 0;
+
+    map->count++;
+    map->yaw_acc = 0.0f;
+    map->pos_acc = 0;
+    map->pos_n = 0;
+    map->flag_acc = 0;
+}
+
+/**
+ * @brief 结束记录到目标段数
+ * @return int32_t 0: 成功, -1: 超出表长
+ */
+static int32_t track_map_close_to(track_map_t *map, uint32_t bins)
+{
+    while (map->count < bins) {
+        if (map->count >= TRACK_MAP_MAX_BINS) {
+            map->state = TRACK_MAP_FAILED;
+            return -1;
+        }
+        track_map_close_bin(map);
+    }
+    return 0;
+}
+
+/**
+ * @brief 规划一段
+ */
+static void track_map_plan_bin(track_map_t *map, uint8_t pass, uint32_t idx)
+{
+    const track_map_config_t *cfg = &map->cfg;
+    uint32_t n = map->count;
+    uint32_t i, j;
+    float k, kn, v, vj;
+
+    switch (pass) {
+    case TRACK_PASS_LIMIT:
+        /* 曲率取相邻三段的最大值，抵消陀螺噪声和入弯位置误差 */
+        i = idx;
+        k = fabsf((float)map->bins[i].kappa);
+        kn = fabsf((float)map->bins[(i + n - 1U) % n].kappa);
+        if (kn > k) {
+            k = kn;
+        }
+        kn = fabsf((float)map->bins[(i + 1U) % n].kappa);
+        if (kn > k) {
+            k = kn;
+        }
+        k /= TRACK_MAP_KAPPA_SCALE;
+
+        v = cfg->v_max;
+        if (k > 0.0f && cfg->a_lat / k < v * v) {
+            v = sqrtf(cfg->a_lat / k);
+        }
+        /* 路口和丢线段在记录时偏离正常跟线，曲率不可信，直接取最低速度 */
+        if ((map->bins[i].flags & (TRACK_MAP_FLAG_JUNCTION | TRACK_MAP_FLAG_LOST)) != 0U || v < cfg->v_min) {
+            v = cfg->v_min;
+        }
+        map->bins[i].v_plan = track_map_to_mm(v);
+        break;
+
+    case TRACK_PASS_BACK1:
+    case TRACK_PASS_BACK2:
+        i = n - 1U - idx;
+        j = (i + 1U) % n;
+        vj = track_map_v(map, j);
+        v = vj * vj + 2.0f * cfg->a_brake * cfg->bin_m;
+        if (track_map_v(map, i) * track_map_v(map, i) > v) {
+            map->bins[i].v_plan = track_map_to_mm(sqrtf(v));
+        }
+        break;
+
+    case TRACK_PASS_FWD1:
+    case TRACK_PASS_FWD2:
+        i = idx;
+        j = (i + n - 1U) % n;
+        vj = track_map_v(map, j);
+        v = vj * vj + 2.0f * cfg->a_accel * cfg->bin_m;
+        if (track_map_v(map, i) * track_map_v(map, i) > v) {
+            map->bins[i].v_plan = track_map_to_mm(sqrtf(v));
+        }
+        break;
+
+    case TRACK_PASS_TIME:
+        /* 段内按首尾速度的平均值匀变速 */
+        i = idx;
+        v = 0.5f * (track_map_v(map, i) + track_map_v(map, (i + 1U) % n));
+        if (v > 0.0f) {
+            map->plan_time_s += cfg->bin_m / v;
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+/* ========================================================================== */
+/*                              公共函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化赛道表
+ */
+int32_t track_map_init(track_map_t *map, const track_map_config_t *cfg)
+{
+    if (map == NULL || cfg == NULL) {
+        return -1;
+    }
+
+    /* NaN在比较中均为假，可一并拒绝 */
+    if (!(cfg->bin_m > 0.0f) || !(cfg->v_min > 0.0f) || !(cfg->v_max >= cfg->v_min) ||
+        !(cfg->v_max < TRACK_MAP_V_CEIL) || !(cfg->a_lat > 0.0f) || !(cfg->a_accel > 0.0f) ||
+        !(cfg->a_brake > 0.0f) || !(cfg->lookahead_s >= 0.0f)) {
+        return -1;
+    }
+
+    map->cfg = *cfg;
+    map->count = 0;
+    map->length_m = 0.0f;
+    map->origin_m = 0.0f;
+    map->plan_time_s = 0.0f;
+    map->state = TRACK_MAP_IDLE;
+    map->yaw_acc = 0.0f;
+    map->pos_acc = 0;
+    map->pos_n = 0;
+    map->flag_acc = 0;
+    map->plan_pass = TRACK_PASS_DONE;
+    map->plan_idx = 0;
+
+    return 0;
+}
+
+/**
+ * @brief 经过起终点标记
+ */
+uint8_t track_map_lap_mark(track_map_t *map, float distance_m)
+{
+    uint32_t bins;
+
+    switch (map->state) {
+    case TRACK_MAP_IDLE:
+        map->state = TRACK_MAP_RECORDING;
+        break;
+
+    case TRACK_MAP_RECORDING:
+        /* 一圈长度四舍五入到整段: 最后不足半段的部分舍去，超过半段的按一段记 */
+        bins = (uint32_t)((distance_m - map->origin_m) / map->cfg.bin_m + 0.5f);
+        if (bins < TRACK_MAP_MIN_BINS || track_map_close_to(map, bins) != 0) {
+            map->state = TRACK_MAP_FAILED;
+            break;
+        }
+        map->count = bins;
+        map->length_m = (float)bins * map->cfg.bin_m;
+        map->plan_pass = TRACK_PASS_LIMIT;
+        map->plan_idx = 0;
+        map->plan_time_s = 0.0f;
+        map->state = TRACK_MAP_PLANNING;
+        break;
+
+    default:
+        break;
+    }
+
+    map->origin_m = distance_m;
+    return map->state;
+}
+
+/**
+ * @brief 记录一个采样
+ */
+void track_map_record(track_map_t *map, float distance_m, float yaw_rate_rps, float dt_s,
+                      int8_t position, uint8_t flags)
+{
+    float s;
+
+    if (map->state != TRACK_MAP_RECORDING) {
+        return;
+    }
+
+    s = distance_m - map->origin_m;
+    if (s > 0.0f && track_map_close_to(map, (uint32_t)(s / map->cfg.bin_m)) != 0) {
+        return;
+    }
+
+    map->yaw_acc += yaw_rate_rps * dt_s;
+    map->pos_acc += position;
+    map->pos_n++;
+    map->flag_acc |= flags;
+}
+
+/**
+ * @brief 分批规划
+ */
+uint8_t track_map_plan_step(track_map_t *map, uint32_t budget)
+{
+    if (map->state != TRACK_MAP_PLANNING) {
+        return map->state;
+    }
+
+    while (budget > 0 && map->plan_pass < TRACK_PASS_DONE) {
+        track_map_plan_bin(map, map->plan_pass, map->plan_idx);
+        budget--;
+        if (++map->plan_idx >= map->count) {
+            map->plan_idx = 0;
+            map->plan_pass++;
+        }
+    }
+
+    if (map->plan_pass >= TRACK_PASS_DONE) {
+        map->state = TRACK_MAP_READY;
+    }
+    return map->state;
+}
+
+/**
+ * @brief 一次完成规划
+ */
+int32_t track_map_plan(track_map_t *map)
+{
+    if (map == NULL || map->count < TRACK_MAP_MIN_BINS ||
+        (map->state != TRACK_MAP_PLANNING && map->state != TRACK_MAP_READY)) {
+        return -1;
+    }
+
+    map->state = TRACK_MAP_PLANNING;
+    map->plan_pass = TRACK_PASS_LIMIT;
+    map->plan_idx = 0;
+    map->plan_time_s = 0.0f;
+    while (track_map_plan_step(map, map->count) != TRACK_MAP_READY) {
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 查询目标速度
+ * @note 在段起点之间线性插值，路程超出一圈时取模 (标记漏检时仍可继续)
+ */
+float track_map_speed(const track_map_t *map, float distance_m, float v_now)
+{
+    float s, pos, frac;
+    uint32_t i;
+
+    if (map->state != TRACK_MAP_READY) {
+        return 0.0f;
+    }
+
+    s = distance_m - map->origin_m + v_now * map->cfg.lookahead_s;
+    s = fmodf(s, map->length_m);
+    if (s < 0.0f) {
+        s += map->length_m;
+    }
+
+    pos = s / map->cfg.bin_m;
+    i = (uint32_t)pos;
+    if (i >= map->count) {
+        i = map->count - 1U;
+    }
+    frac = pos - (float)i;
+
+    return track_map_v(map, i) + (track_map_v(map, (i + 1U) % map->count) - track_map_v(map, i)) * frac;
+}
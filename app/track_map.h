@@ -0,0 +1,162 @@
+/**
+ * @file track_map.h
+ * @brief 赛道记忆与按曲率规划的速度曲线
+ * @details 第一圈沿路程把航向变化、线位置和路口/丢线标记记入按距离分段的RAM表，
+ *          每段存曲率，之后的圈按当前路程查表得到目标速度:
+ *          - 弯道限速: v ≤ sqrt(a_lat / |κ|)，κ取相邻三段的最大值
+ *          - 提前减速: 从后往前保证 v[i]² ≤ v[i+1]² + 2·a_brake·ds
+ *          - 出弯加速: 从前往后保证 v[i]² ≤ v[i-1]² + 2·a_accel·ds
+ *          赛道为闭环，首尾相接，前后两遍各绕两圈收敛。
+ *          规划按段分批进行(track_map_plan_step)，每批耗时有上限，可在控制节拍中断中完成；
+ *          主机端的回放工具(tools/track_replay.c)直接编译本文件验证速度曲线。
+ * @date 2026-10-16
+ *
+ * @note 每圈在同一标记(起终点线)处调用track_map_lap_mark()对齐路程，累计误差不跨圈
+ */
+
+#ifndef TRACK_MAP_H__
+#define TRACK_MAP_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/*                              配置参数                                      */
+/* ========================================================================== */
+
+#ifndef TRACK_MAP_MAX_BINS
+#define TRACK_MAP_MAX_BINS          1024U   /**< 最大分段数 (默认2cm分段可记录约20m赛道) */
+#endif
+
+#define TRACK_MAP_KAPPA_SCALE       1000.0f /**< 曲率存储单位: 1/1000 m⁻¹ */
+#define TRACK_MAP_MIN_BINS          8U      /**< 少于该段数的记录视为无效 */
+
+#define TRACK_MAP_FLAG_JUNCTION     0x01U   /**< 段内经过路口 */
+#define TRACK_MAP_FLAG_LOST         0x02U   /**< 段内丢线 */
+
+/* ========================================================================== */
+/*                              数据结构定义                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 记录与规划配置 (长度m，速度m/s，加速度m/s²)
+ */
+typedef struct {
+    float bin_m;                    /**< 分段长度 */
+    float v_max;                    /**< 速度上限 (直道) */
+    float v_min;                    /**< 速度下限 (最急的弯、路口) */
+    float a_lat;                    /**< 横向加速度上限 (决定弯道速度) */
+    float a_accel;                  /**< 纵向加速度上限 */
+    float a_brake;                  /**< 纵向减速度上限 */
+    float lookahead_s;              /**< 查表时按当前速度额外前视的时间，补偿速度环滞后 */
+} track_map_config_t;
+
+/**
+ * @brief 一个距离分段 (6字节)
+ */
+typedef struct {
+    int16_t kappa;                  /**< 曲率 (1/1000 m⁻¹)，左转为正 */
+    uint16_t v_plan;                /**< 规划速度 (mm/s) */
+    int8_t position;                /**< 段内平均线位置 (line_sensor.h单位) */
+    uint8_t flags;                  /**< TRACK_MAP_FLAG_* */
+} track_map_bin_t;
+
+/**
+ * @brief 记录/规划状态
+ */
+typedef enum {
+    TRACK_MAP_IDLE = 0,             /**< 等待第一个标记 */
+    TRACK_MAP_RECORDING,            /**< 第一圈记录中 */
+    TRACK_MAP_PLANNING,             /**< 记录完成，分批规划中 */
+    TRACK_MAP_READY,                /**< 速度曲线可用 */
+    TRACK_MAP_FAILED                /**< 记录过短或超出表长 */
+} track_map_state_t;
+
+/**
+ * @brief 赛道表
+ */
+typedef struct {
+    track_map_config_t cfg;         /**< 配置 */
+    track_map_bin_t bins[TRACK_MAP_MAX_BINS];   /**< 分段表 */
+    uint32_t count;                 /**< 已记录的段数 */
+    float length_m;                 /**< 一圈长度 (count × bin_m) */
+    float origin_m;                 /**< 本圈起点的累计路程 */
+    float plan_time_s;              /**< 按规划速度跑一圈的估计用时 */
+    uint8_t state;                  /**< track_map_state_t */
+    /* 记录中的当前段 */
+    float yaw_acc;                  /**< 段内航向变化 (rad) */
+    int32_t pos_acc;                /**< 段内线位置累加 */
+    uint32_t pos_n;                 /**< 段内采样数 */
+    uint8_t flag_acc;               /**< 段内标记 */
+    /* 分批规划进度 */
+    uint8_t plan_pass;              /**< 当前遍 */
+    uint32_t plan_idx;              /**< 当前遍内的下标 */
+} track_map_t;
+
+/* ========================================================================== */
+/*                              接口函数                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化赛道表 (清空记录)
+ * @param map 赛道表
+ * @param cfg 配置
+ * @return int32_t 0: 成功, -1: 参数无效
+ */
+int32_t track_map_init(track_map_t *map, const track_map_config_t *cfg);
+
+/**
+ * @brief 经过起终点标记
+ * @param map 赛道表
+ * @param distance_m 当前累计路程
+ * @return uint8_t 调用后的状态 (track_map_state_t)
+ * @note IDLE时开始记录；RECORDING时结束记录并进入分批规划；其余状态只对齐本圈起点
+ */
+uint8_t track_map_lap_mark(track_map_t *map, float distance_m);
+
+/**
+ * @brief 记录一个采样 (RECORDING时有效)
+ * @param map 赛道表
+ * @param distance_m 当前累计路程
+ * @param yaw_rate_rps 航向角速度 (rad/s，逆时针为正)
+ * @param dt_s 采样间隔
+ * @param position 线位置
+ * @param flags 本采样的TRACK_MAP_FLAG_*
+ * @note 超出表长时进入FAILED
+ */
+void track_map_record(track_map_t *map, float distance_m, float yaw_rate_rps, float dt_s,
+                      int8_t position, uint8_t flags);
+
+/**
+ * @brief 分批规划 (PLANNING时有效)
+ * @param map 赛道表
+ * @param budget 本次最多处理的段数
+ * @return uint8_t 调用后的状态，完成时为READY
+ */
+uint8_t track_map_plan_step(track_map_t *map, uint32_t budget);
+
+/**
+ * @brief 一次完成规划 (主循环或主机端使用)
+ * @param map 赛道表
+ * @return int32_t 0: 成功, -1: 没有可规划的记录
+ * @note 修改配置后可对已有记录重新规划
+ */
+int32_t track_map_plan(track_map_t *map);
+
+/**
+ * @brief 查询目标速度 (READY时有效)
+ * @param map 赛道表
+ * @param distance_m 当前累计路程
+ * @param v_now 当前速度 (m/s)，用于前视
+ * @return float 目标速度 (m/s)，未就绪时返回0
+ */
+float track_map_speed(const track_map_t *map, float distance_m, float v_now);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACK_MAP_H__ */
@@ -0,0 +1,254 @@
+/**
+ * @file wheel_encoder.c
+ * @brief 车轮编码器位置扩展与M/T法测速实现
+ * @date 2026-10-16
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "cmsis_compiler.h"
+#include "wheel_encoder.h"
+#include "speed_ctrl.h"
+#include "encoder_port.h"   /* 采样结构与接口只在端口层头文件中定义一次 */
+
+extern uint32_t tick_port_cycles(void);
+extern uint32_t tick_port_cycles_per_us(void);
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+#if (WHEEL_ENC_NUM != ENCODER_PORT_NUM) || (WHEEL_ENC_LEFT != ENCODER_PORT_LEFT) || \
+    (WHEEL_ENC_RIGHT != ENCODER_PORT_RIGHT)
+#error "wheel_encoder.h and encoder_port.h disagree on the wheel numbering"
+#endif
+
+/* ========================================================================== */
+/*                              私有变量                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 单轮内部状态 (原始计数单位)
+ */
+typedef struct {
+    int64_t raw_pos;                /* 64位原始位置 */
+    int32_t raw_vel;                /* 原始速度 (计数/秒) */
+    uint32_t cpr;                   /* 原始每转计数 */
+    uint32_t edge_counts;           /* 相邻边沿之间的原始计数 */
+    uint32_t last_edges;            /* 上次采样时的边沿总数 */
+    int64_t ref_pos;                /* T法参考边沿位置 */
+    uint32_t ref_cycles;            /* T法参考边沿时间 */
+    uint8_t ref_valid;              /* 参考边沿有效 */
+    uint8_t mode;                   /* wheel_enc_mode_t */
+    speed_ctrl_vel_t window;        /* M法滑动窗口 */
+} wheel_enc_chan_t;
+
+static wheel_enc_chan_t s_chan[WHEEL_ENC_NUM];
+static uint32_t s_rate_hz = 1000;
+static uint32_t s_cpu_hz = 168000000UL;
+static uint32_t s_stop_cycles = 0;
+static float s_m_per_count = 0.0f;          /* 每归一化计数的行程 (m) */
+static float s_wheel_base = 0.0f;           /* 轮距 (m) */
+
+static volatile uint32_t s_snap_seq = 0;    /* 快照顺序锁，奇数表示正在更新 */
+static wheel_enc_snapshot_t s_snap;
+
+/* ========================================================================== */
+/*                              私有函数声明                                  */
+/* ========================================================================== */
+
+static void wheel_enc_update_chan(uint8_t wheel, wheel_enc_chan_t *ch, const encoder_port_sample_t *s, uint32_t now);
+static int32_t wheel_enc_to_norm(const wheel_enc_chan_t *ch, int32_t raw);
+
+/* ========================================================================== */
+/*                              公共函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 启动编码器并清零位置
+ */
+int32_t wheel_enc_init(uint32_t rate_hz)
+{
+    uint32_t cpr[WHEEL_ENC_NUM];
+    uint32_t edge_counts[WHEEL_ENC_NUM];
+    float radius;
+    uint8_t i;
+
+    /* 参数检查 */
+    if (rate_hz == 0) {
+        return -1;
+    }
+
+    encoder_port_get_wheel(&radius, &s_wheel_base);
+    s_m_per_count = (2.0f * 3.14159265f * radius) / (float)WHEEL_ENC_NORM_CPR;
+
+    memset(s_chan, 0, sizeof(s_chan));
+    memset(&s_snap, 0, sizeof(s_snap));
+
+    encoder_port_get_geometry(cpr, edge_counts);
+    for (i = 0; i < WHEEL_ENC_NUM; i++) {
+        if (cpr[i] == 0) {
+            return -1;
+        }
+        s_chan[i].cpr = cpr[i];
+        s_chan[i].edge_counts = edge_counts[i];
+        s_chan[i].mode = WHEEL_ENC_MODE_M;
+        speed_ctrl_vel_reset(&s_chan[i].window);
+        encoder_port_set_edge_capture(i, 0);
+    }
+
+    s_rate_hz = rate_hz;
+    s_cpu_hz = tick_port_cycles_per_us() * 1000000UL;
+    s_stop_cycles = (s_cpu_hz / 1000UL) * WHEEL_ENC_STOP_MS;
+
+    return (encoder_port_init() == 0) ? 0 : -1;
+}
+
+/**
+ * @brief 采样编码器并更新位置和速度
+ */
+void wheel_enc_update(void)
+{
+    encoder_port_sample_t samples[WHEEL_ENC_NUM];
+    uint32_t now;
+    uint8_t i;
+
+    encoder_port_sample(samples);
+    now = tick_port_cycles();
+
+    for (i = 0; i < WHEEL_ENC_NUM; i++) {
+        wheel_enc_update_chan(i, &s_chan[i], &samples[i], now);
+    }
+
+    /* 发布快照 */
+    s_snap_seq++;
+    __COMPILER_BARRIER();
+    s_snap.timestamp = now;
+    s_snap.updates++;
+    for (i = 0; i < WHEEL_ENC_NUM; i++) {
+        s_snap.wheel[i].position = (s_chan[i].raw_pos * WHEEL_ENC_NORM_CPR) / (int64_t)s_chan[i].cpr;
+        s_snap.wheel[i].velocity = wheel_enc_to_norm(&s_chan[i], s_chan[i].raw_vel);
+        s_snap.wheel[i].mode = s_chan[i].mode;
+    }
+    __COMPILER_BARRIER();
+    s_snap_seq++;
+}
+
+/**
+ * @brief 获取最近一次更新的速度
+ */
+int32_t wheel_enc_velocity(uint8_t wheel)
+{
+    if (wheel >= WHEEL_ENC_NUM) {
+        return 0;
+    }
+    return s_snap.wheel[wheel].velocity;
+}
+
+/**
+ * @brief 每个归一化计数对应的车轮行程
+ */
+float wheel_enc_m_per_count(void)
+{
+    return s_m_per_count;
+}
+
+/**
+ * @brief 轮距
+ */
+float wheel_enc_wheel_base(void)
+{
+    return s_wheel_base;
+}
+
+/**
+ * @brief 获取一致的两轮状态快照
+ */
+void wheel_enc_get(wheel_enc_snapshot_t *snap)
+{
+    uint32_t seq;
+
+    if (snap == NULL) {
+        return;
+    }
+
+    do {
+        seq = s_snap_seq;
+        __COMPILER_BARRIER();
+        *snap = s_snap;
+        __COMPILER_BARRIER();
+    } while ((seq & 1U) != 0U || seq != s_snap_seq);
+}
+
+/* ========================================================================== */
+/*                              私有函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 更新单轮位置、速度和测速方法
+ */
+static void wheel_enc_update_chan(uint8_t wheel, wheel_enc_chan_t *ch, const encoder_port_sample_t *s, uint32_t now)
+{
+    int32_t vel_m;
+    int64_t edge_pos;
+    int32_t bound;
+    uint32_t dt;
+
+    ch->raw_pos += s->delta;
+    vel_m = speed_ctrl_vel_update(&ch->window, s->delta, s_rate_hz);
+
+    if (ch->mode == WHEEL_ENC_MODE_M) {
+        ch->raw_vel = vel_m;
+        if (labs(wheel_enc_to_norm(ch, vel_m)) < WHEEL_ENC_MT_LOW_CPS) {
+            ch->mode = WHEEL_ENC_MODE_T;
+            ch->ref_valid = 0;
+            encoder_port_set_edge_capture(wheel, 1);
+        }
+        ch->last_edges = s->edges;
+        return;
+    }
+
+    if (s->edges != ch->last_edges) {
+        /* 有新边沿: 两次边沿之间的精确计数差 / 精确时间差 */
+        edge_pos = ch->raw_pos + s->edge_offset;
+        dt = s->edge_cycles - ch->ref_cycles;
+        if (ch->ref_valid && dt != 0) {
+            ch->raw_vel = (int32_t)(((edge_pos - ch->ref_pos) * (int64_t)s_cpu_hz) / (int64_t)dt);
+        } else {
+            ch->raw_vel = vel_m;
+        }
+        ch->ref_pos = edge_pos;
+        ch->ref_cycles = s->edge_cycles;
+        ch->ref_valid = 1;
+    } else if (ch->ref_valid) {
+        /* 无新边沿: 真实速度不超过一个边沿间隔/已过去的时间 */
+        dt = now - ch->ref_cycles;
+        if (dt > s_stop_cycles) {
+            ch->raw_vel = 0;
+            ch->ref_valid = 0;
+        } else if (dt != 0) {
+            bound = (int32_t)(((int64_t)ch->edge_counts * (int64_t)s_cpu_hz) / (int64_t)dt);
+            if (ch->raw_vel > bound) {
+                ch->raw_vel = bound;
+            } else if (ch->raw_vel < -bound) {
+                ch->raw_vel = -bound;
+            }
+        }
+    } else {
+        ch->raw_vel = vel_m;
+    }
+    ch->last_edges = s->edges;
+
+    if (labs(wheel_enc_to_norm(ch, ch->raw_vel)) > WHEEL_ENC_MT_HIGH_CPS) {
+        ch->mode = WHEEL_ENC_MODE_M;
+        encoder_port_set_edge_capture(wheel, 0);
+    }
+}
+
+/**
+ * @brief 原始计数/秒转换为归一化计数/秒
+ */
+static int32_t wheel_enc_to_norm(const wheel_enc_chan_t *ch, int32_t raw)
+{
+    return (int32_t)(((int64_t)raw * WHEEL_ENC_NORM_CPR) / (int64_t)ch->cpr);
+}
@@ -0,0 +1,126 @@
+/**
+ * @file wheel_encoder.h
+ * @brief 车轮编码器位置扩展与M/T法测速
+ * @details 将两路不同位宽、不同倍频的编码器计数扩展为64位位置，并归一化到统一的
+ *          每转计数 (WHEEL_ENC_NORM_CPR)。速度采用M/T混合法:
+ *          - 高速 (M法): 滑动窗口内的计数差除以窗口时间
+ *          - 低速 (T法): 打开边沿捕获，用两次边沿之间的精确计数差除以DWT计时，
+ *            无新边沿时以"一个边沿间隔/距上次边沿的时间"为上界逐渐衰减到0
+ *          两种方法之间按速度阈值带滞回切换，避免低速时速度量化为0。
+ * @date 2026-10-16
+ *
+ * @note wheel_enc_update()只在控制节拍中断中调用；wheel_enc_get()可在任意上下文调用
+ */
+
+#ifndef WHEEL_ENCODER_H__
+#define WHEEL_ENCODER_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/*                              配置参数                                      */
+/* ========================================================================== */
+
+#define WHEEL_ENC_LEFT              0U      /**< 左轮 */
+#define WHEEL_ENC_RIGHT             1U      /**< 右轮 */
+#define WHEEL_ENC_NUM               2U      /**< 车轮数量 */
+
+#define WHEEL_ENC_NORM_CPR          4096L   /**< 归一化每转计数 */
+
+/**
+ * @brief M/T切换阈值 (归一化计数/秒)
+ * @note 低于LOW进入T法并打开边沿中断，高于HIGH回到M法并关闭边沿中断
+ */
+#ifndef WHEEL_ENC_MT_LOW_CPS
+#define WHEEL_ENC_MT_LOW_CPS        1500L
+#endif
+#ifndef WHEEL_ENC_MT_HIGH_CPS
+#define WHEEL_ENC_MT_HIGH_CPS       2000L
+#endif
+
+#define WHEEL_ENC_STOP_MS           200U    /**< T法下超过该时间无边沿视为静止 */
+
+/* ========================================================================== */
+/*                              数据结构定义                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 测速方法
+ */
+typedef enum {
+    WHEEL_ENC_MODE_M = 0,           /**< 计数差法 (高速) */
+    WHEEL_ENC_MODE_T                /**< 边沿周期法 (低速) */
+} wheel_enc_mode_t;
+
+/**
+ * @brief 单个车轮的状态
+ */
+typedef struct {
+    int64_t position;               /**< 归一化位置 (计数，WHEEL_ENC_NORM_CPR/转) */
+    int32_t velocity;               /**< 归一化速度 (计数/秒) */
+    uint8_t mode;                   /**< 当前测速方法 (wheel_enc_mode_t) */
+} wheel_enc_state_t;
+
+/**
+ * @brief 两轮状态快照
+ */
+typedef struct {
+    uint32_t timestamp;             /**< 更新时刻的CPU周期计数 */
+    uint32_t updates;               /**< 更新次数 */
+    wheel_enc_state_t wheel[WHEEL_ENC_NUM]; /**< 左右轮状态 */
+} wheel_enc_snapshot_t;
+
+/* ========================================================================== */
+/*                              API接口                                       */
+/* ========================================================================== */
+
+/**
+ * @brief 启动编码器并清零位置
+ * @param rate_hz wheel_enc_update()的调用频率 (Hz)
+ * @return int32_t 0: 成功, -1: 参数无效或编码器启动失败
+ */
+int32_t wheel_enc_init(uint32_t rate_hz);
+
+/**
+ * @brief 采样编码器并更新位置和速度
+ * @note 控制节拍中断中调用，固定频率
+ */
+void wheel_enc_update(void);
+
+/**
+ * @brief 获取最近一次更新的速度 (归一化计数/秒)
+ * @param wheel WHEEL_ENC_LEFT / WHEEL_ENC_RIGHT
+ * @return int32_t 速度
+ * @note 供控制节拍中断内部使用，主循环请用wheel_enc_get()
+ */
+int32_t wheel_enc_velocity(uint8_t wheel);
+
+/**
+ * @brief 每个归一化计数对应的车轮行程
+ * @return float 米/计数 (2πr / WHEEL_ENC_NORM_CPR)
+ * @note wheel_enc_init()之后有效
+ */
+float wheel_enc_m_per_count(void);
+
+/**
+ * @brief 轮距
+ * @return float 左右轮接地点间距 (m)，wheel_enc_init()之后有效
+ */
+float wheel_enc_wheel_base(void);
+
+/**
+ * @brief 获取一致的两轮状态快照
+ * @param snap 输出快照
+ * @note 顺序锁读取，被更新打断时自动重读
+ */
+void wheel_enc_get(wheel_enc_snapshot_t *snap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WHEEL_ENCODER_H__ */
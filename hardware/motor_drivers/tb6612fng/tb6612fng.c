@@ -47,6 +47,9 @@ extern tb6612_error_t motor_port_init(const tb6612_config_t *config);
 extern tb6612_error_t motor_port_deinit(void);
 extern tb6612_error_t motor_port_set_direction(tb6612_motor_t motor, tb6612_direction_t direction);
 extern tb6612_error_t motor_port_set_speed(tb6612_motor_t motor, uint16_t speed_percent);
+extern tb6612_error_t motor_port_set_duty_raw(tb6612_motor_t motor, uint16_t duty);
+extern tb6612_error_t motor_port_set_pair_sync(uint16_t duty_a, tb6612_direction_t dir_a,
+                                               uint16_t duty_b, tb6612_direction_t dir_b);
 
 
 
@@ -59,6 +62,9 @@ static bool tb6612_is_valid_direction(tb6612_direction_t direction);
 static bool tb6612_is_valid_speed(uint16_t speed_percent);
 static bool tb6612_is_valid_config(const tb6612_config_t *config);
 static void tb6612_set_default_config(tb6612_config_t *config);
+static tb6612_error_t tb6612_commit_pair(uint16_t duty_a, tb6612_direction_t dir_a,
+                                         uint16_t duty_b, tb6612_direction_t dir_b);
+static void tb6612_update_pair_status(tb6612_motor_t motor, uint16_t duty, tb6612_direction_t direction);
 
 
 /* ========================================================================== */
@@ -212,6 +218,36 @@ tb6612_error_t tb6612_set_speed(tb6612_motor_t motor, uint16_t speed_percent)
     return TB6612_OK;
 }
 
+/**
+ * @brief 以原始分辨率设置电机占空比
+ */
+tb6612_error_t tb6612_set_speed_raw(tb6612_motor_t motor, uint16_t duty)
+{
+    tb6612_error_t ret = TB6612_OK;
+
+    /* 参数检查 */
+    if (!g_tb6612_driver.initialized) {
+        return TB6612_ERROR_NOT_INITIALIZED;
+    }
+
+    if (!tb6612_is_valid_motor(motor) || duty > TB6612_DUTY_FULL) {
+        return TB6612_ERROR_INVALID_PARAM;
+    }
+
+    /* 调用端口层直接写比较寄存器 */
+    ret = motor_port_set_duty_raw(motor, duty);
+    if (ret != TB6612_OK) {
+        return ret;
+    }
+
+    /* 更新电机状态 (百分比四舍五入) */
+    g_tb6612_driver.motor_status[motor].speed_percent =
+        (uint16_t)(((uint32_t)duty * 100U + TB6612_DUTY_FULL / 2U) / TB6612_DUTY_FULL);
+    g_tb6612_driver.motor_status[motor].state = (duty == 0) ? TB6612_STATE_IDLE : TB6612_STATE_RUNNING;
+
+    return TB6612_OK;
+}
+
 /**
  * @brief 停止指定电机
  */
@@ -246,6 +282,24 @@ tb6612_error_t tb6612_stop_all(void)
 
 
 
+/**
+ * @brief 获取当前配置参数
+ */
+tb6612_error_t tb6612_get_config(tb6612_config_t *config)
+{
+    if (config == NULL) {
+        return TB6612_ERROR_INVALID_PARAM;
+    }
+
+    if (!g_tb6612_driver.initialized) {
+        return TB6612_ERROR_NOT_INITIALIZED;
+    }
+
+    memcpy(config, &g_tb6612_driver.config, sizeof(tb6612_config_t));
+
+    return TB6612_OK;
+}
+
 /**
  * @brief 检查驱动是否已初始化
  */
@@ -264,8 +318,6 @@ bool tb6612_is_initialized(void)
 tb6612_error_t tb6612_set_motor_pair(uint16_t speed_a, tb6612_direction_t dir_a,
                                      uint16_t speed_b, tb6612_direction_t dir_b)
 {
-    tb6612_error_t ret = TB6612_OK;
-
     /* 参数检查 */
     if (!g_tb6612_driver.initialized) {
         return TB6612_ERROR_NOT_INITIALIZED;
@@ -279,33 +331,35 @@ tb6612_error_t tb6612_set_motor_pair(uint16_t speed_a, tb6612_direction_t dir_a,
         return TB6612_ERROR_INVALID_PARAM;
     }
 
-    /* 同时设置两个电机的方向 */
-    ret = tb6612_set_direction(TB6612_MOTOR_A, dir_a);
-    if (ret != TB6612_OK) {
-        return ret;
-    }
+    /* 百分比换算为原始占空比，两路在同一个PWM周期边界生效 */
+    return tb6612_commit_pair((uint16_t)(((uint32_t)speed_a * TB6612_DUTY_FULL) / 100U), dir_a,
+                              (uint16_t)(((uint32_t)speed_b * TB6612_DUTY_FULL) / 100U), dir_b);
+}
 
-    ret = tb6612_set_direction(TB6612_MOTOR_B, dir_b);
-    if (ret != TB6612_OK) {
-        return ret;
+
+
+/**
+ * @brief 双电机原始占空比协调控制
+ */
+tb6612_error_t tb6612_set_motor_pair_raw(uint16_t duty_a, tb6612_direction_t dir_a,
+                                         uint16_t duty_b, tb6612_direction_t dir_b)
+{
+    /* 参数检查 */
+    if (!g_tb6612_driver.initialized) {
+        return TB6612_ERROR_NOT_INITIALIZED;
     }
 
-    /* 同时设置两个电机的速度 */
-    ret = tb6612_set_speed(TB6612_MOTOR_A, speed_a);
-    if (ret != TB6612_OK) {
-        return ret;
+    if (!tb6612_is_valid_direction(dir_a) || !tb6612_is_valid_direction(dir_b)) {
+        return TB6612_ERROR_INVALID_PARAM;
     }
 
-    ret = tb6612_set_speed(TB6612_MOTOR_B, speed_b);
-    if (ret != TB6612_OK) {
-        return ret;
+    if (duty_a > TB6612_DUTY_FULL || duty_b > TB6612_DUTY_FULL) {
+        return TB6612_ERROR_INVALID_PARAM;
     }
 
-    return TB6612_OK;
+    return tb6612_commit_pair(duty_a, dir_a, duty_b, dir_b);
 }
 
-
-
 /* ========================================================================== */
 /*                              2轮驱动专用函数实现                          */
 /* ========================================================================== */
@@ -406,6 +460,42 @@ static bool tb6612_is_valid_config(const tb6612_config_t *config)
     return true;
 }
 
+/**
+ * @brief 同步提交两路电机的方向和占空比并更新状态
+ * @note 端口层暂存两路比较值，在同一个更新事件装载；方向有变化时在该更新中断中写引脚
+ */
+static tb6612_error_t tb6612_commit_pair(uint16_t duty_a, tb6612_direction_t dir_a,
+                                         uint16_t duty_b, tb6612_direction_t dir_b)
+{
+    tb6612_error_t ret = motor_port_set_pair_sync(duty_a, dir_a, duty_b, dir_b);
+
+    if (ret != TB6612_OK) {
+        return ret;
+    }
+
+    tb6612_update_pair_status(TB6612_MOTOR_A, duty_a, dir_a);
+    tb6612_update_pair_status(TB6612_MOTOR_B, duty_b, dir_b);
+
+    return TB6612_OK;
+}
+
+/**
+ * @brief 按同步提交的结果更新单个电机状态
+ */
+static void tb6612_update_pair_status(tb6612_motor_t motor, uint16_t duty, tb6612_direction_t direction)
+{
+    tb6612_motor_status_t *status = &g_tb6612_driver.motor_status[motor];
+
+    status->direction = direction;
+    status->speed_percent = (uint16_t)(((uint32_t)duty * 100U + TB6612_DUTY_FULL / 2U) / TB6612_DUTY_FULL);
+
+    if (duty == 0 || direction == TB6612_STOP || direction == TB6612_BRAKE) {
+        status->state = TB6612_STATE_IDLE;
+    } else {
+        status->state = TB6612_STATE_RUNNING;
+    }
+}
+
 /**
  * @brief 设置默认配置参数
  * @param config 配置参数指针
@@ -36,6 +36,12 @@ extern "C" {
 #define TB6612FNG_VERSION_MINOR    0        /**< 次版本号 */
 #define TB6612FNG_VERSION_PATCH    0        /**< 补丁版本号 */
 
+/* ========================================================================== */
+/*                              占空比定义                                    */
+/* ========================================================================== */
+
+#define TB6612_DUTY_FULL           32767U   /**< 原始占空比满量程 (Q15, 32767对应100%) */
+
 /* ========================================================================== */
 /*                              错误码定义                                    */
 /* ========================================================================== */
@@ -171,6 +177,20 @@ tb6612_error_t tb6612_set_direction(tb6612_motor_t motor, tb6612_direction_t dir
  */
 tb6612_error_t tb6612_set_speed(tb6612_motor_t motor, uint16_t speed_percent);
 
+/**
+ * @brief 以原始分辨率设置电机占空比
+ * @param motor 电机标识
+ * @param duty 占空比 (0 - TB6612_DUTY_FULL)
+ * @return tb6612_error_t 错误码
+ * @retval TB6612_OK 设置成功
+ * @retval TB6612_ERROR_INVALID_PARAM 参数无效
+ * @retval TB6612_ERROR_NOT_INITIALIZED 驱动未初始化
+ *
+ * @note 端口层直接写比较寄存器，分辨率为PWM周期计数 (10kHz下16800级)，
+ *       适合在1kHz控制中断中调用
+ */
+tb6612_error_t tb6612_set_speed_raw(tb6612_motor_t motor, uint16_t duty);
+
 /**
  * @brief 停止指定电机
  * @param motor 电机标识
@@ -193,6 +213,16 @@ tb6612_error_t tb6612_stop_all(void);
 
 
 
+/**
+ * @brief 获取当前配置参数
+ * @param config 输出配置
+ * @return tb6612_error_t 错误码
+ * @retval TB6612_OK 获取成功
+ * @retval TB6612_ERROR_INVALID_PARAM 参数为NULL
+ * @retval TB6612_ERROR_NOT_INITIALIZED 驱动未初始化
+ */
+tb6612_error_t tb6612_get_config(tb6612_config_t *config);
+
 /**
  * @brief 检查驱动是否已初始化
  * @return bool 初始化状态
@@ -216,11 +246,29 @@ bool tb6612_is_initialized(void);
  * @retval TB6612_ERROR_INVALID_PARAM 参数无效
  * @retval TB6612_ERROR_NOT_INITIALIZED 驱动未初始化
  *
- * @note 此函数可以同时控制两个电机，确保动作的同步性
+ * @note 两路占空比在同一个PWM周期边界生效，方向变化时方向引脚在该周期的
+ *       更新中断中一并切换，避免两轮先后变化造成的偏航冲击
  */
 tb6612_error_t tb6612_set_motor_pair(uint16_t speed_a, tb6612_direction_t dir_a,
                                      uint16_t speed_b, tb6612_direction_t dir_b);
 
+/**
+ * @brief 双电机原始占空比协调控制
+ * @param duty_a 电机A占空比 (0 - TB6612_DUTY_FULL)
+ * @param dir_a 电机A方向
+ * @param duty_b 电机B占空比 (0 - TB6612_DUTY_FULL)
+ * @param dir_b 电机B方向
+ * @return tb6612_error_t 错误码
+ * @retval TB6612_OK 设置成功
+ * @retval TB6612_ERROR_INVALID_PARAM 参数无效
+ * @retval TB6612_ERROR_NOT_INITIALIZED 驱动未初始化
+ *
+ * @note 与tb6612_set_motor_pair()相同的同步提交；方向与当前相同时不写方向引脚，
+ *       也不产生更新中断
+ */
+tb6612_error_t tb6612_set_motor_pair_raw(uint16_t duty_a, tb6612_direction_t dir_a,
+                                         uint16_t duty_b, tb6612_direction_t dir_b);
+
 /* ========================================================================== */
 /*                              2轮驱动专用函数                              */
 /* ========================================================================== */
@@ -1,16 +1,8 @@
 #include "wit_c_sdk.h"
 
-static SerialWrite p_WitSerialWriteFunc = NULL;
-static WitI2cWrite p_WitI2cWriteFunc = NULL;
-static WitI2cRead p_WitI2cReadFunc = NULL;
-static CanWrite p_WitCanWriteFunc = NULL;
-static RegUpdateCb p_WitRegUpdateCbFunc = NULL;
-static DelaymsCb p_WitDelaymsFunc = NULL;
-
-static uint8_t s_ucAddr = 0xff;
-static uint8_t s_ucWitDataBuff[WIT_DATA_BUFF_SIZE];
-static uint32_t s_uiWitDataCnt = 0, s_uiProtoclo = 0, s_uiReadRegIndex = 0;
 int16_t sReg[REGSIZE];
+/* default instance behind the legacy Wit* API, its register shadow is the global sReg */
+static wit_dev_t s_stWitDev = {.ucAddr = 0xff, .p_sReg = sReg};
 
 
 #define FuncW 0x06
@@ -74,20 +66,7 @@ static uint16_t __CRC16(uint8_t *puchMsg, uint16_t usDataLen)
     }
     return (uint16_t)(((uint16_t)uchCRCHi << 8) | (uint16_t)uchCRCLo) ;
 }
-static uint8_t __CaliSum(uint8_t *data, uint32_t len)
-{
-    uint32_t i;
-    uint8_t ucCheck = 0;
-    for(i=0; i<len; i++) ucCheck += *(data + i);
-    return ucCheck;
-}
-int32_t WitSerialWriteRegister(SerialWrite Write_func)
-{
-    if(!Write_func)return WIT_HAL_INVAL;
-    p_WitSerialWriteFunc = Write_func;
-    return WIT_HAL_OK;
-}
-static void CopeWitData(uint8_t ucIndex, uint16_t *p_data, uint32_t uiLen)
+static void CopeWitData(wit_dev_t *p_stDev, uint8_t ucIndex, uint16_t *p_data, uint32_t uiLen)
 {
     uint32_t uiReg1 = 0, uiReg2 = 0, uiReg1Len = 0, uiReg2Len = 0;
     uint16_t *p_usReg1Val = p_data;
@@ -107,7 +86,7 @@ static void CopeWitData(uint8_t ucIndex, uint16_t *p_data, uint32_t uiLen)
         case WIT_VELOCITY: uiReg1 = GPSHeight;  break;
         case WIT_QUATER:    uiReg1 = q0;  break;
         case WIT_GSA:   uiReg1 = SVNUM;  break;
-        case WIT_REGVALUE:  uiReg1 = s_uiReadRegIndex;  break;
+        case WIT_REGVALUE:  uiReg1 = p_stDev->uiReadRegIndex;  break;
 		default:
 			return ;
 
@@ -119,110 +98,172 @@ static void CopeWitData(uint8_t ucIndex, uint16_t *p_data, uint32_t uiLen)
     }
     if(uiReg1Len)
 	{
-		memcpy(&sReg[uiReg1], p_usReg1Val, uiReg1Len<<1);
-		p_WitRegUpdateCbFunc(uiReg1, uiReg1Len);
+		memcpy(&p_stDev->p_sReg[uiReg1], p_usReg1Val, uiReg1Len<<1);
+		p_stDev->p_RegUpdateCbFunc(uiReg1, uiReg1Len);
 	}
     if(uiReg2Len)
 	{
-		memcpy(&sReg[uiReg2], p_usReg2Val, uiReg2Len<<1);
-		p_WitRegUpdateCbFunc(uiReg2, uiReg2Len);
+		memcpy(&p_stDev->p_sReg[uiReg2], p_usReg2Val, uiReg2Len<<1);
+		p_stDev->p_RegUpdateCbFunc(uiReg2, uiReg2Len);
 	}
 }
 
-void WitSerialDataIn(uint8_t ucData)
+/* serial receive ring: uiDataHead is the first unparsed byte, uiDataCnt the number of bytes queued */
+#define WIT_RING_BYTE(dev, n)   (dev)->ucDataBuff[((dev)->uiDataHead + (n)) & WIT_DATA_BUFF_MASK]
+
+static uint8_t __CaliSumRing(wit_dev_t *p_stDev, uint32_t uiLen)
+{
+    uint32_t i;
+    uint8_t ucCheck = 0;
+    for(i=0; i<uiLen; i++) ucCheck += WIT_RING_BYTE(p_stDev, i);
+    return ucCheck;
+}
+static uint16_t __CRC16Ring(wit_dev_t *p_stDev, uint32_t uiLen)
+{
+    uint8_t uchCRCHi = 0xFF;
+    uint8_t uchCRCLo = 0xFF;
+    uint8_t uIndex;
+    uint32_t i;
+    for(i=0; i<uiLen; i++)
+    {
+        uIndex = uchCRCHi ^ WIT_RING_BYTE(p_stDev, i);
+        uchCRCHi = uchCRCLo ^ __auchCRCHi[uIndex];
+        uchCRCLo = __auchCRCLo[uIndex] ;
+    }
+    return (uint16_t)(((uint16_t)uchCRCHi << 8) | (uint16_t)uchCRCLo) ;
+}
+static void WitRingDrop(wit_dev_t *p_stDev, uint32_t uiLen)
+{
+    p_stDev->uiDataHead = (p_stDev->uiDataHead + uiLen) & WIT_DATA_BUFF_MASK;
+    p_stDev->uiDataCnt -= uiLen;
+}
+/* consume every complete frame in the ring; a bad header or checksum only advances the head by one byte */
+static void WitParseRing(wit_dev_t *p_stDev)
 {
     uint16_t usCRC16, usTemp, i, usData[4];
-    uint8_t ucSum;
+    uint32_t uiFrameLen;
 
-    if(p_WitRegUpdateCbFunc == NULL)return ;
-    s_ucWitDataBuff[s_uiWitDataCnt++] = ucData;
-    switch(s_uiProtoclo)
+    switch(p_stDev->uiProtocol)
     {
         case WIT_PROTOCOL_NORMAL:
-            if(s_ucWitDataBuff[0] != 0x55)
-            {
-                s_uiWitDataCnt--;
-                memcpy(s_ucWitDataBuff, &s_ucWitDataBuff[1], s_uiWitDataCnt);
-                return ;
-            }
-            if(s_uiWitDataCnt >= 11)
+            while(p_stDev->uiDataCnt)
             {
-                ucSum = __CaliSum(s_ucWitDataBuff, 10);
-                if(ucSum != s_ucWitDataBuff[10])
+                if(WIT_RING_BYTE(p_stDev, 0) != 0x55)
                 {
-                    s_uiWitDataCnt--;
-                    memcpy(s_ucWitDataBuff, &s_ucWitDataBuff[1], s_uiWitDataCnt);
-                    return ;
+                    WitRingDrop(p_stDev, 1);
+                    continue;
                 }
-                usData[0] = ((uint16_t)s_ucWitDataBuff[3] << 8) | (uint16_t)s_ucWitDataBuff[2];
-                usData[1] = ((uint16_t)s_ucWitDataBuff[5] << 8) | (uint16_t)s_ucWitDataBuff[4];
-                usData[2] = ((uint16_t)s_ucWitDataBuff[7] << 8) | (uint16_t)s_ucWitDataBuff[6];
-                usData[3] = ((uint16_t)s_ucWitDataBuff[9] << 8) | (uint16_t)s_ucWitDataBuff[8];
-                CopeWitData(s_ucWitDataBuff[1], usData, 4);
-                s_uiWitDataCnt = 0;
+                if(p_stDev->uiDataCnt < 11)break;
+                if(__CaliSumRing(p_stDev, 10) != WIT_RING_BYTE(p_stDev, 10))
+                {
+                    WitRingDrop(p_stDev, 1);
+                    continue;
+                }
+                usData[0] = ((uint16_t)WIT_RING_BYTE(p_stDev, 3) << 8) | (uint16_t)WIT_RING_BYTE(p_stDev, 2);
+                usData[1] = ((uint16_t)WIT_RING_BYTE(p_stDev, 5) << 8) | (uint16_t)WIT_RING_BYTE(p_stDev, 4);
+                usData[2] = ((uint16_t)WIT_RING_BYTE(p_stDev, 7) << 8) | (uint16_t)WIT_RING_BYTE(p_stDev, 6);
+                usData[3] = ((uint16_t)WIT_RING_BYTE(p_stDev, 9) << 8) | (uint16_t)WIT_RING_BYTE(p_stDev, 8);
+                CopeWitData(p_stDev, WIT_RING_BYTE(p_stDev, 1), usData, 4);
+                WitRingDrop(p_stDev, 11);
             }
         break;
         case WIT_PROTOCOL_MODBUS:
-            if(s_uiWitDataCnt > 2)
+            while(p_stDev->uiDataCnt > 2)
             {
-                if(s_ucWitDataBuff[1] != FuncR)
+                uiFrameLen = (uint32_t)WIT_RING_BYTE(p_stDev, 2) + 5;
+                if(WIT_RING_BYTE(p_stDev, 1) != FuncR || uiFrameLen > WIT_DATA_BUFF_SIZE)
                 {
-                    s_uiWitDataCnt--;
-                    memcpy(s_ucWitDataBuff, &s_ucWitDataBuff[1], s_uiWitDataCnt);
-                    return ;
+                    WitRingDrop(p_stDev, 1);
+                    continue;
                 }
-                if(s_uiWitDataCnt < (s_ucWitDataBuff[2] + 5))return ;
-                usTemp = ((uint16_t)s_ucWitDataBuff[s_uiWitDataCnt-2] << 8) | s_ucWitDataBuff[s_uiWitDataCnt-1];
-                usCRC16 = __CRC16(s_ucWitDataBuff, s_uiWitDataCnt-2);
+                if(p_stDev->uiDataCnt < uiFrameLen)break;
+                usTemp = ((uint16_t)WIT_RING_BYTE(p_stDev, uiFrameLen-2) << 8) | WIT_RING_BYTE(p_stDev, uiFrameLen-1);
+                usCRC16 = __CRC16Ring(p_stDev, uiFrameLen-2);
                 if(usTemp != usCRC16)
                 {
-                    s_uiWitDataCnt--;
-                    memcpy(s_ucWitDataBuff, &s_ucWitDataBuff[1], s_uiWitDataCnt);
-                    return ;
+                    WitRingDrop(p_stDev, 1);
+                    continue;
                 }
-                usTemp = s_ucWitDataBuff[2] >> 1;
+                usTemp = WIT_RING_BYTE(p_stDev, 2) >> 1;
                 for(i = 0; i < usTemp; i++)
                 {
-                    sReg[i+s_uiReadRegIndex] = ((uint16_t)s_ucWitDataBuff[(i<<1)+3] << 8) | s_ucWitDataBuff[(i<<1)+4];
+                    p_stDev->p_sReg[i+p_stDev->uiReadRegIndex] = ((uint16_t)WIT_RING_BYTE(p_stDev, (i<<1)+3) << 8) | WIT_RING_BYTE(p_stDev, (i<<1)+4);
                 }
-                p_WitRegUpdateCbFunc(s_uiReadRegIndex, usTemp);
-                s_uiWitDataCnt = 0;
+                p_stDev->p_RegUpdateCbFunc(p_stDev->uiReadRegIndex, usTemp);
+                WitRingDrop(p_stDev, uiFrameLen);
             }
         break;
         case WIT_PROTOCOL_CAN:
         case WIT_PROTOCOL_I2C:
-        s_uiWitDataCnt = 0;
+        default:
+            WitRingDrop(p_stDev, p_stDev->uiDataCnt);
         break;
     }
-    if(s_uiWitDataCnt == WIT_DATA_BUFF_SIZE)s_uiWitDataCnt = 0;
 }
-int32_t WitI2cFuncRegister(WitI2cWrite write_func, WitI2cRead read_func)
+
+int32_t WitDevSerialWriteRegister(wit_dev_t *p_stDev, SerialWrite Write_func)
+{
+    if(!p_stDev)return WIT_HAL_INVAL;
+    if(!Write_func)return WIT_HAL_INVAL;
+    p_stDev->p_SerialWriteFunc = Write_func;
+    return WIT_HAL_OK;
+}
+void WitDevSerialDataInBlock(wit_dev_t *p_stDev, const uint8_t *p_ucData, uint32_t uiLen)
+{
+    uint32_t uiTail, uiChunk, uiFirst;
+
+    if(p_stDev == NULL || p_ucData == NULL)return ;
+    if(p_stDev->p_RegUpdateCbFunc == NULL)return ;
+    while(uiLen)
+    {
+        /* the parser always leaves room: a full ring cannot hold a pending valid frame */
+        uiChunk = WIT_DATA_BUFF_SIZE - p_stDev->uiDataCnt;
+        if(uiChunk > uiLen)uiChunk = uiLen;
+        uiTail = (p_stDev->uiDataHead + p_stDev->uiDataCnt) & WIT_DATA_BUFF_MASK;
+        uiFirst = WIT_DATA_BUFF_SIZE - uiTail;
+        if(uiFirst > uiChunk)uiFirst = uiChunk;
+        memcpy(&p_stDev->ucDataBuff[uiTail], p_ucData, uiFirst);
+        if(uiChunk > uiFirst)memcpy(p_stDev->ucDataBuff, p_ucData + uiFirst, uiChunk - uiFirst);
+        p_stDev->uiDataCnt += uiChunk;
+        p_ucData += uiChunk;
+        uiLen -= uiChunk;
+        WitParseRing(p_stDev);
+    }
+}
+void WitDevSerialDataIn(wit_dev_t *p_stDev, uint8_t ucData)
+{
+    WitDevSerialDataInBlock(p_stDev, &ucData, 1);
+}
+int32_t WitDevI2cFuncRegister(wit_dev_t *p_stDev, WitI2cWrite write_func, WitI2cRead read_func)
 {
+    if(!p_stDev)return WIT_HAL_INVAL;
     if(!write_func)return WIT_HAL_INVAL;
     if(!read_func)return WIT_HAL_INVAL;
-    p_WitI2cWriteFunc = write_func;
-    p_WitI2cReadFunc = read_func;
+    p_stDev->p_I2cWriteFunc = write_func;
+    p_stDev->p_I2cReadFunc = read_func;
     return WIT_HAL_OK;
 }
-int32_t WitCanWriteRegister(CanWrite Write_func)
+int32_t WitDevCanWriteRegister(wit_dev_t *p_stDev, CanWrite Write_func)
 {
+    if(!p_stDev)return WIT_HAL_INVAL;
     if(!Write_func)return WIT_HAL_INVAL;
-    p_WitCanWriteFunc = Write_func;
+    p_stDev->p_CanWriteFunc = Write_func;
     return WIT_HAL_OK;
 }
-void WitCanDataIn(uint8_t ucData[8], uint8_t ucLen)
+void WitDevCanDataIn(wit_dev_t *p_stDev, uint8_t ucData[8], uint8_t ucLen)
 {
 	uint16_t usData[3];
-    if(p_WitRegUpdateCbFunc == NULL)return ;
+    if(p_stDev == NULL)return ;
+    if(p_stDev->p_RegUpdateCbFunc == NULL)return ;
     if(ucLen < 8)return ;
-    switch(s_uiProtoclo)
+    switch(p_stDev->uiProtocol)
     {
         case WIT_PROTOCOL_CAN:
             if(ucData[0] != 0x55)return ;
             usData[0] = ((uint16_t)ucData[3] << 8) | ucData[2];
             usData[1] = ((uint16_t)ucData[5] << 8) | ucData[4];
             usData[2] = ((uint16_t)ucData[7] << 8) | ucData[6];
-            CopeWitData(ucData[1], usData, 3);
+            CopeWitData(p_stDev, ucData[1], usData, 3);
             break;
         case WIT_PROTOCOL_NORMAL:
         case WIT_PROTOCOL_MODBUS:
@@ -230,31 +271,33 @@ void WitCanDataIn(uint8_t ucData[8], uint8_t ucLen)
             break;
     }
 }
-int32_t WitRegisterCallBack(RegUpdateCb update_func)
+int32_t WitDevRegisterCallBack(wit_dev_t *p_stDev, RegUpdateCb update_func)
 {
+    if(!p_stDev)return WIT_HAL_INVAL;
     if(!update_func)return WIT_HAL_INVAL;
-    p_WitRegUpdateCbFunc = update_func;
+    p_stDev->p_RegUpdateCbFunc = update_func;
     return WIT_HAL_OK;
 }
-int32_t WitWriteReg(uint32_t uiReg, uint16_t usData)
+int32_t WitDevWriteReg(wit_dev_t *p_stDev, uint32_t uiReg, uint16_t usData)
 {
     uint16_t usCRC;
     uint8_t ucBuff[8];
+    if(!p_stDev)return WIT_HAL_INVAL;
     if(uiReg >= REGSIZE)return WIT_HAL_INVAL;
-    switch(s_uiProtoclo)
+    switch(p_stDev->uiProtocol)
     {
         case WIT_PROTOCOL_NORMAL:
-            if(p_WitSerialWriteFunc == NULL)return WIT_HAL_EMPTY;
+            if(p_stDev->p_SerialWriteFunc == NULL)return WIT_HAL_EMPTY;
             ucBuff[0] = 0xFF;
             ucBuff[1] = 0xAA;
             ucBuff[2] = uiReg & 0xFF;
             ucBuff[3] = usData & 0xff;
             ucBuff[4] = usData >> 8;
-            p_WitSerialWriteFunc(ucBuff, 5);
+            p_stDev->p_SerialWriteFunc(ucBuff, 5);
             break;
         case WIT_PROTOCOL_MODBUS:
-            if(p_WitSerialWriteFunc == NULL)return WIT_HAL_EMPTY;
-            ucBuff[0] = s_ucAddr;
+            if(p_stDev->p_SerialWriteFunc == NULL)return WIT_HAL_EMPTY;
+            ucBuff[0] = p_stDev->ucAddr;
             ucBuff[1] = FuncW;
             ucBuff[2] = uiReg >> 8;
             ucBuff[3] = uiReg & 0xFF;
@@ -263,24 +306,24 @@ int32_t WitWriteReg(uint32_t uiReg, uint16_t usData)
             usCRC = __CRC16(ucBuff, 6);
             ucBuff[6] = usCRC >> 8;
             ucBuff[7] = usCRC & 0xff;
-            p_WitSerialWriteFunc(ucBuff, 8);
+            p_stDev->p_SerialWriteFunc(ucBuff, 8);
             break;
         case WIT_PROTOCOL_CAN:
-            if(p_WitCanWriteFunc == NULL)return WIT_HAL_EMPTY;
+            if(p_stDev->p_CanWriteFunc == NULL)return WIT_HAL_EMPTY;
             ucBuff[0] = 0xFF;
             ucBuff[1] = 0xAA;
             ucBuff[2] = uiReg & 0xFF;
             ucBuff[3] = usData & 0xff;
             ucBuff[4] = usData >> 8;
-            p_WitCanWriteFunc(s_ucAddr, ucBuff, 5);
+            p_stDev->p_CanWriteFunc(p_stDev->ucAddr, ucBuff, 5);
             break;
         case WIT_PROTOCOL_I2C:
-            if(p_WitI2cWriteFunc == NULL)return WIT_HAL_EMPTY;
+            if(p_stDev->p_I2cWriteFunc == NULL)return WIT_HAL_EMPTY;
             ucBuff[0] = usData & 0xff;
             ucBuff[1] = usData >> 8;
-			if(p_WitI2cWriteFunc(s_ucAddr << 1, uiReg, ucBuff, 2) != 1)
+			if(p_stDev->p_I2cWriteFunc(p_stDev->ucAddr << 1, uiReg, ucBuff, 2) != 1)
 			{
-				//printf("i2c write fail\r\n");
+				return WIT_HAL_ERROR;
 			}
         break;
 	default: 
@@ -288,28 +331,29 @@ int32_t WitWriteReg(uint32_t uiReg, uint16_t usData)
     }
     return WIT_HAL_OK;
 }
-int32_t WitReadReg(uint32_t uiReg, uint32_t uiReadNum)
+int32_t WitDevReadReg(wit_dev_t *p_stDev, uint32_t uiReg, uint32_t uiReadNum)
 {
     uint16_t usTemp, i;
     uint8_t ucBuff[8];
+    if(!p_stDev)return WIT_HAL_INVAL;
     if((uiReg + uiReadNum) >= REGSIZE)return WIT_HAL_INVAL;
-    switch(s_uiProtoclo)
+    switch(p_stDev->uiProtocol)
     {
         case WIT_PROTOCOL_NORMAL:
             if(uiReadNum > 4)return WIT_HAL_INVAL;
-            if(p_WitSerialWriteFunc == NULL)return WIT_HAL_EMPTY;
+            if(p_stDev->p_SerialWriteFunc == NULL)return WIT_HAL_EMPTY;
             ucBuff[0] = 0xFF;
             ucBuff[1] = 0xAA;
             ucBuff[2] = 0x27;
             ucBuff[3] = uiReg & 0xff;
             ucBuff[4] = uiReg >> 8;
-            p_WitSerialWriteFunc(ucBuff, 5);
+            p_stDev->p_SerialWriteFunc(ucBuff, 5);
             break;
         case WIT_PROTOCOL_MODBUS:
-            if(p_WitSerialWriteFunc == NULL)return WIT_HAL_EMPTY;
+            if(p_stDev->p_SerialWriteFunc == NULL)return WIT_HAL_EMPTY;
             usTemp = uiReadNum << 1;
             if((usTemp + 5) > WIT_DATA_BUFF_SIZE)return WIT_HAL_NOMEM;
-            ucBuff[0] = s_ucAddr;
+            ucBuff[0] = p_stDev->ucAddr;
             ucBuff[1] = FuncR;
             ucBuff[2] = uiReg >> 8;
             ucBuff[3] = uiReg & 0xFF;
@@ -318,64 +362,133 @@ int32_t WitReadReg(uint32_t uiReg, uint32_t uiReadNum)
             usTemp = __CRC16(ucBuff, 6);
             ucBuff[6] = usTemp >> 8;
             ucBuff[7] = usTemp & 0xff;
-            p_WitSerialWriteFunc(ucBuff, 8);
+            p_stDev->p_SerialWriteFunc(ucBuff, 8);
             break;
         case WIT_PROTOCOL_CAN:
             if(uiReadNum > 3)return WIT_HAL_INVAL;
-            if(p_WitCanWriteFunc == NULL)return WIT_HAL_EMPTY;
+            if(p_stDev->p_CanWriteFunc == NULL)return WIT_HAL_EMPTY;
             ucBuff[0] = 0xFF;
             ucBuff[1] = 0xAA;
             ucBuff[2] = 0x27;
             ucBuff[3] = uiReg & 0xff;
             ucBuff[4] = uiReg >> 8;
-            p_WitCanWriteFunc(s_ucAddr, ucBuff, 5);
+            p_stDev->p_CanWriteFunc(p_stDev->ucAddr, ucBuff, 5);
             break;
         case WIT_PROTOCOL_I2C:
-            if(p_WitI2cReadFunc == NULL)return WIT_HAL_EMPTY;
+            if(p_stDev->p_I2cReadFunc == NULL)return WIT_HAL_EMPTY;
             usTemp = uiReadNum << 1;
             if(WIT_DATA_BUFF_SIZE < usTemp)return WIT_HAL_NOMEM;
-            if(p_WitI2cReadFunc(s_ucAddr << 1, uiReg, s_ucWitDataBuff, usTemp) == 1)
+            if(p_stDev->p_I2cReadFunc(p_stDev->ucAddr << 1, uiReg, p_stDev->ucDataBuff, usTemp) == 1)
             {
-                if(p_WitRegUpdateCbFunc == NULL)return WIT_HAL_EMPTY;
+                if(p_stDev->p_RegUpdateCbFunc == NULL)return WIT_HAL_EMPTY;
                 for(i = 0; i < uiReadNum; i++)
                 {
-                    sReg[i+uiReg] = ((uint16_t)s_ucWitDataBuff[(i<<1)+1] << 8) | s_ucWitDataBuff[i<<1];
+                    p_stDev->p_sReg[i+uiReg] = ((uint16_t)p_stDev->ucDataBuff[(i<<1)+1] << 8) | p_stDev->ucDataBuff[i<<1];
                 }
-                p_WitRegUpdateCbFunc(uiReg, uiReadNum);
+                p_stDev->p_RegUpdateCbFunc(uiReg, uiReadNum);
             }
-			
+            else return WIT_HAL_ERROR;
             break;
 		default: 
             return WIT_HAL_INVAL;
     }
-    s_uiReadRegIndex = uiReg;
+    p_stDev->uiReadRegIndex = uiReg;
 
     return WIT_HAL_OK;
 }
-int32_t WitInit(uint32_t uiProtocol, uint8_t ucAddr)
+int32_t WitDevI2cAsyncFuncRegister(wit_dev_t *p_stDev, WitI2cReadAsync read_func)
+{
+    if(!p_stDev)return WIT_HAL_INVAL;
+    if(!read_func)return WIT_HAL_INVAL;
+    p_stDev->p_I2cReadAsyncFunc = read_func;
+    return WIT_HAL_OK;
+}
+int32_t WitDevReadDoneRegister(wit_dev_t *p_stDev, WitReadDoneCb done_func)
+{
+    if(!p_stDev)return WIT_HAL_INVAL;
+    if(!done_func)return WIT_HAL_INVAL;
+    p_stDev->p_ReadDoneCbFunc = done_func;
+    return WIT_HAL_OK;
+}
+/* called by the port from the bus completion interrupt */
+static void WitDevI2cReadDone(void *p_ctx, int32_t iResult)
+{
+    wit_dev_t *p_stDev = (wit_dev_t *)p_ctx;
+    uint32_t i, uiReg = p_stDev->uiAsyncReg, uiReadNum = p_stDev->uiAsyncNum;
+
+    if(iResult == WIT_HAL_OK)
+    {
+        for(i = 0; i < uiReadNum; i++)
+        {
+            p_stDev->p_sReg[i+uiReg] = ((uint16_t)p_stDev->ucDataBuff[(i<<1)+1] << 8) | p_stDev->ucDataBuff[i<<1];
+        }
+    }
+    /* release before the callbacks so they may chain the next read */
+    p_stDev->ucAsyncBusy = 0;
+    if(iResult == WIT_HAL_OK)p_stDev->p_RegUpdateCbFunc(uiReg, uiReadNum);
+    if(p_stDev->p_ReadDoneCbFunc != NULL)p_stDev->p_ReadDoneCbFunc(uiReg, uiReadNum, iResult);
+}
+int32_t WitDevReadRegAsync(wit_dev_t *p_stDev, uint32_t uiReg, uint32_t uiReadNum)
+{
+    if(!p_stDev)return WIT_HAL_INVAL;
+    if((uiReg + uiReadNum) >= REGSIZE)return WIT_HAL_INVAL;
+    if(p_stDev->uiProtocol != WIT_PROTOCOL_I2C)return WIT_HAL_INVAL;
+    if(p_stDev->p_I2cReadAsyncFunc == NULL)return WIT_HAL_EMPTY;
+    if(p_stDev->p_RegUpdateCbFunc == NULL)return WIT_HAL_EMPTY;
+    if(WIT_DATA_BUFF_SIZE < (uiReadNum << 1))return WIT_HAL_NOMEM;
+    if(p_stDev->ucAsyncBusy)return WIT_HAL_BUSY;
+
+    p_stDev->ucAsyncBusy = 1;
+    p_stDev->uiAsyncReg = uiReg;
+    p_stDev->uiAsyncNum = uiReadNum;
+    p_stDev->uiReadRegIndex = uiReg;
+    if(p_stDev->p_I2cReadAsyncFunc(p_stDev->ucAddr << 1, uiReg, p_stDev->ucDataBuff, uiReadNum << 1,
+                                   WitDevI2cReadDone, p_stDev) != 1)
+    {
+        p_stDev->ucAsyncBusy = 0;
+        return WIT_HAL_BUSY;
+    }
+    return WIT_HAL_OK;
+}
+uint8_t WitDevReadRegBusy(wit_dev_t *p_stDev)
+{
+    if(!p_stDev)return 0;
+    return p_stDev->ucAsyncBusy;
+}
+int32_t WitDevInit(wit_dev_t *p_stDev, int16_t *p_sReg, uint32_t uiProtocol, uint8_t ucAddr)
 {
+    if(!p_stDev)return WIT_HAL_INVAL;
+    if(!p_sReg)return WIT_HAL_INVAL;
 	if(uiProtocol > WIT_PROTOCOL_I2C)return WIT_HAL_INVAL;
-    s_uiProtoclo = uiProtocol;
-    s_ucAddr = ucAddr;
-    s_uiWitDataCnt = 0;
+    p_stDev->p_sReg = p_sReg;
+    p_stDev->uiProtocol = uiProtocol;
+    p_stDev->ucAddr = ucAddr;
+    p_stDev->uiDataHead = 0;
+    p_stDev->uiDataCnt = 0;
     return WIT_HAL_OK;
 }
-void WitDeInit(void)
+void WitDevDeInit(wit_dev_t *p_stDev)
 {
-    p_WitSerialWriteFunc = NULL;
-    p_WitI2cWriteFunc = NULL;
-    p_WitI2cReadFunc = NULL;
-    p_WitCanWriteFunc = NULL;
-    p_WitRegUpdateCbFunc = NULL;
-    s_ucAddr = 0xff;
-    s_uiWitDataCnt = 0;
-    s_uiProtoclo = 0;
+    if(!p_stDev)return ;
+    p_stDev->p_SerialWriteFunc = NULL;
+    p_stDev->p_I2cWriteFunc = NULL;
+    p_stDev->p_I2cReadFunc = NULL;
+    p_stDev->p_CanWriteFunc = NULL;
+    p_stDev->p_RegUpdateCbFunc = NULL;
+    p_stDev->p_I2cReadAsyncFunc = NULL;
+    p_stDev->p_ReadDoneCbFunc = NULL;
+    p_stDev->ucAsyncBusy = 0;
+    p_stDev->ucAddr = 0xff;
+    p_stDev->uiDataHead = 0;
+    p_stDev->uiDataCnt = 0;
+    p_stDev->uiProtocol = 0;
 }
 
-int32_t WitDelayMsRegister(DelaymsCb delayms_func)
+int32_t WitDevDelayMsRegister(wit_dev_t *p_stDev, DelaymsCb delayms_func)
 {
+    if(!p_stDev)return WIT_HAL_INVAL;
     if(!delayms_func)return WIT_HAL_INVAL;
-    p_WitDelaymsFunc = delayms_func;
+    p_stDev->p_DelaymsFunc = delayms_func;
     return WIT_HAL_OK;
 }
 
@@ -384,119 +497,304 @@ char CheckRange(short sTemp,short sMin,short sMax)
     if ((sTemp>=sMin)&&(sTemp<=sMax)) return 1;
     else return 0;
 }
+/* protocol dependent settle time after an unlock or mode write */
+static void WitDevProtocolDelay(wit_dev_t *p_stDev)
+{
+	if(p_stDev->uiProtocol == WIT_PROTOCOL_MODBUS)	p_stDev->p_DelaymsFunc(20);
+	else if(p_stDev->uiProtocol == WIT_PROTOCOL_NORMAL) p_stDev->p_DelaymsFunc(1);
+}
 /*Acceleration calibration demo*/
-int32_t WitStartAccCali(void)
+int32_t WitDevStartAccCali(wit_dev_t *p_stDev)
 {
 /*
 	First place the equipment horizontally, and then perform the following operations
 */
-	if(WitWriteReg(KEY, KEY_UNLOCK) != WIT_HAL_OK)	    return  WIT_HAL_ERROR;// unlock reg
-	if(s_uiProtoclo == WIT_PROTOCOL_MODBUS)	p_WitDelaymsFunc(20);
-	else if(s_uiProtoclo == WIT_PROTOCOL_NORMAL) p_WitDelaymsFunc(1);
-	else ;
-	if(WitWriteReg(CALSW, CALGYROACC) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
+	if(WitDevWriteReg(p_stDev, KEY, KEY_UNLOCK) != WIT_HAL_OK)	    return  WIT_HAL_ERROR;// unlock reg
+	WitDevProtocolDelay(p_stDev);
+	if(WitDevWriteReg(p_stDev, CALSW, CALGYROACC) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
 	return WIT_HAL_OK;
 }
-int32_t WitStopAccCali(void)
+int32_t WitDevStopAccCali(wit_dev_t *p_stDev)
 {
-	if(WitWriteReg(CALSW, NORMAL) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
-	if(s_uiProtoclo == WIT_PROTOCOL_MODBUS)	p_WitDelaymsFunc(20);
-	else if(s_uiProtoclo == WIT_PROTOCOL_NORMAL) p_WitDelaymsFunc(1);
-	else ;
-	if(WitWriteReg(SAVE, SAVE_PARAM) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
+	if(WitDevWriteReg(p_stDev, CALSW, NORMAL) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
+	WitDevProtocolDelay(p_stDev);
+	if(WitDevWriteReg(p_stDev, SAVE, SAVE_PARAM) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
 	return WIT_HAL_OK;
 }
 /*Magnetic field calibration*/
-int32_t WitStartMagCali(void)
+int32_t WitDevStartMagCali(wit_dev_t *p_stDev)
 {
-	if(WitWriteReg(KEY, KEY_UNLOCK) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
-	if(s_uiProtoclo == WIT_PROTOCOL_MODBUS)	p_WitDelaymsFunc(20);
-	else if(s_uiProtoclo == WIT_PROTOCOL_NORMAL) p_WitDelaymsFunc(1);
-	else ;
-	if(WitWriteReg(CALSW, CALMAGMM) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
+	if(WitDevWriteReg(p_stDev, KEY, KEY_UNLOCK) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
+	WitDevProtocolDelay(p_stDev);
+	if(WitDevWriteReg(p_stDev, CALSW, CALMAGMM) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
 	return WIT_HAL_OK;
 }
-int32_t WitStopMagCali(void)
+int32_t WitDevStopMagCali(wit_dev_t *p_stDev)
 {
-	if(WitWriteReg(KEY, KEY_UNLOCK) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
-	if(s_uiProtoclo == WIT_PROTOCOL_MODBUS)	p_WitDelaymsFunc(20);
-	else if(s_uiProtoclo == WIT_PROTOCOL_NORMAL) p_WitDelaymsFunc(1);
-	else ;
-	if(WitWriteReg(CALSW, NORMAL) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
+	if(WitDevWriteReg(p_stDev, KEY, KEY_UNLOCK) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
+	WitDevProtocolDelay(p_stDev);
+	if(WitDevWriteReg(p_stDev, CALSW, NORMAL) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
 	return WIT_HAL_OK;
 }
 /*change Band*/
-int32_t WitSetUartBaud(int32_t uiBaudIndex)
+int32_t WitDevSetUartBaud(wit_dev_t *p_stDev, int32_t uiBaudIndex)
 {
 	if(!CheckRange(uiBaudIndex,WIT_BAUD_4800,WIT_BAUD_230400))
 	{
 		return WIT_HAL_INVAL;
 	}
-	if(WitWriteReg(KEY, KEY_UNLOCK) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
-	if(s_uiProtoclo == WIT_PROTOCOL_MODBUS)	p_WitDelaymsFunc(20);
-	else if(s_uiProtoclo == WIT_PROTOCOL_NORMAL) p_WitDelaymsFunc(1);
-	else ;
-	if(WitWriteReg(BAUD, uiBaudIndex) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
+	if(WitDevWriteReg(p_stDev, KEY, KEY_UNLOCK) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
+	WitDevProtocolDelay(p_stDev);
+	if(WitDevWriteReg(p_stDev, BAUD, uiBaudIndex) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
 	return WIT_HAL_OK;
 }
 /*change Can Band*/
-int32_t WitSetCanBaud(int32_t uiBaudIndex)
+int32_t WitDevSetCanBaud(wit_dev_t *p_stDev, int32_t uiBaudIndex)
 {
 	if(!CheckRange(uiBaudIndex,CAN_BAUD_1000000,CAN_BAUD_3000))
 	{
 		return WIT_HAL_INVAL;
 	}
-	if(WitWriteReg(KEY, KEY_UNLOCK) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
-	if(s_uiProtoclo == WIT_PROTOCOL_MODBUS)	p_WitDelaymsFunc(20);
-	else if(s_uiProtoclo == WIT_PROTOCOL_NORMAL) p_WitDelaymsFunc(1);
-	else ;
-	if(WitWriteReg(BAUD, uiBaudIndex) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
+	if(WitDevWriteReg(p_stDev, KEY, KEY_UNLOCK) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
+	WitDevProtocolDelay(p_stDev);
+	if(WitDevWriteReg(p_stDev, BAUD, uiBaudIndex) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
 	return WIT_HAL_OK;
 }
 /*change Bandwidth*/
-int32_t WitSetBandwidth(int32_t uiBaudWidth)
+int32_t WitDevSetBandwidth(wit_dev_t *p_stDev, int32_t uiBaudWidth)
 {	
 	if(!CheckRange(uiBaudWidth,BANDWIDTH_256HZ,BANDWIDTH_5HZ))
 	{
 		return WIT_HAL_INVAL;
 	}
-	if(WitWriteReg(KEY, KEY_UNLOCK) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
-	if(s_uiProtoclo == WIT_PROTOCOL_MODBUS)	p_WitDelaymsFunc(20);
-	else if(s_uiProtoclo == WIT_PROTOCOL_NORMAL) p_WitDelaymsFunc(1);
-	else ;
-	if(WitWriteReg(BANDWIDTH, uiBaudWidth) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
+	if(WitDevWriteReg(p_stDev, KEY, KEY_UNLOCK) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
+	WitDevProtocolDelay(p_stDev);
+	if(WitDevWriteReg(p_stDev, BANDWIDTH, uiBaudWidth) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
 	return WIT_HAL_OK;
 }
 
 /*change output rate */
-int32_t WitSetOutputRate(int32_t uiRate)
+int32_t WitDevSetOutputRate(wit_dev_t *p_stDev, int32_t uiRate)
 {	
 	if(!CheckRange(uiRate,RRATE_02HZ,RRATE_NONE))
 	{
 		return WIT_HAL_INVAL;
 	}
-	if(WitWriteReg(KEY, KEY_UNLOCK) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
-	if(s_uiProtoclo == WIT_PROTOCOL_MODBUS)	p_WitDelaymsFunc(20);
-	else if(s_uiProtoclo == WIT_PROTOCOL_NORMAL) p_WitDelaymsFunc(1);
-	else ;
-	if(WitWriteReg(RRATE, uiRate) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
+	if(WitDevWriteReg(p_stDev, KEY, KEY_UNLOCK) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
+	WitDevProtocolDelay(p_stDev);
+	if(WitDevWriteReg(p_stDev, RRATE, uiRate) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
 	return WIT_HAL_OK;
 }
 
 /*change WitSetContent */
-int32_t WitSetContent(int32_t uiRsw)
+int32_t WitDevSetContent(wit_dev_t *p_stDev, int32_t uiRsw)
 {	
 	if(!CheckRange(uiRsw,RSW_TIME,RSW_MASK))
 	{
 		return WIT_HAL_INVAL;
 	}
-	if(WitWriteReg(KEY, KEY_UNLOCK) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
-	if(s_uiProtoclo == WIT_PROTOCOL_MODBUS)	p_WitDelaymsFunc(20);
-	else if(s_uiProtoclo == WIT_PROTOCOL_NORMAL) p_WitDelaymsFunc(1);
-	else ;
-	if(WitWriteReg(RSW, uiRsw) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
+	if(WitDevWriteReg(p_stDev, KEY, KEY_UNLOCK) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
+	WitDevProtocolDelay(p_stDev);
+	if(WitDevWriteReg(p_stDev, RSW, uiRsw) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
 	return WIT_HAL_OK;
 }
 
+/* ---------------------------------------------------------------------------
+ * configuration transactions
+ * ------------------------------------------------------------------------- */
+int32_t WitCfgBegin(wit_cfg_txn_t *p_stTxn)
+{
+    if(!p_stTxn)return WIT_HAL_INVAL;
+    p_stTxn->ucCount = 0;
+    p_stTxn->ucWritten = 0;
+    return WIT_HAL_OK;
+}
+int32_t WitCfgStage(wit_cfg_txn_t *p_stTxn, uint32_t uiReg, uint16_t usVal)
+{
+    uint32_t i;
+    if(!p_stTxn)return WIT_HAL_INVAL;
+    if(uiReg >= REGSIZE || uiReg == KEY || uiReg == SAVE)return WIT_HAL_INVAL;
+    for(i = 0; i < p_stTxn->ucCount; i++)
+    {
+        if(p_stTxn->ucReg[i] == uiReg)     /* restaging a register keeps the last value */
+        {
+            p_stTxn->usVal[i] = usVal;
+            return WIT_HAL_OK;
+        }
+    }
+    if(p_stTxn->ucCount >= WIT_CFG_STAGE_MAX)return WIT_HAL_NOMEM;
+    p_stTxn->ucReg[p_stTxn->ucCount] = (uint8_t)uiReg;
+    p_stTxn->usVal[p_stTxn->ucCount] = usVal;
+    p_stTxn->ucCount++;
+    return WIT_HAL_OK;
+}
+/* refresh the shadow of the staged registers from an I2C sensor */
+static int32_t WitDevCfgReadBack(wit_dev_t *p_stDev, const wit_cfg_txn_t *p_stTxn)
+{
+    uint32_t i, uiMin = REGSIZE, uiMax = 0;
+    for(i = 0; i < p_stTxn->ucCount; i++)
+    {
+        if(p_stTxn->ucReg[i] < uiMin)uiMin = p_stTxn->ucReg[i];
+        if(p_stTxn->ucReg[i] > uiMax)uiMax = p_stTxn->ucReg[i];
+    }
+    /* one block read when the span fits the buffer, else one read per register */
+    if(((uiMax - uiMin + 1) << 1) <= WIT_DATA_BUFF_SIZE)
+    {
+        return WitDevReadReg(p_stDev, uiMin, uiMax - uiMin + 1);
+    }
+    for(i = 0; i < p_stTxn->ucCount; i++)
+    {
+        if(WitDevReadReg(p_stDev, p_stTxn->ucReg[i], 1) != WIT_HAL_OK)return WIT_HAL_ERROR;
+    }
+    return WIT_HAL_OK;
+}
+int32_t WitDevCfgCommit(wit_dev_t *p_stDev, wit_cfg_txn_t *p_stTxn, uint32_t uiFlags)
+{
+    uint8_t ucPending[WIT_CFG_STAGE_MAX];
+    uint32_t i, uiPending = 0;
+    uint8_t ucSkipSame;
+    if(!p_stDev || !p_stTxn)return WIT_HAL_INVAL;
+    if(p_stDev->p_DelaymsFunc == NULL)return WIT_HAL_EMPTY;
+    if(p_stDev->ucAsyncBusy)return WIT_HAL_BUSY;
+    p_stTxn->ucWritten = 0;
+
+    // only a fresh I2C read back is trusted; other shadows may be stale, so write everything
+    ucSkipSame = ((uiFlags & WIT_CFG_SKIP_SAME) && p_stDev->uiProtocol == WIT_PROTOCOL_I2C && p_stTxn->ucCount) ? 1 : 0;
+    if(ucSkipSame)
+    {
+        if(WitDevCfgReadBack(p_stDev, p_stTxn) != WIT_HAL_OK)return WIT_HAL_ERROR;
+    }
+    for(i = 0; i < p_stTxn->ucCount; i++)
+    {
+        if(ucSkipSame && (uint16_t)p_stDev->p_sReg[p_stTxn->ucReg[i]] == p_stTxn->usVal[i])continue;
+        ucPending[uiPending++] = (uint8_t)i;
+    }
+    if(uiPending == 0 && !(uiFlags & WIT_CFG_SAVE))return WIT_HAL_OK;
 
+    if(WitDevWriteReg(p_stDev, KEY, KEY_UNLOCK) != WIT_HAL_OK)	return  WIT_HAL_ERROR;// unlock once
+    for(i = 0; i < uiPending; i++)
+    {
+        WitDevProtocolDelay(p_stDev);
+        if(WitDevWriteReg(p_stDev, p_stTxn->ucReg[ucPending[i]], p_stTxn->usVal[ucPending[i]]) != WIT_HAL_OK)return WIT_HAL_ERROR;
+        p_stDev->p_sReg[p_stTxn->ucReg[ucPending[i]]] = (int16_t)p_stTxn->usVal[ucPending[i]];
+        p_stTxn->ucWritten++;
+    }
+    if(uiFlags & WIT_CFG_SAVE)
+    {
+        WitDevProtocolDelay(p_stDev);
+        if(WitDevWriteReg(p_stDev, SAVE, SAVE_PARAM) != WIT_HAL_OK)	return  WIT_HAL_ERROR;
+    }
+    return WIT_HAL_OK;
+}
 
+/* ---------------------------------------------------------------------------
+ * default instance wrappers, kept for single sensor applications
+ * ------------------------------------------------------------------------- */
+wit_dev_t *WitDefaultDev(void)
+{
+    return &s_stWitDev;
+}
+int32_t WitSerialWriteRegister(SerialWrite Write_func)
+{
+    return WitDevSerialWriteRegister(&s_stWitDev, Write_func);
+}
+void WitSerialDataIn(uint8_t ucData)
+{
+    WitDevSerialDataInBlock(&s_stWitDev, &ucData, 1);
+}
+void WitSerialDataInBlock(const uint8_t *p_ucData, uint32_t uiLen)
+{
+    WitDevSerialDataInBlock(&s_stWitDev, p_ucData, uiLen);
+}
+int32_t WitI2cFuncRegister(WitI2cWrite write_func, WitI2cRead read_func)
+{
+    return WitDevI2cFuncRegister(&s_stWitDev, write_func, read_func);
+}
+int32_t WitCanWriteRegister(CanWrite Write_func)
+{
+    return WitDevCanWriteRegister(&s_stWitDev, Write_func);
+}
+void WitCanDataIn(uint8_t ucData[8], uint8_t ucLen)
+{
+    WitDevCanDataIn(&s_stWitDev, ucData, ucLen);
+}
+int32_t WitRegisterCallBack(RegUpdateCb update_func)
+{
+    return WitDevRegisterCallBack(&s_stWitDev, update_func);
+}
+int32_t WitWriteReg(uint32_t uiReg, uint16_t usData)
+{
+    return WitDevWriteReg(&s_stWitDev, uiReg, usData);
+}
+int32_t WitReadReg(uint32_t uiReg, uint32_t uiReadNum)
+{
+    return WitDevReadReg(&s_stWitDev, uiReg, uiReadNum);
+}
+int32_t WitI2cAsyncFuncRegister(WitI2cReadAsync read_func)
+{
+    return WitDevI2cAsyncFuncRegister(&s_stWitDev, read_func);
+}
+int32_t WitReadDoneRegister(WitReadDoneCb done_func)
+{
+    return WitDevReadDoneRegister(&s_stWitDev, done_func);
+}
+int32_t WitReadRegAsync(uint32_t uiReg, uint32_t uiReadNum)
+{
+    return WitDevReadRegAsync(&s_stWitDev, uiReg, uiReadNum);
+}
+uint8_t WitReadRegBusy(void)
+{
+    return WitDevReadRegBusy(&s_stWitDev);
+}
+int32_t WitInit(uint32_t uiProtocol, uint8_t ucAddr)
+{
+    return WitDevInit(&s_stWitDev, sReg, uiProtocol, ucAddr);
+}
+void WitDeInit(void)
+{
+    WitDevDeInit(&s_stWitDev);
+}
+int32_t WitDelayMsRegister(DelaymsCb delayms_func)
+{
+    return WitDevDelayMsRegister(&s_stWitDev, delayms_func);
+}
+int32_t WitStartAccCali(void)
+{
+    return WitDevStartAccCali(&s_stWitDev);
+}
+int32_t WitStopAccCali(void)
+{
+    return WitDevStopAccCali(&s_stWitDev);
+}
+int32_t WitStartMagCali(void)
+{
+    return WitDevStartMagCali(&s_stWitDev);
+}
+int32_t WitStopMagCali(void)
+{
+    return WitDevStopMagCali(&s_stWitDev);
+}
+int32_t WitSetUartBaud(int32_t uiBaudIndex)
+{
+    return WitDevSetUartBaud(&s_stWitDev, uiBaudIndex);
+}
+int32_t WitSetCanBaud(int32_t uiBaudIndex)
+{
+    return WitDevSetCanBaud(&s_stWitDev, uiBaudIndex);
+}
+int32_t WitCfgCommit(wit_cfg_txn_t *p_stTxn, uint32_t uiFlags)
+{
+    return WitDevCfgCommit(&s_stWitDev, p_stTxn, uiFlags);
+}
+int32_t WitSetBandwidth(int32_t uiBaudWidth)
+{
+    return WitDevSetBandwidth(&s_stWitDev, uiBaudWidth);
+}
+int32_t WitSetOutputRate(int32_t uiRate)
+{
+    return WitDevSetOutputRate(&s_stWitDev, uiRate);
+}
+int32_t WitSetContent(int32_t uiRsw)
+{
+    return WitDevSetContent(&s_stWitDev, uiRsw);
+}
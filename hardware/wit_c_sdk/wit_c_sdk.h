@@ -19,7 +19,12 @@ extern "C" {
 #define WIT_HAL_EMPTY   (-5)    /**< The resource is empty */
 #define WIT_HAL_INVAL   (-6)    /**< Invalid argument */
 
-#define WIT_DATA_BUFF_SIZE  256
+#define WIT_DATA_BUFF_SIZE  256     /* serial receive ring, must be a power of two */
+#define WIT_DATA_BUFF_MASK  (WIT_DATA_BUFF_SIZE - 1)
+
+#if (WIT_DATA_BUFF_SIZE & WIT_DATA_BUFF_MASK) != 0
+#error "WIT_DATA_BUFF_SIZE must be a power of two"
+#endif
 
 #define WIT_PROTOCOL_NORMAL 0
 #define WIT_PROTOCOL_MODBUS 1
@@ -31,6 +36,8 @@ extern "C" {
 typedef void (*SerialWrite)(uint8_t *p_ucData, uint32_t uiLen);
 int32_t WitSerialWriteRegister(SerialWrite write_func);
 void WitSerialDataIn(uint8_t ucData);
+/* feed a whole receive chunk (e.g. a DMA half buffer); frames may straddle calls */
+void WitSerialDataInBlock(const uint8_t *p_ucData, uint32_t uiLen);
 
 /* iic function */
 
@@ -78,6 +85,14 @@ typedef int32_t (*WitI2cWrite)(uint8_t ucAddr, uint8_t ucReg, uint8_t *p_ucVal,
 */
 typedef int32_t (*WitI2cRead)(uint8_t ucAddr, uint8_t ucReg, uint8_t *p_ucVal, uint32_t uiLen);
 int32_t WitI2cFuncRegister(WitI2cWrite write_func, WitI2cRead read_func);
+/*
+    i2c async read: start a register burst (DMA or IT) and return at once,
+    return 1 if the transfer was started. The port must call
+    done_func(p_ctx, WIT_HAL_OK / WIT_HAL_ERROR) from its completion interrupt.
+*/
+typedef void (*WitI2cDoneCb)(void *p_ctx, int32_t iResult);
+typedef int32_t (*WitI2cReadAsync)(uint8_t ucAddr, uint8_t ucReg, uint8_t *p_ucVal, uint32_t uiLen, WitI2cDoneCb done_func, void *p_ctx);
+int32_t WitI2cAsyncFuncRegister(WitI2cReadAsync read_func);
 
 /* can function */
 typedef void (*CanWrite)(uint8_t ucStdId, uint8_t *p_ucData, uint32_t uiLen);
@@ -95,10 +110,119 @@ typedef void (*RegUpdateCb)(uint32_t uiReg, uint32_t uiRegNum);
 int32_t WitRegisterCallBack(RegUpdateCb update_func);
 int32_t WitWriteReg(uint32_t uiReg, uint16_t usData);
 int32_t WitReadReg(uint32_t uiReg, uint32_t uiReadNum);
+/* completion of WitReadRegAsync(), runs in the bus interrupt after RegUpdateCb */
+typedef void (*WitReadDoneCb)(uint32_t uiReg, uint32_t uiRegNum, int32_t iResult);
+int32_t WitReadDoneRegister(WitReadDoneCb done_func);
+int32_t WitReadRegAsync(uint32_t uiReg, uint32_t uiReadNum);
+uint8_t WitReadRegBusy(void);
 int32_t WitInit(uint32_t uiProtocol, uint8_t ucAddr);
 void WitDeInit(void);
 
 
+/*
+    multi-instance api
+
+    Every Wit* function above works on one built-in default device whose
+    register shadow is the global sReg. To run several sensors at once
+    (e.g. one JY61P on I2C1 and one on I2C2) give each its own wit_dev_t,
+    register shadow, bus functions and callback:
+
+    static int16_t s_sImu2Reg[REGSIZE];
+    static wit_dev_t s_stImu2;          // must start zeroed (static or memset)
+
+    WitDevInit(&s_stImu2, s_sImu2Reg, WIT_PROTOCOL_I2C, 0x50);
+    WitDevI2cFuncRegister(&s_stImu2, wit_port_i2c2_write, wit_port_i2c2_read);
+    WitDevRegisterCallBack(&s_stImu2, imu2_update);
+    WitDevReadReg(&s_stImu2, AX, 12);
+*/
+typedef struct
+{
+    SerialWrite p_SerialWriteFunc;
+    WitI2cWrite p_I2cWriteFunc;
+    WitI2cRead p_I2cReadFunc;
+    CanWrite p_CanWriteFunc;
+    RegUpdateCb p_RegUpdateCbFunc;
+    DelaymsCb p_DelaymsFunc;
+    WitI2cReadAsync p_I2cReadAsyncFunc;
+    WitReadDoneCb p_ReadDoneCbFunc;
+    int16_t *p_sReg;                /* register shadow, REGSIZE entries */
+    uint32_t uiProtocol;
+    uint32_t uiReadRegIndex;
+    uint32_t uiDataHead;            /* serial receive ring read index */
+    uint32_t uiDataCnt;             /* bytes queued in the ring */
+    uint32_t uiAsyncReg;            /* register block of the read in flight */
+    uint32_t uiAsyncNum;
+    volatile uint8_t ucAsyncBusy;
+    uint8_t ucAddr;
+    uint8_t ucDataBuff[WIT_DATA_BUFF_SIZE];
+} wit_dev_t;
+
+wit_dev_t *WitDefaultDev(void);
+int32_t WitDevInit(wit_dev_t *p_stDev, int16_t *p_sReg, uint32_t uiProtocol, uint8_t ucAddr);
+void WitDevDeInit(wit_dev_t *p_stDev);
+int32_t WitDevSerialWriteRegister(wit_dev_t *p_stDev, SerialWrite write_func);
+void WitDevSerialDataIn(wit_dev_t *p_stDev, uint8_t ucData);
+void WitDevSerialDataInBlock(wit_dev_t *p_stDev, const uint8_t *p_ucData, uint32_t uiLen);
+int32_t WitDevI2cFuncRegister(wit_dev_t *p_stDev, WitI2cWrite write_func, WitI2cRead read_func);
+int32_t WitDevCanWriteRegister(wit_dev_t *p_stDev, CanWrite write_func);
+void WitDevCanDataIn(wit_dev_t *p_stDev, uint8_t ucData[8], uint8_t ucLen);
+int32_t WitDevDelayMsRegister(wit_dev_t *p_stDev, DelaymsCb delayms_func);
+int32_t WitDevRegisterCallBack(wit_dev_t *p_stDev, RegUpdateCb update_func);
+int32_t WitDevWriteReg(wit_dev_t *p_stDev, uint32_t uiReg, uint16_t usData);
+int32_t WitDevReadReg(wit_dev_t *p_stDev, uint32_t uiReg, uint32_t uiReadNum);
+int32_t WitDevI2cAsyncFuncRegister(wit_dev_t *p_stDev, WitI2cReadAsync read_func);
+int32_t WitDevReadDoneRegister(wit_dev_t *p_stDev, WitReadDoneCb done_func);
+int32_t WitDevReadRegAsync(wit_dev_t *p_stDev, uint32_t uiReg, uint32_t uiReadNum);
+uint8_t WitDevReadRegBusy(wit_dev_t *p_stDev);
+
+int32_t WitDevStartAccCali(wit_dev_t *p_stDev);
+int32_t WitDevStopAccCali(wit_dev_t *p_stDev);
+int32_t WitDevStartMagCali(wit_dev_t *p_stDev);
+int32_t WitDevStopMagCali(wit_dev_t *p_stDev);
+int32_t WitDevSetUartBaud(wit_dev_t *p_stDev, int32_t uiBaudIndex);
+int32_t WitDevSetBandwidth(wit_dev_t *p_stDev, int32_t uiBaudWidth);
+int32_t WitDevSetOutputRate(wit_dev_t *p_stDev, int32_t uiRate);
+int32_t WitDevSetContent(wit_dev_t *p_stDev, int32_t uiRsw);
+int32_t WitDevSetCanBaud(wit_dev_t *p_stDev, int32_t uiBaudIndex);
+
+/*
+    configuration transactions
+
+    Each WitDevSet* helper above unlocks the sensor, waits and writes one
+    register. A transaction stages several register values and commits them
+    behind a single unlock, optionally followed by SAVE:
+
+    wit_cfg_txn_t stTxn;
+
+    WitCfgBegin(&stTxn);
+    WitCfgStage(&stTxn, BANDWIDTH, BANDWIDTH_42HZ);
+    WitCfgStage(&stTxn, RRATE, RRATE_100HZ);
+    WitDevCfgCommit(p_stDev, &stTxn, WIT_CFG_SKIP_SAME | WIT_CFG_SAVE);
+
+    With WIT_CFG_SKIP_SAME on I2C, the staged registers are read back first
+    and values equal to what the sensor returned are not written. If nothing
+    differs and SAVE is not requested, the commit touches the bus only for
+    that read back. Other protocols cannot read back synchronously, so the
+    flag is ignored there and every staged register is written.
+*/
+#define WIT_CFG_STAGE_MAX   8       /* registers per transaction */
+
+#define WIT_CFG_SAVE        0x01    /* write SAVE_PARAM after the staged registers */
+#define WIT_CFG_SKIP_SAME   0x02    /* I2C only: skip registers whose read back value already matches */
+
+typedef struct
+{
+    uint8_t ucCount;                        /* staged registers */
+    uint8_t ucWritten;                      /* registers written by the last commit */
+    uint8_t ucReg[WIT_CFG_STAGE_MAX];
+    uint16_t usVal[WIT_CFG_STAGE_MAX];
+} wit_cfg_txn_t;
+
+int32_t WitCfgBegin(wit_cfg_txn_t *p_stTxn);
+int32_t WitCfgStage(wit_cfg_txn_t *p_stTxn, uint32_t uiReg, uint16_t usVal);
+int32_t WitDevCfgCommit(wit_dev_t *p_stDev, wit_cfg_txn_t *p_stTxn, uint32_t uiFlags);
+
+
 
 /**
   ******************************************************************************
@@ -123,6 +247,7 @@ int32_t WitSetBandwidth(int32_t uiBaudWidth);
 int32_t WitSetOutputRate(int32_t uiRate);
 int32_t WitSetContent(int32_t uiRsw);
 int32_t WitSetCanBaud(int32_t uiBaudIndex);
+int32_t WitCfgCommit(wit_cfg_txn_t *p_stTxn, uint32_t uiFlags);
 
 char CheckRange(short sTemp,short sMin,short sMax);
 
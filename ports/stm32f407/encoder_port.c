@@ -0,0 +1,200 @@
+/**
+ * @file encoder_port.c
+ * @brief STM32F407正交编码器端口层实现
+ * @details 左轮TIM2为32位计数器，右轮TIM3为16位计数器，增量按各自位宽取有符号差值。
+ *          编码器模式下CC1仍可捕获: TI1上升沿把当时的CNT锁存到CCR1并产生CC1中断。
+ * @date 2026-10-16
+ */
+
+#include "encoder_port.h"
+#include "stm32f407_port_config.h"
+
+/* ========================================================================== */
+/*                              私有类型与变量                                */
+/* ========================================================================== */
+
+/**
+ * @brief 单路编码器状态
+ * @note edge_*由边沿中断写入，采样时用edge_seq检测读取过程中是否被更新
+ */
+typedef struct {
+    TIM_HandleTypeDef *htim;        /* 编码器定时器句柄 */
+    uint32_t mask;                  /* 计数器位宽掩码 */
+    int32_t sign;                   /* 计数方向 */
+    uint32_t last_cnt;              /* 上次采样的计数 */
+    volatile uint32_t edge_seq;     /* 边沿序号 (每次边沿加1) */
+    volatile uint32_t edge_cnt;     /* 最近一次边沿的CCR1 */
+    volatile uint32_t edge_cycles;  /* 最近一次边沿的DWT时间 */
+} encoder_port_chan_t;
+
+static encoder_port_chan_t s_enc[ENCODER_PORT_NUM] = {
+    { &ENCODER_LEFT_HANDLE,  0xFFFFFFFFUL, ENCODER_LEFT_SIGN,  0, 0, 0, 0 },
+    { &ENCODER_RIGHT_HANDLE, 0x0000FFFFUL, ENCODER_RIGHT_SIGN, 0, 0, 0, 0 },
+};
+
+/* ========================================================================== */
+/*                              私有函数声明                                  */
+/* ========================================================================== */
+
+static int32_t encoder_port_diff(const encoder_port_chan_t *ch, uint32_t a, uint32_t b);
+
+/* ========================================================================== */
+/*                              公共函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 启动左右轮编码器计数
+ */
+int32_t encoder_port_init(void)
+{
+    uint8_t i;
+
+    /* 已启动的定时器再次Start会返回HAL_ERROR，先停止使重复调用等同于重新启动 */
+    encoder_port_deinit();
+
+    if (HAL_TIM_Encoder_Start(&ENCODER_LEFT_HANDLE, TIM_CHANNEL_ALL) != HAL_OK) {
+        return -1;
+    }
+    if (HAL_TIM_Encoder_Start(&ENCODER_RIGHT_HANDLE, TIM_CHANNEL_ALL) != HAL_OK) {
+        HAL_TIM_Encoder_Stop(&ENCODER_LEFT_HANDLE, TIM_CHANNEL_ALL);
+        return -1;
+    }
+
+    for (i = 0; i < ENCODER_PORT_NUM; i++) {
+        __HAL_TIM_DISABLE_IT(s_enc[i].htim, TIM_IT_CC1);
+        s_enc[i].last_cnt = s_enc[i].htim->Instance->CNT & s_enc[i].mask;
+        s_enc[i].edge_cnt = s_enc[i].last_cnt;
+        s_enc[i].edge_cycles = DWT->CYCCNT;
+    }
+
+    HAL_NVIC_SetPriority(ENCODER_LEFT_IRQn, ENCODER_EDGE_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(ENCODER_LEFT_IRQn);
+    HAL_NVIC_SetPriority(ENCODER_RIGHT_IRQn, ENCODER_EDGE_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(ENCODER_RIGHT_IRQn);
+
+    return 0;
+}
+
+/**
+ * @brief 停止编码器计数和边沿捕获
+ */
+void encoder_port_deinit(void)
+{
+    encoder_port_set_edge_capture(ENCODER_PORT_LEFT, 0);
+    encoder_port_set_edge_capture(ENCODER_PORT_RIGHT, 0);
+    HAL_TIM_Encoder_Stop(&ENCODER_LEFT_HANDLE, TIM_CHANNEL_ALL);
+    HAL_TIM_Encoder_Stop(&ENCODER_RIGHT_HANDLE, TIM_CHANNEL_ALL);
+}
+
+/**
+ * @brief 采样左右轮计数增量和最近一次边沿
+ */
+void encoder_port_sample(encoder_port_sample_t samples[ENCODER_PORT_NUM])
+{
+    encoder_port_chan_t *ch;
+    uint32_t seq, edge_cnt, edge_cycles, cnt;
+    uint8_t i;
+
+    for (i = 0; i < ENCODER_PORT_NUM; i++) {
+        ch = &s_enc[i];
+
+        /* 边沿中断优先级更高，读取被打断时重读即可 */
+        do {
+            seq = ch->edge_seq;
+            edge_cnt = ch->edge_cnt;
+            edge_cycles = ch->edge_cycles;
+        } while (seq != ch->edge_seq);
+
+        /* 先读边沿再读计数，保证边沿不晚于本次计数 */
+        cnt = ch->htim->Instance->CNT & ch->mask;
+
+        samples[i].delta = ch->sign * encoder_port_diff(ch, cnt, ch->last_cnt);
+        samples[i].edges = seq;
+        samples[i].edge_offset = ch->sign * encoder_port_diff(ch, edge_cnt, cnt);
+        samples[i].edge_cycles = edge_cycles;
+
+        ch->last_cnt = cnt;
+    }
+}
+
+/**
+ * @brief 打开或关闭某一路的边沿捕获中断
+ */
+void encoder_port_set_edge_capture(uint8_t wheel, uint8_t enable)
+{
+    if (wheel >= ENCODER_PORT_NUM) {
+        return;
+    }
+
+    if (enable) {
+        __HAL_TIM_CLEAR_FLAG(s_enc[wheel].htim, TIM_FLAG_CC1);
+        __HAL_TIM_ENABLE_IT(s_enc[wheel].htim, TIM_IT_CC1);
+    } else {
+        __HAL_TIM_DISABLE_IT(s_enc[wheel].htim, TIM_IT_CC1);
+    }
+}
+
+/**
+ * @brief 获取编码器计数参数
+ */
+void encoder_port_get_geometry(uint32_t cpr[ENCODER_PORT_NUM], uint32_t edge_counts[ENCODER_PORT_NUM])
+{
+    cpr[ENCODER_PORT_LEFT] = ENCODER_LEFT_CPR;
+    cpr[ENCODER_PORT_RIGHT] = ENCODER_RIGHT_CPR;
+    edge_counts[ENCODER_PORT_LEFT] = ENCODER_LEFT_EDGE_COUNTS;
+    edge_counts[ENCODER_PORT_RIGHT] = ENCODER_RIGHT_EDGE_COUNTS;
+}
+
+/**
+ * @brief 获取车体几何参数
+ */
+void encoder_port_get_wheel(float *p_radius_m, float *p_base_m)
+{
+    *p_radius_m = WHEEL_RADIUS_M;
+    *p_base_m = WHEEL_BASE_M;
+}
+
+/* ========================================================================== */
+/*                              HAL中断回调                                   */
+/* ========================================================================== */
+
+/**
+ * @brief 输入捕获回调 (覆盖HAL弱定义)
+ * @note 所有使用HAL_TIM_IRQHandler的定时器共用此回调，按句柄分发
+ */
+void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef *htim)
+{
+    encoder_port_chan_t *ch;
+    uint8_t i;
+
+    if (htim->Channel != HAL_TIM_ACTIVE_CHANNEL_1) {
+        return;
+    }
+
+    for (i = 0; i < ENCODER_PORT_NUM; i++) {
+        ch = &s_enc[i];
+        if (htim == ch->htim) {
+            ch->edge_cycles = DWT->CYCCNT;
+            ch->edge_cnt = htim->Instance->CCR1 & ch->mask;
+            ch->edge_seq++;
+            return;
+        }
+    }
+}
+
+/* ========================================================================== */
+/*                              私有函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 按计数器位宽计算有符号差值 a - b
+ */
+static int32_t encoder_port_diff(const encoder_port_chan_t *ch, uint32_t a, uint32_t b)
+{
+    uint32_t d = (a - b) & ch->mask;
+
+    if (ch->mask != 0xFFFFFFFFUL && d > (ch->mask >> 1)) {
+        return (int32_t)d - (int32_t)(ch->mask + 1UL);
+    }
+    return (int32_t)d;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file encoder_port.h
+ * @brief STM32F407正交编码器端口层接口
+ * @details 启动TIM2/TIM3编码器模式，按固定周期采样计数增量，并可选地对TI1上升沿
+ *          做输入捕获 (CCR1锁存边沿时刻的计数值，中断中记录DWT时间戳)，
+ *          供应用层在低速时按边沿周期测速。
+ *          计数器回绕通过按计数器位宽做有符号差值处理，两次采样之间的移动量
+ *          只要小于计数器半量程即可正确计算。
+ * @date 2026-10-16
+ *
+ * @note 编码器分配和每转计数见stm32f407_port_config.h (ENCODER_LEFT_* / ENCODER_RIGHT_*)
+ */
+
+#ifndef ENCODER_PORT_H__
+#define ENCODER_PORT_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ENCODER_PORT_LEFT           0U      /**< 左轮 (电机A) */
+#define ENCODER_PORT_RIGHT          1U      /**< 右轮 (电机B) */
+#define ENCODER_PORT_NUM            2U      /**< 编码器数量 */
+
+/**
+ * @brief 单个编码器的一次采样
+ */
+typedef struct {
+    int32_t delta;          /**< 自上次采样以来的计数增量 (正值为前进方向) */
+    uint32_t edges;         /**< 已捕获的边沿总数 (回绕计数，变化表示有新边沿) */
+    int32_t edge_offset;    /**< 最近一次边沿时的计数相对本次采样计数的偏移 */
+    uint32_t edge_cycles;   /**< 最近一次边沿的DWT周期计数 */
+} encoder_port_sample_t;
+
+/**
+ * @brief 启动左右轮编码器计数
+ * @return int32_t 错误码
+ * @retval 0 启动成功
+ * @retval -1 定时器启动失败
+ * @note 定时器由CubeMX的MX_TIM2_Init()/MX_TIM3_Init()配置，此处只启动并记录基准计数；
+ *       边沿捕获默认关闭；重复调用会先停止再重新启动
+ */
+int32_t encoder_port_init(void);
+
+/**
+ * @brief 停止编码器计数和边沿捕获
+ */
+void encoder_port_deinit(void);
+
+/**
+ * @brief 采样左右轮计数增量和最近一次边沿
+ * @param samples 输出采样，下标为ENCODER_PORT_LEFT/ENCODER_PORT_RIGHT
+ * @note 只允许一个调用者 (控制节拍中断)；边沿中断优先级须高于调用者
+ */
+void encoder_port_sample(encoder_port_sample_t samples[ENCODER_PORT_NUM]);
+
+/**
+ * @brief 打开或关闭某一路的边沿捕获中断
+ * @param wheel ENCODER_PORT_LEFT / ENCODER_PORT_RIGHT
+ * @param enable 非0打开
+ * @note 高速时关闭以免每个边沿都进中断
+ */
+void encoder_port_set_edge_capture(uint8_t wheel, uint8_t enable);
+
+/**
+ * @brief 获取编码器计数参数
+ * @param cpr 输出每转计数 (当前计数模式下)
+ * @param edge_counts 输出相邻两次捕获边沿之间的计数
+ */
+void encoder_port_get_geometry(uint32_t cpr[ENCODER_PORT_NUM], uint32_t edge_counts[ENCODER_PORT_NUM]);
+
+/**
+ * @brief 获取车体几何参数
+ * @param p_radius_m 输出车轮半径 (m)
+ * @param p_base_m 输出轮距 (m)
+ */
+void encoder_port_get_wheel(float *p_radius_m, float *p_base_m);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ENCODER_PORT_H__ */
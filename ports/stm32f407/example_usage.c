@@ -66,7 +66,7 @@ int32_t wit_port_init_all(void)
 
 /**
  * @brief 读取WIT传感器寄存器示例
- * @param sensor_addr 传感器I2C地址
+ * @param sensor_addr 传感器7位I2C地址
  * @param reg_addr 寄存器地址
  * @param data 读取的数据缓冲区
  * @param len 读取长度
@@ -74,13 +74,13 @@ int32_t wit_port_init_all(void)
  */
 int32_t wit_read_register_example(uint8_t sensor_addr, uint8_t reg_addr, uint8_t *data, uint32_t len)
 {
-    /* 使用端口层I2C接口读取寄存器 */
-    return wit_port_i2c_read(sensor_addr, reg_addr, data, len);
+    /* 使用端口层I2C接口读取寄存器，端口层使用8位写地址 */
+    return wit_port_i2c_read((uint8_t)(sensor_addr << 1), reg_addr, data, len);
 }
 
 /**
  * @brief 写入WIT传感器寄存器示例
- * @param sensor_addr 传感器I2C地址
+ * @param sensor_addr 传感器7位I2C地址
  * @param reg_addr 寄存器地址
  * @param data 要写入的数据
  * @param len 写入长度
@@ -89,7 +89,7 @@ int32_t wit_read_register_example(uint8_t sensor_addr, uint8_t reg_addr, uint8_t
 int32_t wit_write_register_example(uint8_t sensor_addr, uint8_t reg_addr, uint8_t *data, uint32_t len)
 {
     /* 使用端口层I2C接口写入寄存器 */
-    return wit_port_i2c_write(sensor_addr, reg_addr, data, len);
+    return wit_port_i2c_write((uint8_t)(sensor_addr << 1), reg_addr, data, len);
 }
 
 /* ========================================================================== */
@@ -130,7 +130,7 @@ void wit_print_sensor_data_example(int16_t acc_x, int16_t acc_y, int16_t acc_z)
 
 /**
  * @brief 传感器初始化序列示例
- * @param sensor_addr 传感器I2C地址
+ * @param sensor_addr 传感器7位I2C地址
  * @return 1: 成功, 0: 失败
  */
 int32_t wit_sensor_init_sequence_example(uint8_t sensor_addr)
@@ -138,7 +138,7 @@ int32_t wit_sensor_init_sequence_example(uint8_t sensor_addr)
     uint8_t init_data[] = {0x01, 0x02, 0x03};
     
     /* 发送初始化命令 */
-    if (!wit_port_i2c_write(sensor_addr, 0x3E, init_data, sizeof(init_data))) {
+    if (!wit_port_i2c_write((uint8_t)(sensor_addr << 1), 0x3E, init_data, sizeof(init_data))) {
         return 0;
     }
     
@@ -147,7 +147,7 @@ int32_t wit_sensor_init_sequence_example(uint8_t sensor_addr)
     
     /* 验证初始化结果 */
     uint8_t status;
-    if (!wit_port_i2c_read(sensor_addr, 0x3F, &status, 1)) {
+    if (!wit_port_i2c_read((uint8_t)(sensor_addr << 1), 0x3F, &status, 1)) {
         return 0;
     }
     
@@ -196,8 +196,8 @@ void stm32f407_i2c_scan(void)
     printf("Scanning I2C bus (0x08-0x77)...\r\n");
 
     for (addr = 0x08; addr <= 0x77; addr++) {
-        /* 尝试读取设备 */
-        if (wit_port_i2c_read(addr, 0x00, &dummy_data, 1)) {
+        /* 尝试读取设备 (端口层使用8位写地址) */
+        if (wit_port_i2c_read((uint8_t)(addr << 1), 0x00, &dummy_data, 1)) {
             printf("Found device at address 0x%02X\r\n", addr);
             found_count++;
         }
@@ -247,7 +247,7 @@ void wit_i2c_timing_example(void)
 
 /**
  * @brief 完整的传感器数据读取示例
- * @param sensor_addr 传感器I2C地址
+ * @param sensor_addr 传感器7位I2C地址
  * @return 1: 成功, 0: 失败
  */
 int32_t wit_read_sensor_complete_example(uint8_t sensor_addr)
@@ -256,7 +256,7 @@ int32_t wit_read_sensor_complete_example(uint8_t sensor_addr)
     int16_t acc_x, acc_y, acc_z;
     
     /* 读取加速度数据寄存器 */
-    if (!wit_port_i2c_read(sensor_addr, 0x34, data, 6)) {
+    if (!wit_port_i2c_read((uint8_t)(sensor_addr << 1), 0x34, data, 6)) {
         wit_debug_print_example("Error: Failed to read sensor data\r\n");
         return 0;
     }
@@ -278,7 +278,7 @@ int32_t wit_read_sensor_complete_example(uint8_t sensor_addr)
 
 /**
  * @brief 带错误处理的传感器操作示例
- * @param sensor_addr 传感器I2C地址
+ * @param sensor_addr 传感器7位I2C地址
  * @return 1: 成功, 0: 失败
  */
 int32_t wit_sensor_operation_with_error_handling_example(uint8_t sensor_addr)
@@ -289,7 +289,7 @@ int32_t wit_sensor_operation_with_error_handling_example(uint8_t sensor_addr)
     /* 重试机制 */
     while (retry_count > 0) {
         /* 读取设备ID */
-        if (wit_port_i2c_read(sensor_addr, 0x00, &device_id, 1)) {
+        if (wit_port_i2c_read((uint8_t)(sensor_addr << 1), 0x00, &device_id, 1)) {
             if (device_id == 0x50) {  /* 期望的设备ID */
                 wit_debug_print_example("Sensor detected successfully\r\n");
                 return 1;
@@ -0,0 +1,198 @@
+/**
+ * @file flash_port.c
+ * @brief STM32F407片内Flash参数存储端口层实现
+ * @date 2026-10-16
+ */
+
+#include "flash_port.h"
+#include "stm32f407_port_config.h"
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+#define FLASH_RECORD_MAGIC      0xA5U
+#define FLASH_RECORD_SIZE       8U
+#define FLASH_RECORD_COUNT      (FLASH_PORT_SIZE / FLASH_RECORD_SIZE)
+#define FLASH_ERASED_WORD       0xFFFFFFFFUL
+
+/* 记录头: [31:24]魔数 [23:16]~ID [15:8]ID [7:0]值的字节和 */
+#define FLASH_RECORD_HEADER(id, sum) \
+    (((uint32_t)FLASH_RECORD_MAGIC << 24) | ((uint32_t)(uint8_t)~(id) << 16) | ((uint32_t)(id) << 8) | (sum))
+
+/* ========================================================================== */
+/*                              私有函数声明                                  */
+/* ========================================================================== */
+
+static uint8_t flash_value_sum(uint32_t value);
+static int32_t flash_record_valid(uint32_t header, uint32_t value, uint8_t *p_id);
+static uint32_t flash_find_free_slot(void);
+static int32_t flash_program_record(uint32_t slot, uint8_t id, uint32_t value);
+static int32_t flash_compact(void);
+
+/* ========================================================================== */
+/*                              公共函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 读取参数
+ */
+int32_t flash_port_record_read(uint8_t id, uint32_t *p_value)
+{
+    const volatile uint32_t *p_rec = (const volatile uint32_t *)FLASH_PORT_BASE_ADDR;
+    uint32_t i;
+    uint8_t rec_id;
+    int32_t found = -1;
+
+    if (p_value == NULL || id > FLASH_PORT_MAX_ID) {
+        return -1;
+    }
+
+    for (i = 0; i < FLASH_RECORD_COUNT; i++, p_rec += 2) {
+        if (p_rec[0] == FLASH_ERASED_WORD && p_rec[1] == FLASH_ERASED_WORD) {
+            break;  /* 日志结尾 */
+        }
+        if (flash_record_valid(p_rec[0], p_rec[1], &rec_id) == 0 && rec_id == id) {
+            *p_value = p_rec[1];
+            found = 0;
+        }
+    }
+
+    return found;
+}
+
+/**
+ * @brief 写入参数
+ */
+int32_t flash_port_record_write(uint8_t id, uint32_t value)
+{
+    uint32_t old_value;
+    uint32_t slot;
+
+    if (id > FLASH_PORT_MAX_ID) {
+        return -1;
+    }
+
+    /* 值未变化时不写，避免无谓磨损 */
+    if (flash_port_record_read(id, &old_value) == 0 && old_value == value) {
+        return 0;
+    }
+
+    slot = flash_find_free_slot();
+    if (slot >= FLASH_RECORD_COUNT) {
+        if (flash_compact() != 0) {
+            return -2;
+        }
+        slot = flash_find_free_slot();
+        if (slot >= FLASH_RECORD_COUNT) {
+            return -2;
+        }
+    }
+
+    return flash_program_record(slot, id, value);
+}
+
+/* ========================================================================== */
+/*                              私有函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 计算值的字节和
+ */
+static uint8_t flash_value_sum(uint32_t value)
+{
+    return (uint8_t)((value & 0xFF) + ((value >> 8) & 0xFF) + ((value >> 16) & 0xFF) + (value >> 24));
+}
+
+/**
+ * @brief 校验记录
+ * @return int32_t 0: 有效, -1: 无效 (写入中断电等)
+ */
+static int32_t flash_record_valid(uint32_t header, uint32_t value, uint8_t *p_id)
+{
+    uint8_t id = (uint8_t)(header >> 8);
+
+    if (header != FLASH_RECORD_HEADER(id, flash_value_sum(value))) {
+        return -1;
+    }
+    *p_id = id;
+    return 0;
+}
+
+/**
+ * @brief 查找第一个空闲记录位置
+ * @return uint32_t 记录序号，FLASH_RECORD_COUNT表示已满
+ */
+static uint32_t flash_find_free_slot(void)
+{
+    const volatile uint32_t *p_rec = (const volatile uint32_t *)FLASH_PORT_BASE_ADDR;
+    uint32_t i;
+
+    for (i = 0; i < FLASH_RECORD_COUNT; i++, p_rec += 2) {
+        if (p_rec[0] == FLASH_ERASED_WORD && p_rec[1] == FLASH_ERASED_WORD) {
+            break;
+        }
+    }
+    return i;
+}
+
+/**
+ * @brief 写入一条记录
+ * @note 先写值再写记录头，写入中途掉电时记录头为空或校验失败
+ */
+static int32_t flash_program_record(uint32_t slot, uint8_t id, uint32_t value)
+{
+    uint32_t addr = FLASH_PORT_BASE_ADDR + slot * FLASH_RECORD_SIZE;
+    HAL_StatusTypeDef status;
+
+    HAL_FLASH_Unlock();
+    status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr + 4U, value);
+    if (status == HAL_OK) {
+        status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr, FLASH_RECORD_HEADER(id, flash_value_sum(value)));
+    }
+    HAL_FLASH_Lock();
+
+    return (status == HAL_OK) ? 0 : -2;
+}
+
+/**
+ * @brief 擦除扇区并写回各ID的最新值
+ */
+static int32_t flash_compact(void)
+{
+    uint32_t values[FLASH_PORT_MAX_ID + 1U];
+    uint16_t present = 0;
+    FLASH_EraseInitTypeDef erase;
+    uint32_t sector_error = 0;
+    uint32_t slot = 0;
+    uint8_t id;
+    HAL_StatusTypeDef status;
+
+    for (id = 0; id <= FLASH_PORT_MAX_ID; id++) {
+        if (flash_port_record_read(id, &values[id]) == 0) {
+            present |= (uint16_t)(1U << id);
+        }
+    }
+
+    erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+    erase.Sector = FLASH_PORT_SECTOR;
+    erase.NbSectors = 1;
+    erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+
+    HAL_FLASH_Unlock();
+    status = HAL_FLASHEx_Erase(&erase, &sector_error);
+    HAL_FLASH_Lock();
+    if (status != HAL_OK) {
+        return -2;
+    }
+
+    for (id = 0; id <= FLASH_PORT_MAX_ID; id++) {
+        if (present & (1U << id)) {
+            if (flash_program_record(slot++, id, values[id]) != 0) {
+                return -2;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file flash_port.h
+ * @brief STM32F407片内Flash参数存储端口层接口
+ * @details 在保留的Flash扇区中以追加日志方式保存少量32位参数，
+ *          每条记录带ID和校验，同一ID以最后一条有效记录为准。
+ *          扇区写满时擦除并仅保留各ID的最新值，擦除次数与写入次数成比例降低。
+ * @date 2026-10-16
+ *
+ * @note 扇区擦除耗时可达1-2秒，期间CPU取指停顿，勿在控制过程中写入
+ */
+
+#ifndef FLASH_PORT_H__
+#define FLASH_PORT_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLASH_PORT_MAX_ID       15U     /**< 记录ID范围: 0-15 */
+
+/**
+ * @brief 读取参数
+ * @param id 记录ID
+ * @param p_value 输出参数值
+ * @return int32_t 0: 成功, -1: 参数无效或无记录
+ */
+int32_t flash_port_record_read(uint8_t id, uint32_t *p_value);
+
+/**
+ * @brief 写入参数
+ * @param id 记录ID
+ * @param value 参数值
+ * @return int32_t 0: 成功 (与已存值相同时不写Flash), -1: 参数无效, -2: Flash操作失败
+ */
+int32_t flash_port_record_write(uint8_t id, uint32_t value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FLASH_PORT_H__ */
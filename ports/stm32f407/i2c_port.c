@@ -15,21 +15,39 @@
 
 #define I2C_TIMEOUT_MS          WIT_I2C_TIMEOUT    /* I2C超时时间(毫秒) */
 #define I2C_RETRY_COUNT         3                  /* I2C重试次数 */
-#define I2C_DEVICE_ADDR_SHIFT   1                  /* 设备地址左移1位 */
+#define I2C_PROBE_TIMEOUT_MS    WIT_I2C_PROBE_TIMEOUT  /* 地址探测超时(毫秒) */
+#define I2C_PROBE_TRIALS        1                  /* 地址探测次数 */
 
 /* ========================================================================== */
 /*                              私有变量                                      */
 /* ========================================================================== */
 
-static uint8_t s_i2c_initialized = 0;  /* I2C初始化标志 */
+static uint8_t s_i2c_initialized = 0;  /* I2C1初始化标志 */
+static uint8_t s_i2c2_initialized = 0; /* I2C2初始化标志 */
+
+/**
+ * @brief 异步传输完成通知
+ */
+typedef struct {
+    wit_port_i2c_done_t done;           /**< 完成回调, NULL表示空闲 */
+    void *p_ctx;                        /**< 回调上下文 */
+} i2c_async_slot_t;
+
+static volatile i2c_async_slot_t s_i2c1_async = {0};   /* I2C1异步传输 */
+static volatile i2c_async_slot_t s_i2c2_async = {0};   /* I2C2异步传输 */
 
 /* ========================================================================== */
 /*                              私有函数声明                                  */
 /* ========================================================================== */
 
-static HAL_StatusTypeDef i2c_wait_ready(void);
-static int32_t i2c_mem_write_with_retry(uint8_t dev_addr, uint8_t reg_addr, uint8_t *data, uint16_t size);
-static int32_t i2c_mem_read_with_retry(uint8_t dev_addr, uint8_t reg_addr, uint8_t *data, uint16_t size);
+static HAL_StatusTypeDef i2c_wait_ready(I2C_HandleTypeDef *hi2c);
+static int32_t i2c_mem_write_with_retry(I2C_HandleTypeDef *hi2c, uint8_t dev_addr, uint8_t reg_addr, uint8_t *data, uint16_t size);
+static int32_t i2c_mem_read_with_retry(I2C_HandleTypeDef *hi2c, uint8_t dev_addr, uint8_t reg_addr, uint8_t *data, uint16_t size);
+static int32_t i2c_mem_read_async(I2C_HandleTypeDef *hi2c, volatile i2c_async_slot_t *slot,
+                                  uint8_t dev_addr, uint8_t reg_addr, uint8_t *data, uint16_t size,
+                                  wit_port_i2c_done_t done, void *p_ctx);
+static void i2c_async_finish(I2C_HandleTypeDef *hi2c, int32_t result);
+static int32_t i2c_probe(I2C_HandleTypeDef *hi2c, uint8_t addr7);
 
 /* ========================================================================== */
 /*                              公共函数实现                                  */
@@ -52,7 +70,7 @@ int32_t wit_port_i2c_init(void)
     }
 
     /* 等待I2C就绪 */
-    if (i2c_wait_ready() != HAL_OK) {
+    if (i2c_wait_ready(&hi2c1) != HAL_OK) {
         return -1;
     }
 
@@ -62,7 +80,7 @@ int32_t wit_port_i2c_init(void)
 
 /**
  * @brief I2C写寄存器
- * @param ucAddr 设备地址 (7位地址，不包含读写位)
+ * @param ucAddr 设备地址 (8位写地址，即7位地址左移1位，WIT SDK已完成移位)
  * @param ucReg 寄存器地址
  * @param p_ucVal 要写入的数据指针
  * @param uiLen 数据长度
@@ -83,12 +101,12 @@ int32_t wit_port_i2c_write(uint8_t ucAddr, uint8_t ucReg, uint8_t *p_ucVal, uint
     }
 
     /* 执行I2C写操作(带重试) */
-    return i2c_mem_write_with_retry(ucAddr, ucReg, p_ucVal, (uint16_t)uiLen);
+    return i2c_mem_write_with_retry(&hi2c1, ucAddr, ucReg, p_ucVal, (uint16_t)uiLen);
 }
 
 /**
  * @brief I2C读寄存器
- * @param ucAddr 设备地址 (7位地址，不包含读写位)
+ * @param ucAddr 设备地址 (8位写地址，即7位地址左移1位，WIT SDK已完成移位)
  * @param ucReg 寄存器地址
  * @param p_ucVal 读取数据存储指针
  * @param uiLen 要读取的数据长度
@@ -109,7 +127,158 @@ int32_t wit_port_i2c_read(uint8_t ucAddr, uint8_t ucReg, uint8_t *p_ucVal, uint3
     }
 
     /* 执行I2C读操作(带重试) */
-    return i2c_mem_read_with_retry(ucAddr, ucReg, p_ucVal, (uint16_t)uiLen);
+    return i2c_mem_read_with_retry(&hi2c1, ucAddr, ucReg, p_ucVal, (uint16_t)uiLen);
+}
+
+/**
+ * @brief I2C异步读寄存器
+ * @return 1: 传输已启动, 0: 失败
+ */
+int32_t wit_port_i2c_read_async(uint8_t ucAddr, uint8_t ucReg, uint8_t *p_ucVal, uint32_t uiLen,
+                                wit_port_i2c_done_t done, void *p_ctx)
+{
+    if (!s_i2c_initialized) {
+        if (wit_port_i2c_init() != 0) {
+            return 0;
+        }
+    }
+
+    return i2c_mem_read_async(&hi2c1, &s_i2c1_async, ucAddr, ucReg, p_ucVal, (uint16_t)uiLen, done, p_ctx);
+}
+
+/**
+ * @brief 快速探测I2C1上的设备
+ * @param ucAddr7 7位设备地址
+ * @return 1: 设备应答, 0: 无应答
+ * @note 仅发送地址字节检查ACK，超时为WIT_I2C_PROBE_TIMEOUT毫秒，不重试
+ */
+int32_t wit_port_i2c_probe(uint8_t ucAddr7)
+{
+    if (!s_i2c_initialized) {
+        if (wit_port_i2c_init() != 0) {
+            return 0;
+        }
+    }
+
+    return i2c_probe(&hi2c1, ucAddr7);
+}
+
+/**
+ * @brief I2C2端口层初始化
+ * @return 0: 成功, 其他: 失败
+ * @note 用于第二路传感器，I2C2硬件初始化由CubeMX生成的MX_I2C2_Init()完成
+ */
+int32_t wit_port_i2c2_init(void)
+{
+    if (s_i2c2_initialized) {
+        return 0;  /* 已经初始化 */
+    }
+
+    /* 检查I2C句柄是否已初始化 */
+    if (hi2c2.Instance == NULL) {
+        return -1;  /* I2C2未初始化，请检查CubeMX配置 */
+    }
+
+    /* 等待I2C就绪 */
+    if (i2c_wait_ready(&hi2c2) != HAL_OK) {
+        return -1;
+    }
+
+    s_i2c2_initialized = 1;
+    return 0;
+}
+
+/**
+ * @brief I2C2写寄存器
+ * @return 1: 成功, 0: 失败
+ * @note 参数含义同wit_port_i2c_write()
+ */
+int32_t wit_port_i2c2_write(uint8_t ucAddr, uint8_t ucReg, uint8_t *p_ucVal, uint32_t uiLen)
+{
+    if (p_ucVal == NULL || uiLen == 0) {
+        return 0;
+    }
+
+    if (!s_i2c2_initialized) {
+        if (wit_port_i2c2_init() != 0) {
+            return 0;
+        }
+    }
+
+    return i2c_mem_write_with_retry(&hi2c2, ucAddr, ucReg, p_ucVal, (uint16_t)uiLen);
+}
+
+/**
+ * @brief I2C2读寄存器
+ * @return 1: 成功, 0: 失败
+ * @note 参数含义同wit_port_i2c_read()
+ */
+int32_t wit_port_i2c2_read(uint8_t ucAddr, uint8_t ucReg, uint8_t *p_ucVal, uint32_t uiLen)
+{
+    if (p_ucVal == NULL || uiLen == 0) {
+        return 0;
+    }
+
+    if (!s_i2c2_initialized) {
+        if (wit_port_i2c2_init() != 0) {
+            return 0;
+        }
+    }
+
+    return i2c_mem_read_with_retry(&hi2c2, ucAddr, ucReg, p_ucVal, (uint16_t)uiLen);
+}
+
+/**
+ * @brief I2C2异步读寄存器
+ * @return 1: 传输已启动, 0: 失败
+ */
+int32_t wit_port_i2c2_read_async(uint8_t ucAddr, uint8_t ucReg, uint8_t *p_ucVal, uint32_t uiLen,
+                                 wit_port_i2c_done_t done, void *p_ctx)
+{
+    if (!s_i2c2_initialized) {
+        if (wit_port_i2c2_init() != 0) {
+            return 0;
+        }
+    }
+
+    return i2c_mem_read_async(&hi2c2, &s_i2c2_async, ucAddr, ucReg, p_ucVal, (uint16_t)uiLen, done, p_ctx);
+}
+
+/**
+ * @brief 快速探测I2C2上的设备
+ * @return 1: 设备应答, 0: 无应答
+ * @note 参数含义同wit_port_i2c_probe()
+ */
+int32_t wit_port_i2c2_probe(uint8_t ucAddr7)
+{
+    if (!s_i2c2_initialized) {
+        if (wit_port_i2c2_init() != 0) {
+            return 0;
+        }
+    }
+
+    return i2c_probe(&hi2c2, ucAddr7);
+}
+
+/* ========================================================================== */
+/*                              HAL中断回调                                   */
+/* ========================================================================== */
+
+/**
+ * @brief I2C内存读完成回调 (覆盖HAL弱定义)
+ */
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    i2c_async_finish(hi2c, 0);
+}
+
+/**
+ * @brief I2C错误回调 (覆盖HAL弱定义)
+ * @note 包括NACK(传感器不在线)和总线错误
+ */
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    i2c_async_finish(hi2c, -1);
 }
 
 /* ========================================================================== */
@@ -118,14 +287,15 @@ int32_t wit_port_i2c_read(uint8_t ucAddr, uint8_t ucReg, uint8_t *p_ucVal, uint3
 
 /**
  * @brief 等待I2C总线就绪
+ * @param hi2c I2C句柄
  * @return HAL_OK: 成功, 其他: 失败
  */
-static HAL_StatusTypeDef i2c_wait_ready(void)
+static HAL_StatusTypeDef i2c_wait_ready(I2C_HandleTypeDef *hi2c)
 {
     uint32_t timeout = I2C_TIMEOUT_MS;
 
     /* 等待I2C总线空闲 */
-    while (__HAL_I2C_GET_FLAG(&hi2c1, I2C_FLAG_BUSY) && timeout > 0) {
+    while (__HAL_I2C_GET_FLAG(hi2c, I2C_FLAG_BUSY) && timeout > 0) {
         HAL_Delay(1);
         timeout--;
     }
@@ -135,21 +305,22 @@ static HAL_StatusTypeDef i2c_wait_ready(void)
 
 /**
  * @brief 带重试的I2C内存写操作
+ * @param hi2c I2C句柄
  * @param dev_addr 设备地址
  * @param reg_addr 寄存器地址
  * @param data 数据指针
  * @param size 数据大小
  * @return 1: 成功, 0: 失败
  */
-static int32_t i2c_mem_write_with_retry(uint8_t dev_addr, uint8_t reg_addr, uint8_t *data, uint16_t size)
+static int32_t i2c_mem_write_with_retry(I2C_HandleTypeDef *hi2c, uint8_t dev_addr, uint8_t reg_addr, uint8_t *data, uint16_t size)
 {
     HAL_StatusTypeDef status;
     uint32_t retry_count = I2C_RETRY_COUNT;
 
     while (retry_count > 0) {
         /* 执行I2C内存写操作 */
-        status = HAL_I2C_Mem_Write(&hi2c1,
-                                   (uint16_t)(dev_addr << I2C_DEVICE_ADDR_SHIFT),
+        status = HAL_I2C_Mem_Write(hi2c,
+                                   (uint16_t)dev_addr,
                                    reg_addr,
                                    I2C_MEMADD_SIZE_8BIT,
                                    data,
@@ -170,21 +341,22 @@ static int32_t i2c_mem_write_with_retry(uint8_t dev_addr, uint8_t reg_addr, uint
 
 /**
  * @brief 带重试的I2C内存读操作
+ * @param hi2c I2C句柄
  * @param dev_addr 设备地址
  * @param reg_addr 寄存器地址
  * @param data 数据指针
  * @param size 数据大小
  * @return 1: 成功, 0: 失败
  */
-static int32_t i2c_mem_read_with_retry(uint8_t dev_addr, uint8_t reg_addr, uint8_t *data, uint16_t size)
+static int32_t i2c_mem_read_with_retry(I2C_HandleTypeDef *hi2c, uint8_t dev_addr, uint8_t reg_addr, uint8_t *data, uint16_t size)
 {
     HAL_StatusTypeDef status;
     uint32_t retry_count = I2C_RETRY_COUNT;
 
     while (retry_count > 0) {
         /* 执行I2C内存读操作 */
-        status = HAL_I2C_Mem_Read(&hi2c1,
-                                  (uint16_t)(dev_addr << I2C_DEVICE_ADDR_SHIFT),
+        status = HAL_I2C_Mem_Read(hi2c,
+                                  (uint16_t)dev_addr,
                                   reg_addr,
                                   I2C_MEMADD_SIZE_8BIT,
                                   data,
@@ -202,3 +374,94 @@ static int32_t i2c_mem_read_with_retry(uint8_t dev_addr, uint8_t reg_addr, uint8
 
     return 0;  /* 失败 */
 }
+
+/**
+ * @brief 启动异步I2C内存读
+ * @param hi2c I2C句柄
+ * @param slot 该总线的完成通知
+ * @return 1: 传输已启动, 0: 失败
+ * @note 句柄已链接DMA(hdmarx)时使用DMA，否则使用中断方式
+ */
+static int32_t i2c_mem_read_async(I2C_HandleTypeDef *hi2c, volatile i2c_async_slot_t *slot,
+                                  uint8_t dev_addr, uint8_t reg_addr, uint8_t *data, uint16_t size,
+                                  wit_port_i2c_done_t done, void *p_ctx)
+{
+    HAL_StatusTypeDef status;
+
+    /* 参数检查 */
+    if (data == NULL || size == 0 || done == NULL) {
+        return 0;
+    }
+
+    /* 上一次异步传输尚未结束 */
+    if (slot->done != NULL) {
+        return 0;
+    }
+
+    slot->done = done;
+    slot->p_ctx = p_ctx;
+
+    if (hi2c->hdmarx != NULL) {
+        status = HAL_I2C_Mem_Read_DMA(hi2c,
+                                      (uint16_t)dev_addr,
+                                      reg_addr,
+                                      I2C_MEMADD_SIZE_8BIT,
+                                      data,
+                                      size);
+    } else {
+        status = HAL_I2C_Mem_Read_IT(hi2c,
+                                     (uint16_t)dev_addr,
+                                     reg_addr,
+                                     I2C_MEMADD_SIZE_8BIT,
+                                     data,
+                                     size);
+    }
+
+    if (status != HAL_OK) {
+        slot->done = NULL;
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief 结束异步传输并通知上层
+ * @param hi2c I2C句柄
+ * @param result 0: 成功, 其他: 失败
+ */
+static void i2c_async_finish(I2C_HandleTypeDef *hi2c, int32_t result)
+{
+    volatile i2c_async_slot_t *slot;
+    wit_port_i2c_done_t done;
+
+    if (hi2c == &hi2c1) {
+        slot = &s_i2c1_async;
+    } else if (hi2c == &hi2c2) {
+        slot = &s_i2c2_async;
+    } else {
+        return;
+    }
+
+    /* 先释放，回调中可以直接发起下一次传输 */
+    done = slot->done;
+    slot->done = NULL;
+    if (done != NULL) {
+        done(slot->p_ctx, result);
+    }
+}
+
+/**
+ * @brief 探测设备地址是否应答
+ * @param hi2c I2C句柄
+ * @param addr7 7位设备地址
+ * @return 1: 应答, 0: 无应答或总线忙
+ */
+static int32_t i2c_probe(I2C_HandleTypeDef *hi2c, uint8_t addr7)
+{
+    if (addr7 > 0x7F) {
+        return 0;
+    }
+
+    return (HAL_I2C_IsDeviceReady(hi2c, (uint16_t)(addr7 << 1), I2C_PROBE_TRIALS, I2C_PROBE_TIMEOUT_MS) == HAL_OK) ? 1 : 0;
+}
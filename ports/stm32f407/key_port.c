@@ -0,0 +1,51 @@
+/**
+ * @file key_port.c
+ * @brief STM32F407按键端口层实现
+ * @date 2026-10-16
+ */
+
+#include "key_port.h"
+#include "stm32f407_port_config.h"
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+#if KEY_ACTIVE_LOW
+#define KEY_PORT_XOR                KEY_MASK
+#else
+#define KEY_PORT_XOR                0x00U
+#endif
+
+/* ========================================================================== */
+/*                              公共函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 配置按键引脚上拉
+ */
+void key_port_init(void)
+{
+#if KEY_INTERNAL_PULLUP
+    uint32_t pupdr;
+    uint32_t pin;
+
+    /* 每个引脚两位: 00无上下拉, 01上拉 */
+    pupdr = KEY_GPIO->PUPDR;
+    for (pin = 0; pin < 8U; pin++) {
+        if ((KEY_MASK & (1UL << pin)) != 0U) {
+            pupdr &= ~(GPIO_PUPDR_PUPDR0 << ((KEY_SHIFT + pin) * 2U));
+            pupdr |= (GPIO_PULLUP << ((KEY_SHIFT + pin) * 2U));
+        }
+    }
+    KEY_GPIO->PUPDR = pupdr;
+#endif
+}
+
+/**
+ * @brief 读取按键状态
+ */
+uint8_t key_port_read(void)
+{
+    return (uint8_t)(((KEY_GPIO->IDR >> KEY_SHIFT) ^ KEY_PORT_XOR) & KEY_MASK);
+}
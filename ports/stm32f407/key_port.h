@@ -0,0 +1,38 @@
+/**
+ * @file key_port.h
+ * @brief STM32F407按键端口层接口
+ * @details 四个按键接在同一GPIO端口的连续4位 (默认PF2-PF5)，
+ *          一次读取IDR即得到全部按键，按KEY_ACTIVE_LOW统一为"1=按下"。
+ * @date 2026-10-16
+ *
+ * @note CubeMX的MX_GPIO_Init()将引脚配置为无上下拉输入，key_port_init()按KEY_INTERNAL_PULLUP
+ *       改为内部上拉，端口和极性见stm32f407_port_config.h
+ */
+
+#ifndef KEY_PORT_H__
+#define KEY_PORT_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 配置按键引脚上拉
+ * @note 只修改按键引脚的PUPDR位，须在MX_GPIO_Init()之后调用，重复调用无副作用
+ */
+void key_port_init(void);
+
+/**
+ * @brief 读取按键状态
+ * @return uint8_t 位i为KEY i (bit0为PF2)，1表示按下
+ * @note 单次IDR读取，未消抖，可在任意上下文调用
+ */
+uint8_t key_port_read(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KEY_PORT_H__ */
@@ -0,0 +1,188 @@
+/**
+ * @file line_port.c
+ * @brief STM32F407八路循迹传感器端口层实现
+ * @date 2026-10-16
+ */
+
+#include "line_port.h"
+#include "stm32f407_port_config.h"
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+#if LINE_SENSOR_ACTIVE_LOW
+#define LINE_PORT_XOR               0xFFU
+#else
+#define LINE_PORT_XOR               0x00U
+#endif
+
+#if (LINE_SENSOR_SHIFT % 8U) != 0U
+#error "LINE_SENSOR_SHIFT must be byte aligned for the DMA capture"
+#endif
+
+#define LINE_DMA_TIMER_CLOCK_HZ     SYSTEM_CLOCK_FREQ   /* APB2定时器时钟 168MHz */
+#define LINE_DMA_RATE_MIN_HZ        1000UL
+#define LINE_DMA_RATE_MAX_HZ        200000UL
+
+/* ========================================================================== */
+/*                              私有变量                                      */
+/* ========================================================================== */
+
+static TIM_HandleTypeDef htim_line;                 /* 采样触发定时器 */
+static DMA_HandleTypeDef hdma_line;                 /* IDR → 缓冲DMA */
+
+static uint8_t s_line_buf[2U * LINE_DMA_BLOCK_SAMPLES];  /* 循环缓冲 (两个半块) */
+static volatile line_port_block_cb_t s_line_block_cb = NULL;
+
+/* ========================================================================== */
+/*                              私有函数声明                                  */
+/* ========================================================================== */
+
+static void line_port_half_cplt(DMA_HandleTypeDef *hdma);
+static void line_port_cplt(DMA_HandleTypeDef *hdma);
+
+/* ========================================================================== */
+/*                              公共函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 读取八路循迹状态
+ */
+uint8_t line_port_read(void)
+{
+    return (uint8_t)((LINE_SENSOR_GPIO->IDR >> LINE_SENSOR_SHIFT) ^ LINE_PORT_XOR);
+}
+
+/**
+ * @brief 启动定时器触发的DMA过采样
+ */
+int32_t line_port_capture_start(uint32_t rate_hz, line_port_block_cb_t cb)
+{
+    uint32_t psc;
+
+    if (rate_hz == 0) {
+        rate_hz = LINE_DMA_RATE_HZ;
+    }
+
+    /* 参数检查 */
+    if (cb == NULL || rate_hz < LINE_DMA_RATE_MIN_HZ || rate_hz > LINE_DMA_RATE_MAX_HZ) {
+        return -1;
+    }
+
+    line_port_capture_stop();
+
+    __HAL_RCC_DMA2_CLK_ENABLE();
+    __HAL_RCC_TIM8_CLK_ENABLE();
+
+    s_line_block_cb = cb;
+
+    /* DMA: 外设地址固定为IDR所在字节，存储器递增，循环模式 */
+    hdma_line.Instance = LINE_DMA_STREAM;
+    hdma_line.Init.Channel = LINE_DMA_CHANNEL;
+    hdma_line.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma_line.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_line.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_line.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_line.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_line.Init.Mode = DMA_CIRCULAR;
+    hdma_line.Init.Priority = DMA_PRIORITY_MEDIUM;
+    hdma_line.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_line) != HAL_OK) {
+        return -2;
+    }
+    hdma_line.XferHalfCpltCallback = line_port_half_cplt;
+    hdma_line.XferCpltCallback = line_port_cplt;
+
+    HAL_NVIC_SetPriority(LINE_DMA_IRQn, LINE_DMA_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(LINE_DMA_IRQn);
+
+    if (HAL_DMA_Start_IT(&hdma_line, (uint32_t)&LINE_SENSOR_GPIO->IDR + (LINE_SENSOR_SHIFT / 8U),
+                         (uint32_t)s_line_buf, sizeof(s_line_buf)) != HAL_OK) {
+        return -2;
+    }
+
+    /* 定时器: 16位自动重装载，低于约2564Hz时需分频；更新事件只用于请求DMA，不开中断 */
+    psc = (LINE_DMA_TIMER_CLOCK_HZ / rate_hz - 1U) / 65536UL;
+    htim_line.Instance = LINE_DMA_TIMER;
+    htim_line.Init.Prescaler = psc;
+    htim_line.Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim_line.Init.Period = (LINE_DMA_TIMER_CLOCK_HZ / ((psc + 1U) * rate_hz)) - 1U;
+    htim_line.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    htim_line.Init.RepetitionCounter = 0;
+    htim_line.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+    if (HAL_TIM_Base_Init(&htim_line) != HAL_OK) {
+        HAL_DMA_Abort(&hdma_line);
+        return -2;
+    }
+
+    __HAL_TIM_ENABLE_DMA(&htim_line, TIM_DMA_UPDATE);
+    if (HAL_TIM_Base_Start(&htim_line) != HAL_OK) {
+        HAL_DMA_Abort(&hdma_line);
+        return -2;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 停止DMA过采样
+ */
+void line_port_capture_stop(void)
+{
+    if (htim_line.Instance != NULL) {
+        HAL_TIM_Base_Stop(&htim_line);
+        __HAL_TIM_DISABLE_DMA(&htim_line, TIM_DMA_UPDATE);
+    }
+    if (hdma_line.Instance != NULL) {
+        HAL_NVIC_DisableIRQ(LINE_DMA_IRQn);
+        HAL_DMA_Abort(&hdma_line);
+    }
+    s_line_block_cb = NULL;
+}
+
+/**
+ * @brief 原始采样的极性掩码
+ */
+uint8_t line_port_invert_mask(void)
+{
+    return LINE_PORT_XOR;
+}
+
+/**
+ * @brief DMA中断处理
+ */
+void line_port_dma_irq_handler(void)
+{
+    HAL_DMA_IRQHandler(&hdma_line);
+}
+
+/* ========================================================================== */
+/*                              私有函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 前半缓冲写满 (DMA开始写后半)
+ */
+static void line_port_half_cplt(DMA_HandleTypeDef *hdma)
+{
+    line_port_block_cb_t cb = s_line_block_cb;
+
+    (void)hdma;
+    if (cb != NULL) {
+        cb(&s_line_buf[0], LINE_DMA_BLOCK_SAMPLES);
+    }
+}
+
+/**
+ * @brief 后半缓冲写满 (DMA回绕写前半)
+ */
+static void line_port_cplt(DMA_HandleTypeDef *hdma)
+{
+    line_port_block_cb_t cb = s_line_block_cb;
+
+    (void)hdma;
+    if (cb != NULL) {
+        cb(&s_line_buf[LINE_DMA_BLOCK_SAMPLES], LINE_DMA_BLOCK_SAMPLES);
+    }
+}
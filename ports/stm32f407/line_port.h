@@ -0,0 +1,70 @@
+/**
+ * @file line_port.h
+ * @brief STM32F407八路循迹传感器端口层接口
+ * @details 八路数字输出接在同一GPIO端口的连续8位 (默认PE0-PE7)，
+ *          一次读取IDR即得到全部通道，按LINE_SENSOR_ACTIVE_LOW统一为"1=压线"。
+ *          另提供定时器触发DMA的过采样: TIM8更新事件以固定频率把IDR搬入循环缓冲，
+ *          采样本身不占用CPU，每半缓冲回调一次。
+ * @date 2026-10-16
+ *
+ * @note 引脚输入模式由CubeMX的MX_GPIO_Init()配置，端口和极性见stm32f407_port_config.h
+ */
+
+#ifndef LINE_PORT_H__
+#define LINE_PORT_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 读取八路循迹状态
+ * @return uint8_t 位i为第i路 (bit0为最左侧探头)，1表示压线
+ * @note 单次IDR读取，可在任意上下文调用
+ */
+uint8_t line_port_read(void);
+
+/**
+ * @brief 过采样块回调函数类型
+ * @param samples 刚写满的半缓冲 (IDR原始值，未做极性转换)
+ * @param n 采样数 (LINE_DMA_BLOCK_SAMPLES)
+ * @note 在DMA中断中调用；DMA正在写另一半缓冲，回调须在一个块时间内返回
+ */
+typedef void (*line_port_block_cb_t)(const uint8_t *samples, uint32_t n);
+
+/**
+ * @brief 启动定时器触发的DMA过采样
+ * @param rate_hz 采样频率 (Hz)，范围: 1000-200000，0表示使用LINE_DMA_RATE_HZ
+ * @param cb 块回调
+ * @return int32_t 错误码
+ * @retval 0 启动成功
+ * @retval -1 参数无效
+ * @retval -2 定时器或DMA初始化失败
+ * @note 重复调用会按新频率重新启动
+ */
+int32_t line_port_capture_start(uint32_t rate_hz, line_port_block_cb_t cb);
+
+/**
+ * @brief 停止DMA过采样
+ * @note 返回后回调不会再被调用
+ */
+void line_port_capture_stop(void);
+
+/**
+ * @brief 原始采样的极性掩码
+ * @return uint8_t 与原始采样异或后得到"1=压线" (低电平有效时为0xFF)
+ */
+uint8_t line_port_invert_mask(void);
+
+/**
+ * @brief DMA中断处理 (由DMA2_Stream1_IRQHandler调用)
+ */
+void line_port_dma_irq_handler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LINE_PORT_H__ */
@@ -29,12 +29,100 @@ typedef struct {
 
 static pwm_port_state_t g_pwm_state = {0};  /**< PWM端口层状态 */
 
+/**
+ * @brief 各电机的比较寄存器地址 (下标为tb6612_motor_t)
+ * @note pwm_port_init()中按TB6612_PWMx_CHANNEL计算，CCR1-CCR4地址连续
+ */
+static volatile uint32_t *g_pwm_ccr[TB6612_MOTOR_MAX] = {NULL};
+
+/**
+ * @brief 单个引脚在BSRR中的置位/复位位 (编译期常量)
+ */
+#define MOTOR_PIN_BSRR(pin, level)      ((level) ? (uint32_t)(pin) : ((uint32_t)(pin) << 16U))
+
+/**
+ * @brief IN1/IN2各自在四种方向下的BSRR位，按tb6612_direction_t顺序 (STOP, FORWARD, BACKWARD, BRAKE)
+ */
+#define MOTOR_IN1_BSRR_ROW(pin)         { MOTOR_PIN_BSRR(pin, 0), MOTOR_PIN_BSRR(pin, 1), \
+                                          MOTOR_PIN_BSRR(pin, 0), MOTOR_PIN_BSRR(pin, 1) }
+#define MOTOR_IN2_BSRR_ROW(pin)         { MOTOR_PIN_BSRR(pin, 0), MOTOR_PIN_BSRR(pin, 0), \
+                                          MOTOR_PIN_BSRR(pin, 1), MOTOR_PIN_BSRR(pin, 1) }
+
+#define MOTOR_DIR_COUNT                 4U  /**< 方向数量 (STOP..BRAKE) */
+
+static const uint32_t k_in1_bsrr[TB6612_MOTOR_MAX][MOTOR_DIR_COUNT] = {
+    MOTOR_IN1_BSRR_ROW(TB6612_AIN1_PIN),
+    MOTOR_IN1_BSRR_ROW(TB6612_BIN1_PIN),
+};
+
+static const uint32_t k_in2_bsrr[TB6612_MOTOR_MAX][MOTOR_DIR_COUNT] = {
+    MOTOR_IN2_BSRR_ROW(TB6612_AIN2_PIN),
+    MOTOR_IN2_BSRR_ROW(TB6612_BIN2_PIN),
+};
+
+/**
+ * @brief 一次方向引脚写入 (同一GPIO端口的置位/复位合并为一个BSRR值)
+ */
+typedef struct {
+    GPIO_TypeDef *port;                 /**< GPIO端口 */
+    uint32_t bsrr;                      /**< 写入BSRR的值 */
+} motor_pin_write_t;
+
+/**
+ * @brief 一个电机切换到某个方向所需的写入 (IN1/IN2同端口时只有一次)
+ */
+typedef struct {
+    motor_pin_write_t writes[2];        /**< 引脚写入 */
+    uint8_t count;                      /**< 写入数量 (1或2) */
+} motor_dir_bsrr_t;
+
+/**
+ * @brief 各电机各方向的写入表 (下标为tb6612_motor_t、tb6612_direction_t)
+ * @note BSRR位是编译期常量，端口是否相同在motor_port_init()中合并一次
+ */
+static motor_dir_bsrr_t g_dir_bsrr[TB6612_MOTOR_MAX][MOTOR_DIR_COUNT];
+
+/**
+ * @brief 一组暂存的方向引脚写入 (最多每个方向引脚一个端口)
+ */
+typedef struct {
+    motor_pin_write_t writes[4];        /**< 写入 */
+    uint8_t count;                      /**< 写入数量 */
+} motor_pin_batch_t;
+
+/**
+ * @brief 双电机同步提交状态
+ * @note now/later/staged_dir/braking只在更新中断关闭时由调用者写入，中断中读取；
+ *       applied_dir为引脚上的实际方向。正反转切换时第一个更新事件先写制动(IN1=IN2=1)，
+ *       brake_left个更新事件后再写新方向
+ */
+typedef struct {
+    motor_pin_batch_t now;                          /**< 下一个更新事件写出的引脚 */
+    motor_pin_batch_t later;                        /**< 制动结束后写出的引脚 */
+    tb6612_direction_t staged_dir[TB6612_MOTOR_MAX];  /**< 暂存方向 (制动后的最终方向) */
+    bool braking[TB6612_MOTOR_MAX];                 /**< 是否处于反向前的制动中 */
+    volatile uint16_t brake_left;                   /**< 制动剩余更新事件数 */
+    volatile uint16_t brake_periods;                /**< 反向制动持续的PWM周期数，0表示不制动 */
+    volatile tb6612_direction_t applied_dir[TB6612_MOTOR_MAX];  /**< 已写入引脚的方向 */
+    volatile bool stats_reset;                      /**< 请求在下次中断清零统计 */
+    motor_port_sync_stats_t stats;                  /**< 同步统计 */
+} motor_sync_state_t;
+
+static motor_sync_state_t g_motor_sync = {0};
+
 /* ========================================================================== */
 /*                              私有函数声明                                  */
 /* ========================================================================== */
 
 static int32_t calculate_pwm_parameters(uint32_t frequency, uint16_t *prescaler, uint16_t *period);
 static tb6612_error_t configure_motor_gpio(void);
+static void motor_dir_build_table(void);
+static void motor_dir_write(tb6612_motor_t motor, tb6612_direction_t direction);
+static bool motor_dir_is_reversal(tb6612_direction_t from, tb6612_direction_t to);
+static void motor_batch_add(motor_pin_batch_t *batch, tb6612_motor_t motor, tb6612_direction_t direction);
+static void motor_batch_write(motor_pin_batch_t *batch);
+static tb6612_error_t motor_sync_stage_dir(tb6612_motor_t motor, tb6612_direction_t direction);
+static void motor_sync_flush(void);
 
 /* ========================================================================== */
 /*                              端口层接口实现                                */
@@ -57,21 +145,31 @@ tb6612_error_t motor_port_init(const tb6612_config_t *config)
     if (ret != TB6612_OK) {
         return ret;
     }
+    motor_dir_build_table();
     
     /* 初始化PWM */
     if (pwm_port_init(config->pwm_frequency) != 0) {
         return TB6612_ERROR_HARDWARE_FAULT;
     }
     
-    /* 停止所有PWM输出，确保电机初始状态为停止 */
-    pwm_port_stop(1);  /* 电机A */
-    pwm_port_stop(2);  /* 电机B */
+    /* 占空比清零后启动两路PWM并保持使能，之后只改写比较寄存器 */
+    motor_port_set_duty_raw(TB6612_MOTOR_A, 0);
+    motor_port_set_duty_raw(TB6612_MOTOR_B, 0);
+    if (pwm_port_start(1) != 0 || pwm_port_start(2) != 0) {
+        return TB6612_ERROR_HARDWARE_FAULT;
+    }
+    
+    /* 同步提交使用的更新中断，平时关闭，仅在方向切换时打开一次 */
+    memset(&g_motor_sync, 0, sizeof(g_motor_sync));
+    __HAL_TIM_DISABLE_IT(&htim1, TIM_IT_UPDATE);
+    __HAL_TIM_CLEAR_FLAG(&htim1, TIM_FLAG_UPDATE);
+    HAL_NVIC_SetPriority(TB6612_PWM_UP_IRQn, TB6612_PWM_UP_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(TB6612_PWM_UP_IRQn);
+    motor_port_set_reverse_brake_us(TB6612_REVERSE_BRAKE_US);
     
     /* 设置所有方向控制引脚为低电平（停止状态） */
-    gpio_port_set_pin(TB6612_AIN1_PORT, TB6612_AIN1_PIN, 0);
-    gpio_port_set_pin(TB6612_AIN2_PORT, TB6612_AIN2_PIN, 0);
-    gpio_port_set_pin(TB6612_BIN1_PORT, TB6612_BIN1_PIN, 0);
-    gpio_port_set_pin(TB6612_BIN2_PORT, TB6612_BIN2_PIN, 0);
+    motor_dir_write(TB6612_MOTOR_A, TB6612_STOP);
+    motor_dir_write(TB6612_MOTOR_B, TB6612_STOP);
     
     return TB6612_OK;
 }
@@ -81,78 +179,54 @@ tb6612_error_t motor_port_init(const tb6612_config_t *config)
  */
 tb6612_error_t motor_port_deinit(void)
 {
+    /* 关闭同步提交中断 */
+    __HAL_TIM_DISABLE_IT(&htim1, TIM_IT_UPDATE);
+    HAL_NVIC_DisableIRQ(TB6612_PWM_UP_IRQn);
+    
     /* 停止所有PWM输出 */
     pwm_port_stop(1);
     pwm_port_stop(2);
     
     /* 设置所有GPIO为低电平 */
-    gpio_port_set_pin(TB6612_AIN1_PORT, TB6612_AIN1_PIN, 0);
-    gpio_port_set_pin(TB6612_AIN2_PORT, TB6612_AIN2_PIN, 0);
-    gpio_port_set_pin(TB6612_BIN1_PORT, TB6612_BIN1_PIN, 0);
-    gpio_port_set_pin(TB6612_BIN2_PORT, TB6612_BIN2_PIN, 0);
+    motor_dir_write(TB6612_MOTOR_A, TB6612_STOP);
+    motor_dir_write(TB6612_MOTOR_B, TB6612_STOP);
     
     /* 清零PWM状态 */
     memset(&g_pwm_state, 0, sizeof(pwm_port_state_t));
+    g_pwm_ccr[TB6612_MOTOR_A] = NULL;
+    g_pwm_ccr[TB6612_MOTOR_B] = NULL;
     
     return TB6612_OK;
 }
 
 /**
  * @brief 设置电机方向
+ * @note 每个端口一次BSRR写入；正反转切换且开启反向制动时，先制动并忙等制动时间
  */
 tb6612_error_t motor_port_set_direction(tb6612_motor_t motor, tb6612_direction_t direction)
 {
+    uint32_t wait_cycles;
+    uint32_t start;
+    
     /* 参数检查 */
-    if (motor >= TB6612_MOTOR_MAX) {
+    if (motor >= TB6612_MOTOR_MAX || (uint32_t)direction >= MOTOR_DIR_COUNT) {
         return TB6612_ERROR_INVALID_PARAM;
     }
     
-    if (motor == TB6612_MOTOR_A) {
-        /* 电机A方向控制 */
-        switch (direction) {
-            case TB6612_STOP:
-                gpio_port_set_pin(TB6612_AIN1_PORT, TB6612_AIN1_PIN, 0);
-                gpio_port_set_pin(TB6612_AIN2_PORT, TB6612_AIN2_PIN, 0);
-                break;
-            case TB6612_FORWARD:
-                gpio_port_set_pin(TB6612_AIN1_PORT, TB6612_AIN1_PIN, 1);
-                gpio_port_set_pin(TB6612_AIN2_PORT, TB6612_AIN2_PIN, 0);
-                break;
-            case TB6612_BACKWARD:
-                gpio_port_set_pin(TB6612_AIN1_PORT, TB6612_AIN1_PIN, 0);
-                gpio_port_set_pin(TB6612_AIN2_PORT, TB6612_AIN2_PIN, 1);
-                break;
-            case TB6612_BRAKE:
-                gpio_port_set_pin(TB6612_AIN1_PORT, TB6612_AIN1_PIN, 1);
-                gpio_port_set_pin(TB6612_AIN2_PORT, TB6612_AIN2_PIN, 1);
-                break;
-            default:
-                return TB6612_ERROR_INVALID_PARAM;
-        }
-    } else if (motor == TB6612_MOTOR_B) {
-        /* 电机B方向控制 */
-        switch (direction) {
-            case TB6612_STOP:
-                gpio_port_set_pin(TB6612_BIN1_PORT, TB6612_BIN1_PIN, 0);
-                gpio_port_set_pin(TB6612_BIN2_PORT, TB6612_BIN2_PIN, 0);
-                break;
-            case TB6612_FORWARD:
-                gpio_port_set_pin(TB6612_BIN1_PORT, TB6612_BIN1_PIN, 1);
-                gpio_port_set_pin(TB6612_BIN2_PORT, TB6612_BIN2_PIN, 0);
-                break;
-            case TB6612_BACKWARD:
-                gpio_port_set_pin(TB6612_BIN1_PORT, TB6612_BIN1_PIN, 0);
-                gpio_port_set_pin(TB6612_BIN2_PORT, TB6612_BIN2_PIN, 1);
-                break;
-            case TB6612_BRAKE:
-                gpio_port_set_pin(TB6612_BIN1_PORT, TB6612_BIN1_PIN, 1);
-                gpio_port_set_pin(TB6612_BIN2_PORT, TB6612_BIN2_PIN, 1);
-                break;
-            default:
-                return TB6612_ERROR_INVALID_PARAM;
+    /* 尚未生效的同步方向先立即写出，避免更新中断随后覆盖本次设置 */
+    motor_sync_flush();
+    
+    if (g_motor_sync.brake_periods > 0 && motor_dir_is_reversal(g_motor_sync.applied_dir[motor], direction)) {
+        motor_dir_write(motor, TB6612_BRAKE);
+        wait_cycles = (uint32_t)g_motor_sync.brake_periods * (SYSTEM_CLOCK_FREQ / g_pwm_state.frequency);
+        start = DWT->CYCCNT;
+        while ((DWT->CYCCNT - start) < wait_cycles) {
         }
     }
     
+    motor_dir_write(motor, direction);
+    g_motor_sync.applied_dir[motor] = direction;
+    
     return TB6612_OK;
 }
 
@@ -161,35 +235,196 @@ tb6612_error_t motor_port_set_direction(tb6612_motor_t motor, tb6612_direction_t
  */
 tb6612_error_t motor_port_set_speed(tb6612_motor_t motor, uint16_t speed_percent)
 {
-    uint8_t channel;
-    
     /* 参数检查 */
     if (motor >= TB6612_MOTOR_MAX || speed_percent > 100) {
         return TB6612_ERROR_INVALID_PARAM;
     }
     
-    /* 确定PWM通道 */
-    if (motor == TB6612_MOTOR_A) {
-        channel = 1;  /* TIM1_CH1 */
-    } else {
-        channel = 2;  /* TIM1_CH2 */
+    /* 百分比换算为原始占空比，通道保持使能 */
+    return motor_port_set_duty_raw(motor, (uint16_t)(((uint32_t)speed_percent * TB6612_DUTY_FULL) / 100U));
+}
+
+/**
+ * @brief 以原始分辨率设置电机占空比
+ */
+tb6612_error_t motor_port_set_duty_raw(tb6612_motor_t motor, uint16_t duty)
+{
+    /* 参数检查 */
+    if (motor >= TB6612_MOTOR_MAX || duty > TB6612_DUTY_FULL) {
+        return TB6612_ERROR_INVALID_PARAM;
     }
-    
-    /* 设置PWM占空比 */
-    if (pwm_port_set_duty(channel, speed_percent) != 0) {
-        return TB6612_ERROR_HARDWARE_FAULT;
+
+    if (g_pwm_ccr[motor] == NULL) {
+        return TB6612_ERROR_NOT_INITIALIZED;
     }
-    
-    /* 启动或停止PWM输出 */
-    if (speed_percent > 0) {
-        pwm_port_start(channel);
-    } else {
-        pwm_port_stop(channel);
+
+    /* 比较值 = duty/满量程 × 周期计数，满量程时等于周期计数 (100%高电平) */
+    *g_pwm_ccr[motor] = ((uint32_t)duty * g_pwm_state.period) / TB6612_DUTY_FULL;
+
+    return TB6612_OK;
+}
+
+/**
+ * @brief 同步设置两路电机的方向和原始占空比
+ */
+tb6612_error_t motor_port_set_pair_sync(uint16_t duty_a, tb6612_direction_t dir_a,
+                                        uint16_t duty_b, tb6612_direction_t dir_b)
+{
+    TIM_TypeDef *tim = htim1.Instance;
+    tb6612_error_t ret;
+
+    /* 参数检查 */
+    if (duty_a > TB6612_DUTY_FULL || duty_b > TB6612_DUTY_FULL) {
+        return TB6612_ERROR_INVALID_PARAM;
     }
-    
+
+    /* 方向先整体检查，暂存过程中不会半途失败而留下一半的制动状态 */
+    if ((uint32_t)dir_a >= MOTOR_DIR_COUNT || (uint32_t)dir_b >= MOTOR_DIR_COUNT) {
+        return TB6612_ERROR_INVALID_PARAM;
+    }
+
+    if (g_pwm_ccr[TB6612_MOTOR_A] == NULL || g_pwm_ccr[TB6612_MOTOR_B] == NULL) {
+        return TB6612_ERROR_NOT_INITIALIZED;
+    }
+
+    /* 先关更新中断再禁止UEV: 之后中断不会读到写了一半的暂存区，
+     * 两路CCR预装载值也不会被周期边界拆开 */
+    tim->DIER &= ~TIM_DIER_UIE;
+    tim->CR1 |= TIM_CR1_UDIS;
+
+    *g_pwm_ccr[TB6612_MOTOR_A] = ((uint32_t)duty_a * g_pwm_state.period) / TB6612_DUTY_FULL;
+    *g_pwm_ccr[TB6612_MOTOR_B] = ((uint32_t)duty_b * g_pwm_state.period) / TB6612_DUTY_FULL;
+
+    /* 与引脚当前方向比较，上一次未生效的暂存被本次覆盖 (进行中的反向制动继续计时) */
+    g_motor_sync.now.count = 0;
+    g_motor_sync.later.count = 0;
+    ret = motor_sync_stage_dir(TB6612_MOTOR_A, dir_a);
+    if (ret == TB6612_OK) {
+        ret = motor_sync_stage_dir(TB6612_MOTOR_B, dir_b);
+    }
+    if (ret != TB6612_OK) {
+        g_motor_sync.now.count = 0;
+        g_motor_sync.later.count = 0;
+        tim->CR1 &= ~TIM_CR1_UDIS;
+        return ret;
+    }
+
+    if (g_motor_sync.now.count > 0 || g_motor_sync.later.count > 0) {
+        tim->SR = ~TIM_SR_UIF;
+        tim->DIER |= TIM_DIER_UIE;
+    }
+
+    tim->CR1 &= ~TIM_CR1_UDIS;
+    g_motor_sync.stats.commits++;
+
     return TB6612_OK;
 }
 
+/**
+ * @brief TIM1更新中断处理
+ * @note UEV时两路新占空比已同时生效，此处紧接着写方向引脚；
+ *       UEV时刻由计数器当前值倒推 (TIM1时钟与HCLK同为SYSTEM_CLOCK_FREQ)。
+ *       有反向制动时中断保持打开，制动的PWM周期数到达后写出最终方向
+ */
+void motor_port_sync_irq_handler(void)
+{
+    TIM_TypeDef *tim = htim1.Instance;
+    uint32_t since_uev = tim->CNT * ((uint32_t)tim->PSC + 1U);
+    uint32_t entry = DWT->CYCCNT;
+    uint32_t first, last, skew;
+    uint8_t i;
+
+    if ((tim->SR & TIM_SR_UIF) == 0U || (tim->DIER & TIM_DIER_UIE) == 0U) {
+        return;
+    }
+
+    tim->SR = ~TIM_SR_UIF;
+
+    /* 只剩制动结束后的写入: 计数到期后写出最终方向 */
+    if (g_motor_sync.now.count == 0U) {
+        if (g_motor_sync.brake_left > 1U) {
+            g_motor_sync.brake_left--;
+            return;
+        }
+        tim->DIER &= ~TIM_DIER_UIE;
+        motor_batch_write(&g_motor_sync.later);
+        for (i = 0; i < TB6612_MOTOR_MAX; i++) {
+            if (g_motor_sync.braking[i]) {
+                g_motor_sync.applied_dir[i] = g_motor_sync.staged_dir[i];
+                g_motor_sync.braking[i] = false;
+            }
+        }
+        g_motor_sync.brake_left = 0;
+        return;
+    }
+
+    if (g_motor_sync.later.count == 0U) {
+        tim->DIER &= ~TIM_DIER_UIE;
+    }
+
+    first = DWT->CYCCNT;
+    motor_batch_write(&g_motor_sync.now);
+    last = DWT->CYCCNT;
+
+    for (i = 0; i < TB6612_MOTOR_MAX; i++) {
+        g_motor_sync.applied_dir[i] = g_motor_sync.braking[i] ? TB6612_BRAKE : g_motor_sync.staged_dir[i];
+    }
+
+    if (g_motor_sync.stats_reset) {
+        memset(&g_motor_sync.stats, 0, sizeof(g_motor_sync.stats));
+        g_motor_sync.stats_reset = false;
+    }
+
+    skew = since_uev + (last - entry);
+    g_motor_sync.stats.dir_commits++;
+    g_motor_sync.stats.skew_cycles_last = skew;
+    if (skew > g_motor_sync.stats.skew_cycles_max) {
+        g_motor_sync.stats.skew_cycles_max = skew;
+    }
+    if ((last - first) > g_motor_sync.stats.pin_skew_cycles_max) {
+        g_motor_sync.stats.pin_skew_cycles_max = last - first;
+    }
+}
+
+/**
+ * @brief 获取双电机同步提交统计
+ */
+void motor_port_get_sync_stats(motor_port_sync_stats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    /* 统计由中断更新，各字段独立读取，用于诊断足够 */
+    memcpy(stats, &g_motor_sync.stats, sizeof(*stats));
+}
+
+/**
+ * @brief 清零双电机同步提交统计
+ */
+void motor_port_reset_sync_stats(void)
+{
+    g_motor_sync.stats_reset = true;
+}
+
+/**
+ * @brief 设置正反转切换前的制动时间
+ */
+void motor_port_set_reverse_brake_us(uint32_t brake_us)
+{
+    uint32_t periods = 0;
+
+    /* 按PWM周期向上取整，同步提交以更新事件计时 */
+    if (brake_us > 0 && g_pwm_state.frequency > 0) {
+        periods = (brake_us * g_pwm_state.frequency + 999999UL) / 1000000UL;
+        if (periods > 0xFFFFUL) {
+            periods = 0xFFFFUL;
+        }
+    }
+
+    g_motor_sync.brake_periods = (uint16_t)periods;
+}
+
 /* ========================================================================== */
 /*                              PWM端口层实现                                */
 /* ========================================================================== */
@@ -230,9 +465,21 @@ int32_t pwm_port_init(uint32_t frequency)
     g_pwm_state.period = period;
     g_pwm_state.prescaler = prescaler;
     
+    /* 缓存比较寄存器地址，供原始占空比直接写入 */
+    g_pwm_ccr[TB6612_MOTOR_A] = &htim1.Instance->CCR1 + (TB6612_PWMA_CHANNEL >> 2);
+    g_pwm_ccr[TB6612_MOTOR_B] = &htim1.Instance->CCR1 + (TB6612_PWMB_CHANNEL >> 2);
+    
     return 0;
 }
 
+/**
+ * @brief 获取PWM周期计数
+ */
+uint32_t pwm_port_get_period(void)
+{
+    return g_pwm_state.initialized ? g_pwm_state.period : 0;
+}
+
 /**
  * @brief 设置PWM占空比
  */
@@ -379,6 +626,150 @@ int32_t gpio_port_set_pin(GPIO_TypeDef* port, uint16_t pin, uint8_t state)
 /*                              私有函数实现                                  */
 /* ========================================================================== */
 
+/**
+ * @brief 由编译期BSRR位生成各方向的写入表，IN1/IN2同端口时合并为一次写入
+ */
+static void motor_dir_build_table(void)
+{
+    GPIO_TypeDef *const in1_port[TB6612_MOTOR_MAX] = { TB6612_AIN1_PORT, TB6612_BIN1_PORT };
+    GPIO_TypeDef *const in2_port[TB6612_MOTOR_MAX] = { TB6612_AIN2_PORT, TB6612_BIN2_PORT };
+    motor_dir_bsrr_t *entry;
+    uint8_t m, d;
+
+    for (m = 0; m < TB6612_MOTOR_MAX; m++) {
+        for (d = 0; d < MOTOR_DIR_COUNT; d++) {
+            entry = &g_dir_bsrr[m][d];
+            entry->writes[0].port = in1_port[m];
+            if (in1_port[m] == in2_port[m]) {
+                entry->writes[0].bsrr = k_in1_bsrr[m][d] | k_in2_bsrr[m][d];
+                entry->count = 1;
+            } else {
+                entry->writes[0].bsrr = k_in1_bsrr[m][d];
+                entry->writes[1].port = in2_port[m];
+                entry->writes[1].bsrr = k_in2_bsrr[m][d];
+                entry->count = 2;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 立即写一个电机的方向引脚 (每个端口一次BSRR写入)
+ */
+static void motor_dir_write(tb6612_motor_t motor, tb6612_direction_t direction)
+{
+    const motor_dir_bsrr_t *entry = &g_dir_bsrr[motor][direction];
+    uint8_t i;
+
+    for (i = 0; i < entry->count; i++) {
+        entry->writes[i].port->BSRR = entry->writes[i].bsrr;
+    }
+}
+
+/**
+ * @brief 是否为正转与反转之间的直接切换
+ */
+static bool motor_dir_is_reversal(tb6612_direction_t from, tb6612_direction_t to)
+{
+    return (from == TB6612_FORWARD && to == TB6612_BACKWARD) ||
+           (from == TB6612_BACKWARD && to == TB6612_FORWARD);
+}
+
+/**
+ * @brief 把一个电机的方向写入加入暂存批次，同一端口合并到一个BSRR值
+ */
+static void motor_batch_add(motor_pin_batch_t *batch, tb6612_motor_t motor, tb6612_direction_t direction)
+{
+    const motor_dir_bsrr_t *entry = &g_dir_bsrr[motor][direction];
+    uint8_t i, j;
+
+    for (i = 0; i < entry->count; i++) {
+        for (j = 0; j < batch->count; j++) {
+            if (batch->writes[j].port == entry->writes[i].port) {
+                batch->writes[j].bsrr |= entry->writes[i].bsrr;
+                break;
+            }
+        }
+        if (j == batch->count) {
+            batch->writes[batch->count] = entry->writes[i];
+            batch->count++;
+        }
+    }
+}
+
+/**
+ * @brief 写出一个暂存批次并清空
+ */
+static void motor_batch_write(motor_pin_batch_t *batch)
+{
+    uint8_t i;
+
+    for (i = 0; i < batch->count; i++) {
+        batch->writes[i].port->BSRR = batch->writes[i].bsrr;
+    }
+    batch->count = 0;
+}
+
+/**
+ * @brief 暂存一个电机的方向，与引脚当前方向相同时不暂存
+ * @note 正反转直接切换且开启反向制动时，先暂存制动，最终方向留到制动结束后写出；
+ *       制动中再次提交相同方向时继续原来的制动计时
+ */
+static tb6612_error_t motor_sync_stage_dir(tb6612_motor_t motor, tb6612_direction_t direction)
+{
+    if ((uint32_t)direction >= MOTOR_DIR_COUNT) {
+        return TB6612_ERROR_INVALID_PARAM;
+    }
+
+    if (g_motor_sync.braking[motor]) {
+        if (g_motor_sync.staged_dir[motor] == direction) {
+            motor_batch_add(&g_motor_sync.later, motor, direction);
+            return TB6612_OK;
+        }
+        g_motor_sync.braking[motor] = false;  /* 引脚处于制动，按普通切换处理 */
+    }
+
+    g_motor_sync.staged_dir[motor] = direction;
+    if (g_motor_sync.applied_dir[motor] == direction) {
+        return TB6612_OK;
+    }
+
+    if (g_motor_sync.brake_periods > 0 && motor_dir_is_reversal(g_motor_sync.applied_dir[motor], direction)) {
+        motor_batch_add(&g_motor_sync.now, motor, TB6612_BRAKE);
+        motor_batch_add(&g_motor_sync.later, motor, direction);
+        g_motor_sync.braking[motor] = true;
+        g_motor_sync.brake_left = g_motor_sync.brake_periods;
+        g_motor_sync.stats.reverse_brakes++;
+        return TB6612_OK;
+    }
+
+    motor_batch_add(&g_motor_sync.now, motor, direction);
+
+    return TB6612_OK;
+}
+
+/**
+ * @brief 取消等待中的同步提交，并立即写出其方向引脚 (制动提前结束)
+ */
+static void motor_sync_flush(void)
+{
+    TIM_TypeDef *tim = htim1.Instance;
+    uint8_t i;
+
+    if (tim == NULL || (tim->DIER & TIM_DIER_UIE) == 0U) {
+        return;
+    }
+
+    tim->DIER &= ~TIM_DIER_UIE;
+    motor_batch_write(&g_motor_sync.now);
+    motor_batch_write(&g_motor_sync.later);
+    for (i = 0; i < TB6612_MOTOR_MAX; i++) {
+        g_motor_sync.applied_dir[i] = g_motor_sync.staged_dir[i];
+        g_motor_sync.braking[i] = false;
+    }
+    g_motor_sync.brake_left = 0;
+}
+
 /**
  * @brief 计算PWM参数
  * @param frequency 目标频率 (Hz)
@@ -69,7 +69,9 @@ tb6612_error_t motor_port_deinit(void);
  * @retval TB6612_OK 设置成功
  * @retval TB6612_ERROR_INVALID_PARAM 参数无效
  * 
- * @note 根据TB6612FNG真值表控制AIN1/AIN2或BIN1/BIN2引脚
+ * @note 根据TB6612FNG真值表控制AIN1/AIN2或BIN1/BIN2引脚。各方向的BSRR值由引脚宏在编译期生成，
+ *       IN1/IN2在同一端口时一次写入，不会出现既非旧方向也非新方向的中间状态；
+ *       正反转直接切换且开启反向制动时，先制动并忙等制动时间再写新方向
  */
 tb6612_error_t motor_port_set_direction(tb6612_motor_t motor, tb6612_direction_t direction);
 
@@ -81,10 +83,81 @@ tb6612_error_t motor_port_set_direction(tb6612_motor_t motor, tb6612_direction_t
  * @retval TB6612_OK 设置成功
  * @retval TB6612_ERROR_INVALID_PARAM 参数无效
  * 
- * @note 通过PWM占空比控制电机速度，0%为停止，100%为最大速度
+ * @note 通过PWM占空比控制电机速度，0%为停止，100%为最大速度；
+ *       换算为原始占空比后经motor_port_set_duty_raw()写入
  */
 tb6612_error_t motor_port_set_speed(tb6612_motor_t motor, uint16_t speed_percent);
 
+/**
+ * @brief 以原始分辨率设置电机占空比 (直接写比较寄存器)
+ * @param motor 电机标识
+ * @param duty 占空比 (0 - TB6612_DUTY_FULL)
+ * @return tb6612_error_t 错误码
+ * @retval TB6612_OK 设置成功
+ * @retval TB6612_ERROR_INVALID_PARAM 参数无效
+ * @retval TB6612_ERROR_NOT_INITIALIZED PWM未初始化
+ *
+ * @note PWM通道在motor_port_init()中启动后保持使能，此函数只写CCRx；
+ *       比较寄存器带预装载，新占空比在下一个PWM周期开始时生效
+ */
+tb6612_error_t motor_port_set_duty_raw(tb6612_motor_t motor, uint16_t duty);
+
+/**
+ * @brief 双电机同步提交统计 (DWT周期)
+ * @note 两路占空比在同一个更新事件(UEV)装载，skew为UEV到最后一个方向引脚写入的时间，
+ *       pin_skew为第一个到最后一个方向引脚写入的时间
+ */
+typedef struct {
+    uint32_t commits;                   /**< 同步提交次数 */
+    uint32_t dir_commits;               /**< 含方向切换的提交次数 (经更新中断) */
+    uint32_t skew_cycles_last;          /**< 最近一次方向切换的UEV→引脚延迟 */
+    uint32_t skew_cycles_max;           /**< 最大UEV→引脚延迟 */
+    uint32_t pin_skew_cycles_max;       /**< 最大引脚间延迟 */
+    uint32_t reverse_brakes;            /**< 正反转切换前插入制动的次数 */
+} motor_port_sync_stats_t;
+
+/**
+ * @brief 同步设置两路电机的方向和原始占空比
+ * @param duty_a 电机A占空比 (0 - TB6612_DUTY_FULL)
+ * @param dir_a 电机A方向
+ * @param duty_b 电机B占空比 (0 - TB6612_DUTY_FULL)
+ * @param dir_b 电机B方向
+ * @return tb6612_error_t 错误码
+ * @retval TB6612_OK 已暂存，在下一个PWM周期边界生效
+ * @retval TB6612_ERROR_INVALID_PARAM 参数无效
+ * @retval TB6612_ERROR_NOT_INITIALIZED PWM未初始化
+ *
+ * @note 写比较寄存器期间置位UDIS，两路占空比在同一个更新事件从预装载寄存器装载；
+ *       方向有变化时暂存BSRR值并打开TIM1更新中断，由motor_port_sync_irq_handler()
+ *       在该更新事件后立即写方向引脚。方向未变时不产生中断。
+ *       正反转直接切换时先写制动(IN1=IN2=1)，反向制动时间对应的PWM周期数后再写新方向
+ */
+tb6612_error_t motor_port_set_pair_sync(uint16_t duty_a, tb6612_direction_t dir_a,
+                                        uint16_t duty_b, tb6612_direction_t dir_b);
+
+/**
+ * @brief TIM1更新中断处理 (由TIM1_UP_TIM10_IRQHandler调用)
+ */
+void motor_port_sync_irq_handler(void);
+
+/**
+ * @brief 获取双电机同步提交统计
+ * @param stats 输出参数
+ */
+void motor_port_get_sync_stats(motor_port_sync_stats_t *stats);
+
+/**
+ * @brief 清零双电机同步提交统计
+ */
+void motor_port_reset_sync_stats(void);
+
+/**
+ * @brief 设置正反转切换前的制动时间
+ * @param brake_us 制动时间 (us)，按PWM周期向上取整；0表示直接反向
+ * @note motor_port_init()中按TB6612_REVERSE_BRAKE_US设置，需在其之后调用
+ */
+void motor_port_set_reverse_brake_us(uint32_t brake_us);
+
 /* ========================================================================== */
 /*                              PWM端口层接口                                */
 /* ========================================================================== */
@@ -108,6 +181,12 @@ int32_t pwm_port_init(uint32_t frequency);
  */
 int32_t pwm_port_set_duty(uint8_t channel, uint16_t duty_percent);
 
+/**
+ * @brief 获取PWM周期计数
+ * @return uint32_t 周期计数 (ARR+1)，未初始化时为0
+ */
+uint32_t pwm_port_get_period(void);
+
 /**
  * @brief 设置PWM频率
  * @param frequency PWM频率 (Hz)
@@ -35,6 +35,7 @@ static int32_t test_pwm_output(void);
 static int32_t test_motor_direction(void);
 static int32_t test_motor_speed(void);
 static int32_t test_motor_integration(void);
+static int32_t test_motor_sync(void);
 static void test_delay_ms(uint32_t ms);
 
 /* ========================================================================== */
@@ -98,6 +99,15 @@ int32_t motor_port_run_all_tests(void)
     }
     printf("电机集成测试通过\r\n");
     
+    /* 测试6: 双电机同步提交测试 */
+    printf("测试6: 双电机同步提交测试...\r\n");
+    result = test_motor_sync();
+    if (result != 0) {
+        printf("双电机同步提交测试失败: %ld\r\n", result);
+        return result;
+    }
+    printf("双电机同步提交测试通过\r\n");
+    
     printf("=== 所有测试通过! ===\r\n");
     return 0;
 }
@@ -325,6 +335,63 @@ static int32_t test_motor_integration(void)
     return 0;
 }
 
+/**
+ * @brief 双电机同步提交测试
+ * @note 反复正反转，检查每次方向切换都经过更新中断、正反转前插入制动，并打印DWT测得的最大延迟
+ */
+static int32_t test_motor_sync(void)
+{
+    tb6612_config_t config = {
+        .pwm_frequency = TEST_PWM_FREQUENCY,
+        .pwm_resolution = 10,
+        .max_duty_cycle = 95,
+        .min_duty_cycle = 5
+    };
+    motor_port_sync_stats_t stats;
+    uint16_t duty = (uint16_t)((TEST_SPEED_LOW * TB6612_DUTY_FULL) / 100U);
+    uint8_t i;
+    
+    /* 初始化端口层 */
+    if (motor_port_init(&config) != TB6612_OK) {
+        return -1;
+    }
+    
+    motor_port_reset_sync_stats();
+    
+    for (i = 0; i < 10; i++) {
+        tb6612_direction_t dir = (i & 1U) ? TB6612_BACKWARD : TB6612_FORWARD;
+        if (motor_port_set_pair_sync(duty, dir, duty, dir) != TB6612_OK) {
+            motor_port_deinit();
+            return -2;
+        }
+        test_delay_ms(TEST_DELAY_MS / 10);
+    }
+    
+    /* 停止: 方向切换为STOP同样经过更新中断 */
+    motor_port_set_pair_sync(0, TB6612_STOP, 0, TB6612_STOP);
+    test_delay_ms(1);
+    
+    motor_port_get_sync_stats(&stats);
+    printf("同步提交: %lu次, 方向切换%lu次, 反向制动%lu次, UEV→引脚最大%lu周期, 引脚间最大%lu周期\r\n",
+           (unsigned long)stats.commits, (unsigned long)stats.dir_commits,
+           (unsigned long)stats.reverse_brakes,
+           (unsigned long)stats.skew_cycles_max, (unsigned long)stats.pin_skew_cycles_max);
+    
+    motor_port_deinit();
+    
+    /* 10次正反转加1次停止，都应在更新中断中完成 */
+    if (stats.dir_commits != 11) {
+        return -3;
+    }
+    
+    /* 第一次从停止起步，其余9次为正反转直接切换，开启反向制动时每次都先制动 */
+    if (TB6612_REVERSE_BRAKE_US > 0 && stats.reverse_brakes != 9) {
+        return -4;
+    }
+    
+    return 0;
+}
+
 /**
  * @brief 测试延时函数
  * @param ms 延时毫秒数
@@ -41,6 +41,9 @@ extern "C" {
 /* UART配置 */
 #define WIT_UART_BAUDRATE           115200UL    /* UART波特率 */
 #define WIT_UART_TIMEOUT            1000UL      /* 1秒超时 */
+#define WIT_UART_TX_RING_SIZE       1024U       /* 中断发送环形缓冲 (2的幂)，115200bps下约89ms */
+#define WIT_UART_IRQn               USART1_IRQn
+#define WIT_UART_IRQ_PRIORITY       6           /* 低于I2C/DMA(5)，只搬运遥测字节 */
 
 /* ========================================================================== */
 /*                              延时配置                                      */
@@ -58,6 +61,100 @@ extern "C" {
  * - 这确保了HAL_Delay()函数的1ms精度
  */
 
+/* ========================================================================== */
+/*                              节拍定时器配置                                */
+/* ========================================================================== */
+
+/* IMU采样节拍 - 基本定时器TIM6 (APB1, 84MHz) */
+#define IMU_TICK_TIMER              TIM6
+#define IMU_TICK_IRQn               TIM6_DAC_IRQn
+#define IMU_TICK_IRQ_PRIORITY       6           /* 低于I2C/DMA(5)，完成中断可抢占节拍 */
+
+/* 电机控制节拍 - 基本定时器TIM7 (APB1, 84MHz) */
+#define CTRL_TICK_TIMER             TIM7
+#define CTRL_TICK_IRQn              TIM7_IRQn
+#define CTRL_TICK_IRQ_PRIORITY      4           /* 高于I2C/DMA(5)，保证1kHz控制周期抖动最小 */
+
+/* 按键扫描节拍 - 通用定时器TIM14 (APB1, 84MHz)，与TIM8触发/换相共用中断向量 (TIM8只请求DMA，不开中断) */
+#define KEY_TICK_TIMER              TIM14
+#define KEY_TICK_IRQn               TIM8_TRG_COM_TIM14_IRQn
+#define KEY_TICK_IRQ_PRIORITY       7           /* 最低: 扫描只有几次位运算，可被其他中断抢占 */
+
+/* ========================================================================== */
+/*                              编码器配置                                    */
+/* ========================================================================== */
+
+/*
+ * 左轮(电机A) - TIM2 (PA0/PA1, 32位, TI12四倍频)
+ * 右轮(电机B) - TIM3 (PA6/PA7, 16位, TI1二倍频)
+ * 两路计数模式不同，每转计数也不同；方向与电机正转相反时将符号改为-1
+ */
+#define ENCODER_LEFT_HANDLE         htim2
+#define ENCODER_RIGHT_HANDLE        htim3
+#define ENCODER_LEFT_SIGN           1
+#define ENCODER_RIGHT_SIGN          1
+
+/* 车轮每转计数 = 编码器线数 × 减速比 × 倍频 (默认13线、30:1减速) */
+#define ENCODER_LEFT_CPR            1560UL      /* 390线 × 4 */
+#define ENCODER_RIGHT_CPR           780UL       /* 390线 × 2 */
+
+/* 相邻两次TI1上升沿之间的计数 (四倍频为4，TI1二倍频为2) */
+#define ENCODER_LEFT_EDGE_COUNTS    4UL
+#define ENCODER_RIGHT_EDGE_COUNTS   2UL
+
+/* 车体几何 (里程计与米/秒换算) */
+#define WHEEL_RADIUS_M              0.0325f     /* 车轮半径 (m) */
+#define WHEEL_BASE_M                0.150f      /* 左右轮接地点间距 (m) */
+
+/* 低速边沿捕获中断，优先级须高于控制节拍(4) */
+#define ENCODER_LEFT_IRQn           TIM2_IRQn
+#define ENCODER_RIGHT_IRQn          TIM3_IRQn
+#define ENCODER_EDGE_IRQ_PRIORITY   3
+
+/* ========================================================================== */
+/*                              参数存储Flash配置                             */
+/* ========================================================================== */
+
+/* 使用最后一个扇区(扇区11, 128KB)保存掉电参数，Keil工程IROM1已相应缩小为0xE0000 */
+#define FLASH_PORT_SECTOR           FLASH_SECTOR_11
+#define FLASH_PORT_BASE_ADDR        0x080E0000UL
+#define FLASH_PORT_SIZE             0x00020000UL
+
+/* ========================================================================== */
+/*                              八路循迹传感器配置                            */
+/* ========================================================================== */
+
+/* PE0-PE7接八路循迹 (PE0为车体最左侧探头)，一次读取IDR得到全部8路 */
+#define LINE_SENSOR_GPIO            GPIOE
+#define LINE_SENSOR_SHIFT           0U          /* IDR中第0路所在位 */
+#define LINE_SENSOR_ACTIVE_LOW      0           /* 1: 探头压线时输出低电平 */
+
+/* 定时器触发DMA过采样: TIM8更新事件请求DMA2 Stream1 Channel7，把IDR低字节搬入循环缓冲；
+ * 每半缓冲(LINE_DMA_BLOCK_SAMPLES个采样)完成时中断一次，由应用层表决成一个读数。
+ * DMA2外设端口可访问AHB1上的GPIO；缓冲区须位于SRAM1/SRAM2 (DMA不能访问CCM) */
+#define LINE_DMA_TIMER              TIM8
+#define LINE_DMA_STREAM             DMA2_Stream1
+#define LINE_DMA_CHANNEL            DMA_CHANNEL_7   /* TIM8_UP */
+#define LINE_DMA_IRQn               DMA2_Stream1_IRQn
+#define LINE_DMA_IRQ_PRIORITY       5           /* 低于控制节拍(4)，节拍取最近一次表决结果 */
+#define LINE_DMA_RATE_HZ            20000UL     /* 默认采样率，每块0.5ms即2kHz输出 */
+#define LINE_DMA_BLOCK_SAMPLES      10U         /* 每半缓冲采样数，不超过15 (表决计数4位) */
+
+/* ========================================================================== */
+/*                              按键配置                                      */
+/* ========================================================================== */
+
+/* PF2-PF5接四个按键 (PF2为KEY0)，按下接地，一次读取IDR得到全部按键；
+ * CubeMX配置为无上下拉，启动扫描时由端口层改为内部上拉 */
+#define KEY_GPIO                    GPIOF
+#define KEY_SHIFT                   2U          /* IDR中KEY0所在位 */
+#define KEY_MASK                    0x0FU       /* 移位后的有效位 (4个按键) */
+#define KEY_ACTIVE_LOW              1           /* 1: 按下为低电平 */
+#define KEY_INTERNAL_PULLUP         1           /* 1: 使能内部上拉 (板上无外部上拉电阻) */
+
+/* I2C快速探测 */
+#define WIT_I2C_PROBE_TIMEOUT       2UL         /* 单地址探测超时(毫秒) */
+
 /* ========================================================================== */
 /*                              外设句柄声明                                  */
 /* ========================================================================== */
@@ -70,6 +167,7 @@ extern "C" {
 
 /* I2C句柄 - 请根据您的CubeMX配置修改句柄名称 */
 extern I2C_HandleTypeDef hi2c1;
+extern I2C_HandleTypeDef hi2c2;         /* 第二路传感器 */
 
 /* UART句柄 - 请根据您的CubeMX配置修改句柄名称 */
 extern UART_HandleTypeDef huart1;
@@ -99,9 +197,16 @@ extern UART_HandleTypeDef huart1;
 #define TB6612_PWM_TIMER            TIM1        /* PWM定时器 */
 #define TB6612_PWMA_CHANNEL         TIM_CHANNEL_1  /* 电机A PWM通道 (PE9) */
 #define TB6612_PWMB_CHANNEL         TIM_CHANNEL_2  /* 电机B PWM通道 (PE11) */
+#define TB6612_PWM_UP_IRQn          TIM1_UP_TIM10_IRQn
+#define TB6612_PWM_UP_IRQ_PRIORITY  2           /* 同步提交时翻转方向引脚，需先于控制节拍(4)和编码器(3) */
+#define TB6612_REVERSE_BRAKE_US     200         /* 正反转切换前的短路制动时间 (us)，0表示直接反向 */
 
 /* 定时器句柄声明 */
 extern TIM_HandleTypeDef htim1;
+extern TIM_HandleTypeDef htim2;             /* 左轮编码器 */
+extern TIM_HandleTypeDef htim3;             /* 右轮编码器 */
+extern TIM_HandleTypeDef htim6;             /* IMU采样节拍 (tick_port.c) */
+extern TIM_HandleTypeDef htim7;             /* 电机控制节拍 (tick_port.c) */
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,262 @@
+/**
+ * @file tick_port.c
+ * @brief STM32F407周期节拍与时间戳端口层实现
+ * @details 基于基本定时器TIM6/TIM7产生IMU采样节拍和控制节拍，TIM14产生按键扫描节拍，
+ *          基于DWT周期计数器提供时间戳。
+ * @date 2026-10-16
+ */
+
+#include "tick_port.h"
+#include "stm32f407_port_config.h"
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+#define TICK_TIMER_CLOCK_HZ     (SYSTEM_CLOCK_FREQ / 2UL)   /* APB1定时器时钟 84MHz */
+#define TICK_COUNTER_HZ         1000000UL                   /* 计数频率 1MHz */
+#define TICK_RATE_MIN_HZ        16UL                        /* 1MHz计数下16位自动重装载的下限 */
+#define TICK_RATE_MAX_HZ        10000UL
+
+/* ========================================================================== */
+/*                              私有变量                                      */
+/* ========================================================================== */
+
+TIM_HandleTypeDef htim6;                            /* IMU采样节拍定时器 */
+TIM_HandleTypeDef htim7;                            /* 控制节拍定时器 */
+TIM_HandleTypeDef htim14;                           /* 按键扫描节拍定时器 */
+
+static volatile tick_port_cb_t s_imu_tick_cb = NULL;  /* IMU节拍回调 */
+static volatile tick_port_cb_t s_ctrl_tick_cb = NULL; /* 控制节拍回调 */
+static volatile tick_port_cb_t s_key_tick_cb = NULL;  /* 按键节拍回调 */
+
+/* ========================================================================== */
+/*                              私有函数声明                                  */
+/* ========================================================================== */
+
+static void tick_port_cycles_init(void);
+static int32_t tick_port_timer_start(TIM_HandleTypeDef *htim, TIM_TypeDef *instance, uint32_t rate_hz,
+                                     IRQn_Type irqn, uint32_t priority);
+
+/* ========================================================================== */
+/*                              公共函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 启动IMU采样节拍
+ */
+int32_t tick_port_imu_start(uint32_t rate_hz, tick_port_cb_t cb)
+{
+    /* 参数检查 */
+    if (cb == NULL || rate_hz < TICK_RATE_MIN_HZ || rate_hz > TICK_RATE_MAX_HZ) {
+        return -1;
+    }
+
+    tick_port_cycles_init();
+    tick_port_imu_stop();
+
+    __HAL_RCC_TIM6_CLK_ENABLE();
+
+    s_imu_tick_cb = cb;
+
+    return tick_port_timer_start(&htim6, IMU_TICK_TIMER, rate_hz, IMU_TICK_IRQn, IMU_TICK_IRQ_PRIORITY);
+}
+
+/**
+ * @brief 停止IMU采样节拍
+ */
+void tick_port_imu_stop(void)
+{
+    if (htim6.Instance != NULL) {
+        HAL_TIM_Base_Stop_IT(&htim6);
+    }
+    s_imu_tick_cb = NULL;
+}
+
+/**
+ * @brief 启动控制节拍
+ */
+int32_t tick_port_ctrl_start(uint32_t rate_hz, tick_port_cb_t cb)
+{
+    /* 参数检查 */
+    if (cb == NULL || rate_hz < TICK_RATE_MIN_HZ || rate_hz > TICK_RATE_MAX_HZ) {
+        return -1;
+    }
+
+    tick_port_cycles_init();
+    tick_port_ctrl_stop();
+
+    __HAL_RCC_TIM7_CLK_ENABLE();
+
+    s_ctrl_tick_cb = cb;
+
+    return tick_port_timer_start(&htim7, CTRL_TICK_TIMER, rate_hz, CTRL_TICK_IRQn, CTRL_TICK_IRQ_PRIORITY);
+}
+
+/**
+ * @brief 停止控制节拍
+ */
+void tick_port_ctrl_stop(void)
+{
+    if (htim7.Instance != NULL) {
+        HAL_TIM_Base_Stop_IT(&htim7);
+    }
+    s_ctrl_tick_cb = NULL;
+}
+
+/**
+ * @brief 屏蔽或恢复控制节拍中断
+ */
+void tick_port_ctrl_mask(uint8_t masked)
+{
+    /* NVIC_DisableIRQ带DSB/ISB，返回后节拍回调不会再开始执行 */
+    if (masked) {
+        HAL_NVIC_DisableIRQ(CTRL_TICK_IRQn);
+    } else {
+        HAL_NVIC_EnableIRQ(CTRL_TICK_IRQn);
+    }
+}
+
+/**
+ * @brief 启动按键扫描节拍
+ */
+int32_t tick_port_key_start(uint32_t rate_hz, tick_port_cb_t cb)
+{
+    /* 参数检查 */
+    if (cb == NULL || rate_hz < TICK_RATE_MIN_HZ || rate_hz > TICK_RATE_MAX_HZ) {
+        return -1;
+    }
+
+    tick_port_cycles_init();
+    tick_port_key_stop();
+
+    __HAL_RCC_TIM14_CLK_ENABLE();
+
+    s_key_tick_cb = cb;
+
+    return tick_port_timer_start(&htim14, KEY_TICK_TIMER, rate_hz, KEY_TICK_IRQn, KEY_TICK_IRQ_PRIORITY);
+}
+
+/**
+ * @brief 停止按键扫描节拍
+ */
+void tick_port_key_stop(void)
+{
+    if (htim14.Instance != NULL) {
+        HAL_TIM_Base_Stop_IT(&htim14);
+    }
+    s_key_tick_cb = NULL;
+}
+
+/**
+ * @brief 读取CPU周期计数
+ */
+uint32_t tick_port_cycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief 每微秒对应的CPU周期数
+ */
+uint32_t tick_port_cycles_per_us(void)
+{
+    return SYSTEM_CLOCK_FREQ / 1000000UL;
+}
+
+/**
+ * @brief 上电以来的毫秒数
+ */
+uint32_t tick_port_uptime_ms(void)
+{
+    return HAL_GetTick();
+}
+
+/**
+ * @brief 毫秒换算为节拍数
+ */
+uint32_t tick_port_ms_to_ticks(uint32_t ms, uint32_t rate_hz)
+{
+    uint32_t ticks = (uint32_t)(((uint64_t)ms * rate_hz + 999U) / 1000U);
+
+    return (ticks > 0) ? ticks : 1U;
+}
+
+/* ========================================================================== */
+/*                              HAL中断回调                                   */
+/* ========================================================================== */
+
+/**
+ * @brief 定时器更新中断回调 (覆盖HAL弱定义)
+ * @note 所有使用HAL_TIM_IRQHandler的定时器共用此回调，按实例分发
+ */
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    tick_port_cb_t cb;
+
+    if (htim->Instance == CTRL_TICK_TIMER) {
+        cb = s_ctrl_tick_cb;
+        if (cb != NULL) {
+            cb();
+        }
+    } else if (htim->Instance == IMU_TICK_TIMER) {
+        cb = s_imu_tick_cb;
+        if (cb != NULL) {
+            cb();
+        }
+    } else if (htim->Instance == KEY_TICK_TIMER) {
+        cb = s_key_tick_cb;
+        if (cb != NULL) {
+            cb();
+        }
+    }
+}
+
+/* ========================================================================== */
+/*                              私有函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 以1MHz计数配置基本定时器并启动更新中断
+ * @param htim 定时器句柄
+ * @param instance 定时器实例 (TIM6/TIM7/TIM14)
+ * @param rate_hz 节拍频率 (Hz)
+ * @param irqn 中断号
+ * @param priority 抢占优先级
+ * @return int32_t 0: 成功, -2: 定时器初始化失败
+ * @note 调用前须已使能定时器时钟并设置好回调
+ */
+static int32_t tick_port_timer_start(TIM_HandleTypeDef *htim, TIM_TypeDef *instance, uint32_t rate_hz,
+                                     IRQn_Type irqn, uint32_t priority)
+{
+    htim->Instance = instance;
+    htim->Init.Prescaler = (TICK_TIMER_CLOCK_HZ / TICK_COUNTER_HZ) - 1;
+    htim->Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim->Init.Period = (TICK_COUNTER_HZ / rate_hz) - 1;
+    htim->Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+    if (HAL_TIM_Base_Init(htim) != HAL_OK) {
+        return -2;
+    }
+
+    HAL_NVIC_SetPriority(irqn, priority, 0);
+    HAL_NVIC_EnableIRQ(irqn);
+
+    if (HAL_TIM_Base_Start_IT(htim) != HAL_OK) {
+        return -2;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 确保DWT周期计数器已使能
+ * @note 与delay_port.c中的DWT初始化相同，重复调用无副作用
+ */
+static void tick_port_cycles_init(void)
+{
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+}
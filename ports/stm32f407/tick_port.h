@@ -0,0 +1,120 @@
+/**
+ * @file tick_port.h
+ * @brief STM32F407周期节拍与时间戳端口层接口
+ * @details 为应用层提供与硬件无关的周期中断节拍和DWT周期计数时间戳。
+ *          节拍由基本定时器产生，回调在定时器中断上下文中执行。
+ * @date 2026-10-16
+ *
+ * @note 定时器分配:
+ *       - TIM6: IMU采样节拍 (50-500Hz)
+ *       - TIM7: 电机速度闭环控制节拍 (1kHz)
+ *       - TIM14: 按键扫描节拍 (200-1000Hz)
+ */
+
+#ifndef TICK_PORT_H__
+#define TICK_PORT_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 节拍回调函数类型
+ * @note 在定时器中断中调用，必须短小且不可阻塞
+ */
+typedef void (*tick_port_cb_t)(void);
+
+/**
+ * @brief 启动IMU采样节拍
+ * @param rate_hz 节拍频率 (Hz)，范围: 16-10000 (16位定时器，1MHz计数)
+ * @param cb 节拍回调
+ * @return int32_t 错误码
+ * @retval 0 启动成功
+ * @retval -1 参数无效
+ * @retval -2 定时器初始化失败
+ * @note 重复调用会按新频率重新启动
+ */
+int32_t tick_port_imu_start(uint32_t rate_hz, tick_port_cb_t cb);
+
+/**
+ * @brief 停止IMU采样节拍
+ */
+void tick_port_imu_stop(void);
+
+/**
+ * @brief 启动控制节拍
+ * @param rate_hz 节拍频率 (Hz)，范围: 16-10000 (16位定时器，1MHz计数)
+ * @param cb 节拍回调
+ * @return int32_t 错误码
+ * @retval 0 启动成功
+ * @retval -1 参数无效
+ * @retval -2 定时器初始化失败
+ * @note 中断优先级高于IMU节拍和I2C，回调应在几微秒内完成
+ */
+int32_t tick_port_ctrl_start(uint32_t rate_hz, tick_port_cb_t cb);
+
+/**
+ * @brief 停止控制节拍
+ * @note 返回后回调不会再被调用
+ */
+void tick_port_ctrl_stop(void);
+
+/**
+ * @brief 屏蔽或恢复控制节拍中断
+ * @param masked 非0屏蔽，0恢复
+ * @note 屏蔽期间到来的节拍保持挂起，恢复后立即执行，不丢拍；
+ *       用于主循环与节拍回调写同一输出的短临界区 (几微秒)，其他中断不受影响
+ */
+void tick_port_ctrl_mask(uint8_t masked);
+
+/**
+ * @brief 启动按键扫描节拍
+ * @param rate_hz 节拍频率 (Hz)，范围: 16-10000 (16位定时器，1MHz计数)
+ * @param cb 节拍回调
+ * @return int32_t 错误码
+ * @retval 0 启动成功
+ * @retval -1 参数无效
+ * @retval -2 定时器初始化失败
+ * @note 中断优先级最低，回调可被控制节拍、编码器和DMA中断抢占
+ */
+int32_t tick_port_key_start(uint32_t rate_hz, tick_port_cb_t cb);
+
+/**
+ * @brief 停止按键扫描节拍
+ */
+void tick_port_key_stop(void);
+
+/**
+ * @brief 读取CPU周期计数 (DWT->CYCCNT)
+ * @return uint32_t 当前周期计数，168MHz下约25.6秒回绕一次
+ * @note 差值用无符号减法计算即可正确处理回绕
+ */
+uint32_t tick_port_cycles(void);
+
+/**
+ * @brief 每微秒对应的CPU周期数
+ * @return uint32_t 周期数
+ */
+uint32_t tick_port_cycles_per_us(void);
+
+/**
+ * @brief 上电(HAL_Init)以来的毫秒数
+ * @return uint32_t 毫秒计数 (SysTick)
+ */
+uint32_t tick_port_uptime_ms(void);
+
+/**
+ * @brief 毫秒换算为节拍数 (向上取整，至少1个节拍)
+ * @param ms 时长 (毫秒)
+ * @param rate_hz 节拍频率 (Hz)
+ * @return uint32_t 节拍数
+ */
+uint32_t tick_port_ms_to_ticks(uint32_t ms, uint32_t rate_hz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TICK_PORT_H__ */
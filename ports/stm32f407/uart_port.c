@@ -16,6 +16,11 @@
 
 #define UART_TIMEOUT_MS         WIT_UART_TIMEOUT   /* UART超时时间(毫秒) */
 #define UART_TX_BUFFER_SIZE     256                 /* 发送缓冲区大小 */
+#define UART_TX_RING_MASK       (WIT_UART_TX_RING_SIZE - 1U)
+
+#if (WIT_UART_TX_RING_SIZE & UART_TX_RING_MASK) != 0
+#error "WIT_UART_TX_RING_SIZE must be a power of two"
+#endif
 
 /* ========================================================================== */
 /*                              私有变量                                      */
@@ -23,6 +28,13 @@
 
 static uint8_t s_uart_initialized = 0;                     /* UART初始化标志 */
 static uint8_t s_tx_buffer[UART_TX_BUFFER_SIZE];           /* 发送缓冲区 */
+static volatile uint8_t s_text_enabled = 1;                /* printf文本输出使能 */
+
+/* 中断发送环形缓冲: 写索引只由主循环修改，读索引只由发送完成中断修改 */
+static uint8_t s_tx_ring[WIT_UART_TX_RING_SIZE];
+static volatile uint32_t s_tx_head = 0;                    /* 写索引 */
+static volatile uint32_t s_tx_tail = 0;                    /* 读索引 */
+static volatile uint16_t s_tx_chunk = 0;                   /* 进行中的中断发送长度，0表示空闲 */
 
 /* ========================================================================== */
 /*                              私有函数声明                                  */
@@ -30,6 +42,7 @@ static uint8_t s_tx_buffer[UART_TX_BUFFER_SIZE];           /* 发送缓冲区 */
 
 static HAL_StatusTypeDef uart_wait_tx_complete(void);
 static HAL_StatusTypeDef uart_transmit_data(uint8_t *data, uint16_t size);
+static void uart_tx_ring_start(void);
 
 /* ========================================================================== */
 /*                              公共函数实现                                  */
@@ -65,6 +78,10 @@ int32_t wit_port_uart_init(uint32_t uiBaud)
         }
     }
 
+    /* 非阻塞发送使用USART1发送完成中断 */
+    HAL_NVIC_SetPriority(WIT_UART_IRQn, WIT_UART_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(WIT_UART_IRQn);
+
     s_uart_initialized = 1;
     return 0;
 }
@@ -92,6 +109,57 @@ void wit_port_uart_write(uint8_t *p_ucData, uint32_t uiLen)
     uart_transmit_data(p_ucData, (uint16_t)uiLen);
 }
 
+/**
+ * @brief UART非阻塞发送
+ */
+int32_t wit_port_uart_write_async(const uint8_t *p_ucData, uint32_t uiLen)
+{
+    uint32_t head;
+    uint32_t i;
+
+    /* 参数检查 */
+    if (p_ucData == NULL || uiLen == 0) {
+        return -1;
+    }
+
+    /* 检查初始化状态 */
+    if (!s_uart_initialized) {
+        if (wit_port_uart_init(WIT_UART_BAUDRATE) != 0) {
+            return -1;
+        }
+    }
+
+    head = s_tx_head;
+    if (uiLen > WIT_UART_TX_RING_SIZE - (head - s_tx_tail)) {
+        return -2;
+    }
+
+    for (i = 0; i < uiLen; i++) {
+        s_tx_ring[(head + i) & UART_TX_RING_MASK] = p_ucData[i];
+    }
+
+    /* 先写数据再发布写索引 */
+    __COMPILER_BARRIER();
+    s_tx_head = head + uiLen;
+
+    /* 发送空闲时启动；屏蔽中断，避免与发送完成中断同时启动 */
+    HAL_NVIC_DisableIRQ(WIT_UART_IRQn);
+    if (s_tx_chunk == 0) {
+        uart_tx_ring_start();
+    }
+    HAL_NVIC_EnableIRQ(WIT_UART_IRQn);
+
+    return 0;
+}
+
+/**
+ * @brief 使能或屏蔽printf文本输出
+ */
+void wit_port_uart_text_enable(uint8_t enable)
+{
+    s_text_enabled = enable;
+}
+
 /* ========================================================================== */
 /*                              私有函数实现                                  */
 /* ========================================================================== */
@@ -122,6 +190,14 @@ static HAL_StatusTypeDef uart_wait_tx_complete(void)
 static HAL_StatusTypeDef uart_transmit_data(uint8_t *data, uint16_t size)
 {
     HAL_StatusTypeDef status;
+    uint32_t start_ms = HAL_GetTick();
+
+    /* 中断发送进行中时HAL_UART_Transmit会返回BUSY，先等待缓冲发完 */
+    while (s_tx_chunk != 0) {
+        if ((HAL_GetTick() - start_ms) > UART_TIMEOUT_MS) {
+            return HAL_TIMEOUT;
+        }
+    }
 
     /* 使用HAL库发送数据 */
     status = HAL_UART_Transmit(&huart1, data, size, UART_TIMEOUT_MS);
@@ -129,6 +205,44 @@ static HAL_StatusTypeDef uart_transmit_data(uint8_t *data, uint16_t size)
     return status;
 }
 
+/**
+ * @brief 从环形缓冲启动下一段中断发送
+ * @note 在屏蔽USART1中断时或发送完成中断中调用；每段不跨越缓冲末尾
+ */
+static void uart_tx_ring_start(void)
+{
+    uint32_t tail = s_tx_tail;
+    uint32_t offset = tail & UART_TX_RING_MASK;
+    uint32_t len = s_tx_head - tail;
+
+    if (len > WIT_UART_TX_RING_SIZE - offset) {
+        len = WIT_UART_TX_RING_SIZE - offset;
+    }
+    s_tx_chunk = (uint16_t)len;
+
+    /* 阻塞发送占用串口时启动失败，数据留在缓冲中，由下一次写入重新启动 */
+    if (len != 0 && HAL_UART_Transmit_IT(&huart1, &s_tx_ring[offset], (uint16_t)len) != HAL_OK) {
+        s_tx_chunk = 0;
+    }
+}
+
+/* ========================================================================== */
+/*                              HAL中断回调                                   */
+/* ========================================================================== */
+
+/**
+ * @brief UART发送完成回调: 释放已发出的一段并继续发送
+ */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart != &huart1) {
+        return;
+    }
+
+    s_tx_tail += s_tx_chunk;
+    uart_tx_ring_start();
+}
+
 /* ========================================================================== */
 /*                              重定向支持                                    */
 /* ========================================================================== */
@@ -143,7 +257,9 @@ static HAL_StatusTypeDef uart_transmit_data(uint8_t *data, uint16_t size)
  */
 int _write(int file, char *ptr, int len)
 {
-    wit_port_uart_write((uint8_t*)ptr, len);
+    if (s_text_enabled) {
+        wit_port_uart_write((uint8_t*)ptr, len);
+    }
     return len;
 }
 #endif
@@ -158,7 +274,9 @@ int _write(int file, char *ptr, int len)
 int fputc(int ch, FILE *f)
 {
     uint8_t data = (uint8_t)ch;
-    wit_port_uart_write(&data, 1);
+    if (s_text_enabled) {
+        wit_port_uart_write(&data, 1);
+    }
     return ch;
 }
 #endif
@@ -172,7 +290,9 @@ int fputc(int ch, FILE *f)
 int putchar(int ch)
 {
     uint8_t data = (uint8_t)ch;
-    wit_port_uart_write(&data, 1);
+    if (s_text_enabled) {
+        wit_port_uart_write(&data, 1);
+    }
     return ch;
 }
 #endif
@@ -28,7 +28,7 @@ int32_t wit_port_i2c_init(void);
 
 /**
  * @brief I2C写寄存器
- * @param ucAddr 设备地址 (7位地址，不包含读写位)
+ * @param ucAddr 设备地址 (8位写地址，即7位地址左移1位，WIT SDK已完成移位)
  * @param ucReg 寄存器地址
  * @param p_ucVal 要写入的数据指针
  * @param uiLen 数据长度
@@ -39,7 +39,7 @@ int32_t wit_port_i2c_write(uint8_t ucAddr, uint8_t ucReg, uint8_t *p_ucVal, uint
 
 /**
  * @brief I2C读寄存器
- * @param ucAddr 设备地址 (7位地址，不包含读写位)
+ * @param ucAddr 设备地址 (8位写地址，即7位地址左移1位，WIT SDK已完成移位)
  * @param ucReg 寄存器地址
  * @param p_ucVal 读取数据存储指针
  * @param uiLen 要读取的数据长度
@@ -48,6 +48,48 @@ int32_t wit_port_i2c_write(uint8_t ucAddr, uint8_t ucReg, uint8_t *p_ucVal, uint
  */
 int32_t wit_port_i2c_read(uint8_t ucAddr, uint8_t ucReg, uint8_t *p_ucVal, uint32_t uiLen);
 
+/**
+ * @brief I2C异步读完成回调
+ * @param p_ctx 启动传输时传入的上下文
+ * @param result 0: 成功, 其他: 失败
+ * @note 在I2C/DMA中断上下文中调用
+ */
+typedef void (*wit_port_i2c_done_t)(void *p_ctx, int32_t result);
+
+/**
+ * @brief I2C异步读寄存器 (DMA优先，未配置DMA时使用中断方式)
+ * @param ucAddr 设备地址 (8位写地址，即7位地址左移1位，WIT SDK已完成移位)
+ * @param ucReg 寄存器地址
+ * @param p_ucVal 读取数据存储指针，传输完成前必须保持有效
+ * @param uiLen 要读取的数据长度
+ * @param done 完成回调，传输结束(成功或出错)后在中断中调用一次
+ * @param p_ctx 回调上下文
+ * @return 1: 传输已启动, 0: 总线忙或参数错误
+ * @note 立即返回，不等待总线；同一总线同时只能有一个异步传输
+ */
+int32_t wit_port_i2c_read_async(uint8_t ucAddr, uint8_t ucReg, uint8_t *p_ucVal, uint32_t uiLen,
+                                wit_port_i2c_done_t done, void *p_ctx);
+
+/**
+ * @brief 快速探测I2C设备地址
+ * @param ucAddr7 7位设备地址
+ * @return 1: 设备应答, 0: 无应答
+ * @note 使用HAL_I2C_IsDeviceReady，超时WIT_I2C_PROBE_TIMEOUT毫秒且不重试，
+ *       适合启动时快速查找传感器
+ */
+int32_t wit_port_i2c_probe(uint8_t ucAddr7);
+
+/**
+ * @brief I2C2端口层初始化/读写 (第二路传感器)
+ * @note 参数与返回值同I2C1版本，配合WitDevI2cFuncRegister()注册到第二个wit_dev_t
+ */
+int32_t wit_port_i2c2_init(void);
+int32_t wit_port_i2c2_write(uint8_t ucAddr, uint8_t ucReg, uint8_t *p_ucVal, uint32_t uiLen);
+int32_t wit_port_i2c2_read(uint8_t ucAddr, uint8_t ucReg, uint8_t *p_ucVal, uint32_t uiLen);
+int32_t wit_port_i2c2_read_async(uint8_t ucAddr, uint8_t ucReg, uint8_t *p_ucVal, uint32_t uiLen,
+                                 wit_port_i2c_done_t done, void *p_ctx);
+int32_t wit_port_i2c2_probe(uint8_t ucAddr7);
+
 /* ========================================================================== */
 /*                             UART 端口层接口                               */
 /* ========================================================================== */
@@ -63,10 +105,27 @@ int32_t wit_port_uart_init(uint32_t uiBaud);
  * @brief UART发送数据
  * @param p_ucData 要发送的数据指针
  * @param uiLen 数据长度
- * @note 此函数用于串口数据输出，通常用于调试信息打印
+ * @note 此函数用于串口数据输出，通常用于调试信息打印；
+ *       阻塞发送，先等待中断发送缓冲中的数据发完
  */
 void wit_port_uart_write(uint8_t *p_ucData, uint32_t uiLen);
 
+/**
+ * @brief UART非阻塞发送
+ * @param p_ucData 要发送的数据指针
+ * @param uiLen 数据长度
+ * @return int32_t 0: 已放入发送缓冲, -1: 参数无效或UART未初始化, -2: 缓冲剩余空间不足，整块丢弃
+ * @note 数据复制到环形缓冲后立即返回，由USART1发送完成中断逐段发出；仅主循环调用
+ */
+int32_t wit_port_uart_write_async(const uint8_t *p_ucData, uint32_t uiLen);
+
+/**
+ * @brief 使能或屏蔽printf文本输出
+ * @param enable 0: printf重定向丢弃文本, 非0: 正常输出
+ * @note 二进制遥测期间屏蔽文本，避免文本字节混入COBS帧流
+ */
+void wit_port_uart_text_enable(uint8_t enable);
+
 /* ========================================================================== */
 /*                             延时端口层接口                                 */
 /* ========================================================================== */
@@ -0,0 +1,400 @@
+/**
+ * @file attitude_replay.c
+ * @brief 姿态滤波主机端回放验证工具
+ * @details 直接编译app/attitude_filter.c和所需的CMSIS-DSP四元数函数，按采样顺序喂入
+ *          角速度/加速度，与JY61P模块输出的角度比较:
+ *          - 对准后Roll/Pitch误差的均方根和最大值不超过容差
+ *          - 误差随时间的漂移率 (最小二乘斜率) 不超过容差；Yaw无加速度修正，
+ *            只比较相对对准时刻的变化，检查其漂移率
+ *          内置合成轨迹含横滚摆动、俯仰保持、转向、短时纵向加速度干扰和长时间静止，
+ *          陀螺带零偏和噪声，测量和参考角度均按JY61P寄存器分辨率量化。
+ * @date 2026-10-16
+ *
+ * @usage 编译 (仓库根目录):
+ *          gcc -O2 -Wall -Wextra -Iapp -IDrivers/CMSIS/DSP/Include -IDrivers/CMSIS/Include \
+ *              -o attitude_replay tools/attitude_replay.c app/attitude_filter.c \
+ *              Drivers/CMSIS/DSP/Source/QuaternionMathFunctions/arm_quaternion_product_single_f32.c \
+ *              Drivers/CMSIS/DSP/Source/QuaternionMathFunctions/arm_quaternion_normalize_f32.c -lm
+ *        运行:
+ *          ./attitude_replay                   # 内置合成轨迹
+ *          ./attitude_replay --log run.csv     # telemetry_decode.py --csv输出中的imu行
+ *          选项: --kp --ki 滤波增益, --settle <s> 对准后跳过的时间,
+ *                --rms --max <°> 误差容差, --drift <°/min> 漂移容差, --csv 输出逐样本角度
+ *        有检查不通过时返回1
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "attitude_filter.h"
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+#define REPLAY_RATE_HZ              200U    /**< 与JY61P_SAMPLE_RATE_HZ一致 */
+#define REPLAY_SYNTH_S              60.0    /**< 合成轨迹时长 */
+#define REPLAY_ACC_LSB_G            (16.0 / 32768.0)    /**< JY61P寄存器分辨率 */
+#define REPLAY_GYRO_LSB_DPS         (2000.0 / 32768.0)
+#define REPLAY_ANGLE_LSB_DEG        (180.0 / 32768.0)
+#define REPLAY_PI                   3.14159265358979
+#define REPLAY_D2R                  (REPLAY_PI / 180.0)
+
+/* ========================================================================== */
+/*                              桩函数                                        */
+/* ========================================================================== */
+
+uint32_t tick_port_cycles(void)
+{
+    return 0;
+}
+
+/* ========================================================================== */
+/*                              误差统计                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 单轴误差统计 (含最小二乘斜率)
+ */
+typedef struct {
+    double n;
+    double sum_e2;
+    double max_abs;
+    double st, se, stt, ste;        /* 斜率拟合的累加量 */
+} replay_err_t;
+
+static void err_add(replay_err_t *e, double t, double err)
+{
+    e->n += 1.0;
+    e->sum_e2 += err * err;
+    if (fabs(err) > e->max_abs) {
+        e->max_abs = fabs(err);
+    }
+    e->st += t;
+    e->se += err;
+    e->stt += t * t;
+    e->ste += t * err;
+}
+
+static double err_rms(const replay_err_t *e)
+{
+    return (e->n > 0.0) ? sqrt(e->sum_e2 / e->n) : 0.0;
+}
+
+/**
+ * @brief 误差漂移率 (°/min)
+ */
+static double err_slope(const replay_err_t *e)
+{
+    double den = e->n * e->stt - e->st * e->st;
+
+    return (den > 0.0) ? 60.0 * (e->n * e->ste - e->st * e->se) / den : 0.0;
+}
+
+/**
+ * @brief 角度差归一化到(-180, 180]
+ */
+static double wrap_180(double a)
+{
+    while (a > 180.0) {
+        a -= 360.0;
+    }
+    while (a <= -180.0) {
+        a += 360.0;
+    }
+    return a;
+}
+
+static double quantize(double v, double lsb)
+{
+    return floor(v / lsb + 0.5) * lsb;
+}
+
+/* ========================================================================== */
+/*                              回放                                          */
+/* ========================================================================== */
+
+/**
+ * @brief 回放参数和结果
+ */
+typedef struct {
+    double settle_s;                /**< 对准后跳过的时间 */
+    int csv;                        /**< 输出逐样本角度 */
+    uint8_t aligned;                /**< 已对准 (首个有效更新之后) */
+    double t_start;                 /**< 开始统计的时刻 */
+    double yaw_offset;              /**< 开始统计时的Yaw差值 */
+    replay_err_t err[3];            /**< Roll / Pitch / Yaw */
+    uint32_t samples;
+    uint32_t rejected;
+} replay_run_t;
+
+/**
+ * @brief 喂入一个样本并与参考角度比较
+ * @param dt 距上一样本的时间 (s)，首个样本为0
+ */
+static void replay_sample(replay_run_t *run, double t, const float gyro[3], const float acc[3], float dt,
+                          const double ref[3])
+{
+    attitude_t att;
+    double e[3];
+    uint32_t i;
+
+    run->samples++;
+    if (attitude_filter_update(gyro, acc, dt, &att) != 0) {
+        run->rejected++;        /* 与jy61p_app相同: 首个样本或间隔异常不更新 */
+        return;
+    }
+    if (!run->aligned) {
+        run->aligned = 1;
+        run->t_start = t + run->settle_s;
+    }
+    if (t < run->t_start) {
+        run->yaw_offset = wrap_180(att.euler[2] - ref[2]);
+        return;
+    }
+
+    e[0] = wrap_180(att.euler[0] - ref[0]);
+    e[1] = wrap_180(att.euler[1] - ref[1]);
+    e[2] = wrap_180(att.euler[2] - ref[2] - run->yaw_offset);
+    for (i = 0; i < 3U; i++) {
+        err_add(&run->err[i], t, e[i]);
+    }
+    if (run->csv) {
+        printf("%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n", t, att.euler[0], att.euler[1], att.euler[2],
+               ref[0], ref[1], ref[2]);
+    }
+}
+
+/* ========================================================================== */
+/*                              合成轨迹                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 真实欧拉角 (rad)，ZYX顺序
+ */
+static void synth_euler(double t, double e[3])
+{
+    double s;
+
+    /* 2-12s: 横滚±20°，0.5Hz */
+    e[0] = (t >= 2.0 && t < 12.0) ? 20.0 * REPLAY_D2R * sin(REPLAY_PI * (t - 2.0)) : 0.0;
+
+    /* 4-6s抬头到15°，保持到14s，16s回到水平 (余弦过渡) */
+    if (t < 4.0 || t >= 16.0) {
+        s = 0.0;
+    } else if (t < 6.0) {
+        s = 0.5 - 0.5 * cos(REPLAY_PI * (t - 4.0) / 2.0);
+    } else if (t < 14.0) {
+        s = 1.0;
+    } else {
+        s = 0.5 + 0.5 * cos(REPLAY_PI * (t - 14.0) / 2.0);
+    }
+    e[1] = 15.0 * REPLAY_D2R * s;
+
+    /* 8-11s左转90°，20-23s再转回 */
+    if (t < 8.0) {
+        s = 0.0;
+    } else if (t < 11.0) {
+        s = 0.5 - 0.5 * cos(REPLAY_PI * (t - 8.0) / 3.0);
+    } else if (t < 20.0) {
+        s = 1.0;
+    } else if (t < 23.0) {
+        s = 0.5 + 0.5 * cos(REPLAY_PI * (t - 20.0) / 3.0);
+    } else {
+        s = 0.0;
+    }
+    e[2] = 90.0 * REPLAY_D2R * s;
+}
+
+/**
+ * @brief 生成合成轨迹并回放
+ */
+static void replay_synth(replay_run_t *run)
+{
+    const double bias[3] = { 0.3, -0.2, 0.02 };     /* 陀螺零偏 (°/s) */
+    double dt = 1.0 / (double)REPLAY_RATE_HZ;
+    double h = 1e-5;
+    double t, e[3], ep[3], em[3], de[3], cr, sr, cp, sp, lin, ref[3];
+    float gyro[3], acc[3];
+    uint32_t k, n = (uint32_t)(REPLAY_SYNTH_S * REPLAY_RATE_HZ);
+    uint32_t i;
+
+    srand(1);
+    for (k = 0; k < n; k++) {
+        t = (double)k * dt;
+        synth_euler(t, e);
+        synth_euler(t + h, ep);
+        synth_euler(t - h, em);
+        for (i = 0; i < 3U; i++) {
+            de[i] = (ep[i] - em[i]) / (2.0 * h);
+        }
+        cr = cos(e[0]);
+        sr = sin(e[0]);
+        cp = cos(e[1]);
+        sp = sin(e[1]);
+
+        /* 欧拉角速率换算为机体角速度 */
+        gyro[0] = (float)quantize((de[0] - de[2] * sp) / REPLAY_D2R + bias[0] +
+                                  0.2 * ((double)rand() / RAND_MAX * 2.0 - 1.0), REPLAY_GYRO_LSB_DPS);
+        gyro[1] = (float)quantize((de[1] * cr + de[2] * cp * sr) / REPLAY_D2R + bias[1] +
+                                  0.2 * ((double)rand() / RAND_MAX * 2.0 - 1.0), REPLAY_GYRO_LSB_DPS);
+        gyro[2] = (float)quantize((-de[1] * sr + de[2] * cp * cr) / REPLAY_D2R + bias[2] +
+                                  0.2 * ((double)rand() / RAND_MAX * 2.0 - 1.0), REPLAY_GYRO_LSB_DPS);
+
+        /* 比力: 重力在机体系的投影，30-30.5s叠加0.1g纵向加速度 */
+        lin = (t >= 30.0 && t < 30.5) ? 0.1 : 0.0;
+        acc[0] = (float)quantize(-sp + lin + 0.01 * ((double)rand() / RAND_MAX * 2.0 - 1.0), REPLAY_ACC_LSB_G);
+        acc[1] = (float)quantize(cp * sr + 0.01 * ((double)rand() / RAND_MAX * 2.0 - 1.0), REPLAY_ACC_LSB_G);
+        acc[2] = (float)quantize(cp * cr + 0.01 * ((double)rand() / RAND_MAX * 2.0 - 1.0), REPLAY_ACC_LSB_G);
+
+        for (i = 0; i < 3U; i++) {
+            ref[i] = quantize(e[i] / REPLAY_D2R, REPLAY_ANGLE_LSB_DEG);
+        }
+        replay_sample(run, t, gyro, acc, (k == 0U) ? 0.0f : (float)dt, ref);
+    }
+}
+
+/* ========================================================================== */
+/*                              记录回放                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 回放telemetry_decode.py --csv输出中的imu行，dt取相邻样本时间戳之差
+ * @return int 0: 成功, -1: 文件无效
+ */
+static int replay_log(replay_run_t *run, const char *path)
+{
+    FILE *fp = fopen(path, "r");
+    char line[512];
+    unsigned seq;
+    double t_ms, t_prev = 0.0, ref[3];
+    float acc[3], gyro[3], mag[3], angle[3];
+    int rows = 0;
+
+    if (fp == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (sscanf(line, "imu,%u,%lf,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f", &seq, &t_ms,
+                   &acc[0], &acc[1], &acc[2], &gyro[0], &gyro[1], &gyro[2],
+                   &mag[0], &mag[1], &mag[2], &angle[0], &angle[1], &angle[2]) != 14) {
+            continue;   /* 表头、丢帧注释或其他帧类型 */
+        }
+        ref[0] = angle[0];
+        ref[1] = angle[1];
+        ref[2] = angle[2];
+        replay_sample(run, t_ms / 1000.0, gyro, acc, (rows == 0) ? 0.0f : (float)((t_ms - t_prev) / 1000.0), ref);
+        t_prev = t_ms;
+        rows++;
+    }
+    fclose(fp);
+
+    if (rows == 0) {
+        fprintf(stderr, "%s: no imu rows\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+/* ========================================================================== */
+/*                              检查                                          */
+/* ========================================================================== */
+
+static int g_failures = 0;
+
+static void check(int ok, const char *what, double value, double limit)
+{
+    if (!ok) {
+        fprintf(stderr, "FAIL %s: %.4f (limit %.4f)\n", what, value, limit);
+        g_failures++;
+    }
+}
+
+/* ========================================================================== */
+/*                              主程序                                        */
+/* ========================================================================== */
+
+int main(int argc, char **argv)
+{
+    static const char *const k_axis[3] = { "roll", "pitch", "yaw" };
+    attitude_config_t cfg = { ATTITUDE_DEFAULT_KP, ATTITUDE_DEFAULT_KI, ATTITUDE_DEFAULT_BUDGET };
+    replay_run_t run;
+    const char *log = NULL;
+    double tol_rms = 1.5, tol_max = 5.0, tol_drift = 2.0;
+    char what[32];
+    FILE *report;
+    uint32_t i;
+    int a;
+
+    memset(&run, 0, sizeof(run));
+    run.settle_s = 2.0;
+
+    for (a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--csv") == 0) {
+            run.csv = 1;
+        } else if (a + 1 < argc && strcmp(argv[a], "--log") == 0) {
+            log = argv[++a];
+        } else if (a + 1 < argc && strcmp(argv[a], "--kp") == 0) {
+            cfg.kp = strtof(argv[++a], NULL);
+        } else if (a + 1 < argc && strcmp(argv[a], "--ki") == 0) {
+            cfg.ki = strtof(argv[++a], NULL);
+        } else if (a + 1 < argc && strcmp(argv[a], "--settle") == 0) {
+            run.settle_s = strtod(argv[++a], NULL);
+        } else if (a + 1 < argc && strcmp(argv[a], "--rms") == 0) {
+            tol_rms = strtod(argv[++a], NULL);
+        } else if (a + 1 < argc && strcmp(argv[a], "--max") == 0) {
+            tol_max = strtod(argv[++a], NULL);
+        } else if (a + 1 < argc && strcmp(argv[a], "--drift") == 0) {
+            tol_drift = strtod(argv[++a], NULL);
+        } else {
+            fprintf(stderr, "unknown option %s\n", argv[a]);
+            return 2;
+        }
+    }
+
+    if (!(cfg.kp >= 0.0f) || !(cfg.ki >= 0.0f)) {
+        fprintf(stderr, "invalid gain\n");
+        return 2;
+    }
+    attitude_filter_init(&cfg);
+    if (run.csv) {
+        printf("t_s,roll,pitch,yaw,ref_roll,ref_pitch,ref_yaw\n");
+    }
+
+    if (log != NULL) {
+        if (replay_log(&run, log) != 0) {
+            return 2;
+        }
+    } else {
+        replay_synth(&run);
+    }
+
+    report = run.csv ? stderr : stdout;
+    fprintf(report, "%u samples (%u rejected), kp %.2f ki %.3f, compared after %.1f s\n",
+            (unsigned)run.samples, (unsigned)run.rejected, cfg.kp, cfg.ki, run.t_start);
+    if (run.err[0].n < 1.0) {
+        fprintf(stderr, "no samples after settle time\n");
+        return 2;
+    }
+
+    for (i = 0; i < 3U; i++) {
+        fprintf(report, "%-5s  rms %.3f deg  max %.3f deg  drift %+.3f deg/min\n", k_axis[i],
+                err_rms(&run.err[i]), run.err[i].max_abs, err_slope(&run.err[i]));
+
+        /* Yaw对准时刻未知且无加速度修正，只检查漂移 */
+        if (i < 2U) {
+            snprintf(what, sizeof(what), "%s rms", k_axis[i]);
+            check(err_rms(&run.err[i]) <= tol_rms, what, err_rms(&run.err[i]), tol_rms);
+            snprintf(what, sizeof(what), "%s max", k_axis[i]);
+            check(run.err[i].max_abs <= tol_max, what, run.err[i].max_abs, tol_max);
+        }
+        snprintf(what, sizeof(what), "%s drift", k_axis[i]);
+        check(fabs(err_slope(&run.err[i])) <= tol_drift, what, err_slope(&run.err[i]), tol_drift);
+    }
+
+    fprintf(report, "%s (%d failures)\n", (g_failures == 0) ? "PASS" : "FAIL", g_failures);
+    return (g_failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,232 @@
+/**
+ * @file imu_queue_test.c
+ * @brief IMU采样SPSC无锁队列主机端测试
+ * @details 直接包含app/imu_sampler.c以访问私有队列，WIT SDK和节拍端口用桩函数替代，
+ *          按节拍 → 异步读取 → 完成回调的实际路径产生样本，检查:
+ *          - 空队列取出失败，入队/出队顺序和内容
+ *          - 队列满(容量为IMU_SAMPLER_QUEUE_SIZE - 1)时丢弃并计入溢出
+ *          - 下标在缓冲区内反复回绕，以及32位读写索引自身的回绕
+ *          - 上次运行的读取未结束时重新启动被拒绝
+ * @date 2026-10-16
+ *
+ * @usage 编译 (仓库根目录):
+ *          gcc -O2 -Wall -Wextra -Iapp -Ihardware/wit_c_sdk -IDrivers/CMSIS/Include -o imu_queue_test tools/imu_queue_test.c
+ *        运行: ./imu_queue_test，有检查不通过时返回1
+ */
+
+#include <stdio.h>
+#include "imu_sampler.c"
+
+/* ========================================================================== */
+/*                              桩函数                                        */
+/* ========================================================================== */
+
+int16_t sReg[REGSIZE];
+
+static WitReadDoneCb s_done_cb = NULL;
+static void (*s_tick_cb)(void) = NULL;
+static uint8_t s_busy = 0;
+static uint32_t s_now_ms = 0;
+
+int32_t WitReadDoneRegister(WitReadDoneCb done_func)
+{
+    s_done_cb = done_func;
+    return WIT_HAL_OK;
+}
+
+uint8_t WitReadRegBusy(void)
+{
+    return s_busy;
+}
+
+int32_t WitReadRegAsync(uint32_t uiReg, uint32_t uiReadNum)
+{
+    (void)uiReg;
+    (void)uiReadNum;
+    if (s_busy) {
+        return WIT_HAL_BUSY;
+    }
+    s_busy = 1;
+    return WIT_HAL_OK;
+}
+
+int32_t tick_port_imu_start(uint32_t rate_hz, void (*cb)(void))
+{
+    (void)rate_hz;
+    s_tick_cb = cb;
+    return 0;
+}
+
+void tick_port_imu_stop(void)
+{
+    s_tick_cb = NULL;
+}
+
+uint32_t tick_port_cycles(void)
+{
+    return 0;
+}
+
+uint32_t tick_port_uptime_ms(void)
+{
+    return s_now_ms++;      /* 每次查询前进1ms，忙等待可超时 */
+}
+
+/* ========================================================================== */
+/*                              测试辅助                                      */
+/* ========================================================================== */
+
+static int g_failures = 0;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+            g_failures++; \
+        } \
+    } while (0)
+
+/**
+ * @brief 按实际路径产生一个样本: 节拍启动读取，完成回调入队
+ * @note 寄存器块首个值写入序号的低16位，出队时校验内容
+ */
+static void produce(void)
+{
+    sReg[IMU_SAMPLER_REG_START] = (int16_t)s_tick_seq;
+    s_tick_cb();
+    s_busy = 0;     /* SDK在回调前释放忙标志 */
+    s_done_cb(IMU_SAMPLER_REG_START, IMU_SAMPLER_REG_NUM, WIT_HAL_OK);
+}
+
+/**
+ * @brief 取出一个样本并检查序号连续
+ */
+static void consume(uint32_t *expect_seq)
+{
+    imu_sample_t sample = {0};
+
+    CHECK(imu_sampler_pop(&sample) == 0);
+    CHECK(sample.seq == *expect_seq);
+    CHECK(sample.reg[0] == (int16_t)*expect_seq);
+    (*expect_seq)++;
+}
+
+/* ========================================================================== */
+/*                              测试用例                                      */
+/* ========================================================================== */
+
+static void test_empty(void)
+{
+    imu_sample_t sample;
+
+    CHECK(imu_sampler_start(100) == 0);
+    CHECK(imu_sampler_available() == 0);
+    CHECK(imu_sampler_pop(&sample) == -1);
+    CHECK(imu_sampler_pop(NULL) == -1);
+}
+
+static void test_push_pop(void)
+{
+    uint32_t seq = 0;
+
+    CHECK(imu_sampler_start(100) == 0);
+    imu_sampler_reset_stats();
+    produce();
+    produce();
+    CHECK(imu_sampler_available() == 2);
+    consume(&seq);
+    consume(&seq);
+    CHECK(imu_sampler_available() == 0);
+    CHECK(s_stats.produced == 2);
+}
+
+static void test_full(uint32_t base)
+{
+    imu_sample_t sample;
+    uint32_t seq, i;
+
+    CHECK(imu_sampler_start(100) == 0);
+    imu_sampler_reset_stats();
+    s_queue.head = base;
+    s_queue.tail = base;
+    seq = s_tick_seq;
+
+    for (i = 0; i < IMU_SAMPLER_QUEUE_SIZE - 1U; i++) {
+        produce();
+    }
+    CHECK(imu_sampler_available() == IMU_SAMPLER_QUEUE_SIZE - 1U);
+    CHECK(s_stats.queue_overruns == 0);
+
+    /* 满: 再入队被丢弃 */
+    produce();
+    produce();
+    CHECK(imu_sampler_available() == IMU_SAMPLER_QUEUE_SIZE - 1U);
+    CHECK(s_stats.queue_overruns == 2);
+    CHECK(s_stats.produced == IMU_SAMPLER_QUEUE_SIZE - 1U);
+
+    for (i = 0; i < IMU_SAMPLER_QUEUE_SIZE - 1U; i++) {
+        consume(&seq);
+    }
+    CHECK(imu_sampler_available() == 0);
+    CHECK(imu_sampler_pop(&sample) == -1);
+
+    /* 清空后恢复入队 */
+    seq = s_tick_seq;
+    produce();
+    consume(&seq);
+}
+
+static void test_wraparound(void)
+{
+    uint32_t seq, round, i, batch;
+
+    CHECK(imu_sampler_start(100) == 0);
+    imu_sampler_reset_stats();
+    seq = 0;
+
+    /* 不同批量交替入队/出队，缓冲区下标反复回绕 */
+    for (round = 0; round < 20U * IMU_SAMPLER_QUEUE_SIZE; round++) {
+        batch = 1U + (round * 7U) % (IMU_SAMPLER_QUEUE_SIZE - 1U);
+        for (i = 0; i < batch; i++) {
+            produce();
+        }
+        CHECK(imu_sampler_available() == batch);
+        for (i = 0; i < batch; i++) {
+            consume(&seq);
+        }
+    }
+    CHECK(s_stats.queue_overruns == 0);
+    CHECK(s_queue.head > 10U * IMU_SAMPLER_QUEUE_SIZE);
+}
+
+static void test_restart_busy(void)
+{
+    /* 上次读取一直未完成: 等待超时后拒绝启动，不复位队列 */
+    CHECK(imu_sampler_start(100) == 0);
+    produce();
+    s_tick_cb();
+    CHECK(s_busy == 1);
+    CHECK(imu_sampler_start(100) == -1);
+    CHECK(imu_sampler_available() == 1);
+
+    /* 读取完成后可以重新启动 */
+    s_busy = 0;
+    CHECK(imu_sampler_start(100) == 0);
+    CHECK(imu_sampler_available() == 0);
+}
+
+/* ========================================================================== */
+/*                              主程序                                        */
+/* ========================================================================== */
+
+int main(void)
+{
+    test_empty();
+    test_push_pop();
+    test_full(0);
+    test_full(0xFFFFFFFFUL - IMU_SAMPLER_QUEUE_SIZE / 2U);  /* 读写索引跨过32位回绕 */
+    test_wraparound();
+    test_restart_busy();
+
+    printf("%s (%d failures)\n", (g_failures == 0) ? "PASS" : "FAIL", g_failures);
+    return (g_failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,512 @@
+/**
+ * @file odom_replay.c
+ * @brief 里程计主机端回放验证工具
+ * @details 直接编译app/odometry.c，车轮编码器快照和节拍周期计数用桩函数提供，
+ *          按控制节拍的方式逐拍喂入编码器位置和陀螺Z轴角速度，然后检查积分结果:
+ *          - 内置轨迹: 圆周一圈回到原点 (中点积分)；1m正方形，转弯时右轮打滑2%、
+ *            陀螺带零偏和噪声，融合航向误差须明显小于仅用编码器的误差
+ *          - 陀螺停止输入超过ODOM_GYRO_TIMEOUT_MS后退回编码器航向，恢复后重新融合
+ *          - odometry_reset()在下一拍生效
+ *          - 记录回放: telemetry_decode.py --csv输出的enc/imu行，编码器位置按1ms插值，
+ *            末位姿航向与JY61P航向角的变化量比较，可选给定期望末位姿
+ * @date 2026-10-16
+ *
+ * @usage 编译 (仓库根目录):
+ *          gcc -O2 -Wall -Wextra -Iapp -IDrivers/CMSIS/Include -o odom_replay tools/odom_replay.c app/odometry.c -lm
+ *        运行:
+ *          ./odom_replay                       # 内置合成轨迹
+ *          ./odom_replay --log run.csv         # 二进制遥测解码结果: enc,seq,t_ms,left,right / imu,...
+ *          选项: --weight 陀螺航向权重, --expect x,y,theta_deg 期望末位姿,
+ *                --tol-pos <m> --tol-deg <°> 容差, --csv 输出逐编码器帧的轨迹
+ *        有检查不通过时返回1
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "odometry.h"
+#include "wheel_encoder.h"
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+#define REPLAY_RATE_HZ              1000U   /**< 与MOTOR_SPEED_RATE_HZ一致 */
+#define REPLAY_IMU_DIV              5U      /**< 陀螺每5拍一次 (JY61P_SAMPLE_RATE_HZ 200Hz) */
+#define REPLAY_CYCLES_PER_US        168U    /**< 168MHz内核时钟 */
+#define REPLAY_WHEEL_RADIUS_M       0.0325  /**< 与stm32f407_port_config.h一致 */
+#define REPLAY_WHEEL_BASE_M         0.150
+#define REPLAY_GYRO_LSB_DPS         (2000.0 / 32768.0)  /**< JY61P陀螺量化 */
+#define REPLAY_PI                   3.14159265358979
+
+/* ========================================================================== */
+/*                              桩函数                                        */
+/* ========================================================================== */
+
+static wheel_enc_snapshot_t s_enc;
+static uint32_t s_cycles = 0xFFF00000UL;    /* 起点靠近回绕，覆盖超时判断的无符号差值 */
+
+void wheel_enc_get(wheel_enc_snapshot_t *snap)
+{
+    *snap = s_enc;
+}
+
+float wheel_enc_m_per_count(void)
+{
+    return (float)(2.0 * REPLAY_PI * REPLAY_WHEEL_RADIUS_M / (double)WHEEL_ENC_NORM_CPR);
+}
+
+float wheel_enc_wheel_base(void)
+{
+    return (float)REPLAY_WHEEL_BASE_M;
+}
+
+uint32_t tick_port_cycles(void)
+{
+    return s_cycles;
+}
+
+uint32_t tick_port_cycles_per_us(void)
+{
+    return REPLAY_CYCLES_PER_US;
+}
+
+/* ========================================================================== */
+/*                              检查                                          */
+/* ========================================================================== */
+
+static int g_failures = 0;
+
+static void check(int ok, const char *what, double value, double limit)
+{
+    if (!ok) {
+        fprintf(stderr, "FAIL %s: %.4f (limit %.4f)\n", what, value, limit);
+        g_failures++;
+    }
+}
+
+/**
+ * @brief 角度差归一化到(-π, π]
+ */
+static double wrap_pi(double a)
+{
+    while (a > REPLAY_PI) {
+        a -= 2.0 * REPLAY_PI;
+    }
+    while (a <= -REPLAY_PI) {
+        a += 2.0 * REPLAY_PI;
+    }
+    return a;
+}
+
+/* ========================================================================== */
+/*                              合成轨迹                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 一段轨迹: 持续时间、线速度和角速度 (逆时针为正)
+ */
+typedef struct {
+    double duration;
+    double v;
+    double omega;
+} replay_phase_t;
+
+/**
+ * @brief 传感器误差设置
+ */
+typedef struct {
+    double slip_right;      /**< 转弯时右轮计数的相对误差 */
+    double gyro_bias_dps;   /**< 陀螺零偏 */
+    double gyro_noise_dps;  /**< 陀螺均匀噪声幅值 */
+    double gyro_off_from;   /**< 从该时刻起停止陀螺输入 (s)，负数表示不停止 */
+    double gyro_off_to;     /**< 到该时刻恢复 */
+} replay_sensor_t;
+
+/**
+ * @brief 真值状态
+ */
+typedef struct {
+    double x, y, theta;
+    double wheel[WHEEL_ENC_NUM];    /* 编码器看到的车轮行程 (m) */
+} replay_truth_t;
+
+/**
+ * @brief 按控制节拍跑完一组轨迹段
+ * @param truth 真值，运行前由调用者初始化
+ * @param gyro_seen_off 若非NULL，记录停止陀螺期间是否出现gyro_valid
+ */
+static void replay_synth(const replay_phase_t *phases, uint32_t n, const replay_sensor_t *sensor,
+                         replay_truth_t *truth, uint8_t *gyro_seen_off)
+{
+    double dt = 1.0 / (double)REPLAY_RATE_HZ;
+    double mpc = 2.0 * REPLAY_PI * REPLAY_WHEEL_RADIUS_M / (double)WHEEL_ENC_NORM_CPR;
+    double t = 0.0, mid, d_l, d_r, gyro;
+    odometry_pose_t pose;
+    uint32_t tick = 0, steps, k, p;
+    uint8_t gyro_on;
+
+    for (p = 0; p < n; p++) {
+        steps = (uint32_t)(phases[p].duration * REPLAY_RATE_HZ + 0.5);
+        for (k = 0; k < steps; k++, tick++) {
+            s_cycles += REPLAY_CYCLES_PER_US * 1000000UL / REPLAY_RATE_HZ;
+            t += dt;
+
+            /* 真值: 中点航向精确积分 */
+            mid = truth->theta + 0.5 * phases[p].omega * dt;
+            truth->x += phases[p].v * dt * cos(mid);
+            truth->y += phases[p].v * dt * sin(mid);
+            truth->theta += phases[p].omega * dt;
+
+            d_l = (phases[p].v - 0.5 * REPLAY_WHEEL_BASE_M * phases[p].omega) * dt;
+            d_r = (phases[p].v + 0.5 * REPLAY_WHEEL_BASE_M * phases[p].omega) * dt;
+            if (phases[p].omega != 0.0) {
+                d_r *= 1.0 + sensor->slip_right;
+            }
+            truth->wheel[WHEEL_ENC_LEFT] += d_l;
+            truth->wheel[WHEEL_ENC_RIGHT] += d_r;
+            s_enc.wheel[WHEEL_ENC_LEFT].position = llround(truth->wheel[WHEEL_ENC_LEFT] / mpc);
+            s_enc.wheel[WHEEL_ENC_RIGHT].position = llround(truth->wheel[WHEEL_ENC_RIGHT] / mpc);
+            s_enc.timestamp = s_cycles;
+            s_enc.updates++;
+
+            gyro_on = !(sensor->gyro_off_from >= 0.0 && t >= sensor->gyro_off_from && t < sensor->gyro_off_to);
+            if (gyro_on && (tick % REPLAY_IMU_DIV) == 0U) {
+                gyro = phases[p].omega * 180.0 / REPLAY_PI + sensor->gyro_bias_dps +
+                       sensor->gyro_noise_dps * ((double)rand() / (double)RAND_MAX * 2.0 - 1.0);
+                odometry_feed_gyro_z((float)(floor(gyro / REPLAY_GYRO_LSB_DPS + 0.5) * REPLAY_GYRO_LSB_DPS));
+            }
+
+            odometry_update();
+
+            if (gyro_seen_off != NULL && !gyro_on && t >= sensor->gyro_off_from + 0.001 * (ODOM_GYRO_TIMEOUT_MS + 5U)) {
+                odometry_get(&pose);
+                *gyro_seen_off |= pose.gyro_valid;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 圆周一圈: 无误差时回到原点，检查中点积分
+ */
+static void test_circle(void)
+{
+    const replay_phase_t phases[] = {
+        { 2.0 * REPLAY_PI * 0.5 / 0.5, 0.5, 0.5 / 0.5 },    /* R0.5m，0.5m/s */
+    };
+    const replay_sensor_t sensor = { 0.0, 0.0, 0.0, -1.0, 0.0 };
+    replay_truth_t truth = { 0 };
+    odometry_pose_t pose;
+
+    odometry_init(REPLAY_RATE_HZ, 0.0f);
+    replay_synth(phases, 1, &sensor, &truth, NULL);
+    odometry_get(&pose);
+
+    check(hypot(pose.x - truth.x, pose.y - truth.y) <= 0.005, "circle position", hypot(pose.x - truth.x, pose.y - truth.y), 0.005);
+    check(fabs(wrap_pi(pose.theta - truth.theta)) <= 0.2 * REPLAY_PI / 180.0, "circle heading",
+          wrap_pi(pose.theta - truth.theta) * 180.0 / REPLAY_PI, 0.2);
+    check(fabs(pose.distance - 2.0 * REPLAY_PI * 0.5) <= 0.005, "circle distance", pose.distance, 2.0 * REPLAY_PI * 0.5);
+    printf("circle:  end (%.4f, %.4f) m, heading %.3f deg, distance %.4f m\n",
+           pose.x, pose.y, pose.theta * 180.0 / REPLAY_PI, pose.distance);
+}
+
+/**
+ * @brief 1m正方形四次原地左转，转弯打滑: 对比仅编码器与融合航向
+ */
+static void test_square(void)
+{
+    const replay_phase_t side[] = {
+        { 2.0, 0.5, 0.0 },                  /* 1m直行 */
+        { 1.0, 0.0, REPLAY_PI / 2.0 },      /* 原地左转90° */
+    };
+    const replay_sensor_t sensor = { 0.02, 0.05, 0.3, -1.0, 0.0 };
+    odometry_pose_t pose;
+    replay_truth_t truth;
+    double err_deg[2], pos_err[2];
+    float weight[2] = { 0.0f, ODOM_DEFAULT_GYRO_WEIGHT };
+    uint32_t w, i;
+
+    for (w = 0; w < 2U; w++) {
+        memset(&truth, 0, sizeof(truth));
+        memset(&s_enc, 0, sizeof(s_enc));
+        srand(1);
+        odometry_init(REPLAY_RATE_HZ, weight[w]);
+        for (i = 0; i < 4U; i++) {
+            replay_synth(side, 2, &sensor, &truth, NULL);
+        }
+        odometry_get(&pose);
+        err_deg[w] = wrap_pi(pose.theta - truth.theta) * 180.0 / REPLAY_PI;
+        pos_err[w] = hypot(pose.x - truth.x, pose.y - truth.y);
+        printf("square:  weight %.2f end (%.4f, %.4f) m, heading error %.3f deg, position error %.4f m\n",
+               weight[w], pose.x, pose.y, err_deg[w], pos_err[w]);
+    }
+
+    /* 打滑使编码器航向每次转弯多转约0.9°；融合后只剩(1-w)的份额和陀螺零偏的积分 */
+    check(fabs(err_deg[0]) >= 3.0, "square encoder-only heading error", fabs(err_deg[0]), 3.0);
+    check(fabs(err_deg[1]) <= 1.0, "square fused heading error", fabs(err_deg[1]), 1.0);
+    check(fabs(err_deg[1]) <= fabs(err_deg[0]) / 3.0, "square fused vs encoder-only heading", fabs(err_deg[1]), fabs(err_deg[0]) / 3.0);
+    check(pos_err[1] <= 0.03, "square fused position error", pos_err[1], 0.03);
+    check(pos_err[1] < pos_err[0], "square fused vs encoder-only position", pos_err[1], pos_err[0]);
+}
+
+/**
+ * @brief 陀螺中断输入: 超时后退回编码器，恢复后重新融合
+ */
+static void test_gyro_timeout(void)
+{
+    const replay_phase_t phases[] = {
+        { 1.0, 0.3, 0.5 },
+    };
+    const replay_sensor_t sensor = { 0.0, 0.0, 0.0, 0.3, 0.6 };
+    replay_truth_t truth = { 0 };
+    odometry_pose_t pose;
+    uint8_t valid_while_off = 0;
+
+    memset(&s_enc, 0, sizeof(s_enc));
+    odometry_init(REPLAY_RATE_HZ, ODOM_DEFAULT_GYRO_WEIGHT);
+    replay_synth(phases, 1, &sensor, &truth, &valid_while_off);
+    odometry_get(&pose);
+
+    check(valid_while_off == 0, "gyro_valid after timeout", valid_while_off, 0);
+    check(pose.gyro_valid == 1, "gyro_valid after resume", pose.gyro_valid, 1);
+    check(fabs(wrap_pi(pose.theta - truth.theta)) <= 0.5 * REPLAY_PI / 180.0, "timeout heading",
+          wrap_pi(pose.theta - truth.theta) * 180.0 / REPLAY_PI, 0.5);
+}
+
+/**
+ * @brief 复位请求在下一拍生效，路程清零
+ */
+static void test_reset(void)
+{
+    const replay_phase_t still[] = {
+        { 0.001, 0.0, 0.0 },
+    };
+    const replay_sensor_t sensor = { 0.0, 0.0, 0.0, -1.0, 0.0 };
+    replay_truth_t truth = { 0 };
+    odometry_pose_t pose;
+
+    memset(&s_enc, 0, sizeof(s_enc));
+    odometry_init(REPLAY_RATE_HZ, ODOM_DEFAULT_GYRO_WEIGHT);
+    odometry_reset(1.0f, -2.0f, (float)(REPLAY_PI / 2.0));
+    replay_synth(still, 1, &sensor, &truth, NULL);
+    odometry_get(&pose);
+
+    check(fabsf(pose.x - 1.0f) <= 1e-4f && fabsf(pose.y + 2.0f) <= 1e-4f, "reset position", pose.x, 1.0);
+    check(fabs(pose.theta - REPLAY_PI / 2.0) <= 1e-3, "reset heading", pose.theta, REPLAY_PI / 2.0);
+    check(pose.distance == 0.0f, "reset distance", pose.distance, 0.0);
+}
+
+/* ========================================================================== */
+/*                              记录回放                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 记录中的一帧 (编码器或IMU)
+ */
+typedef struct {
+    double t_ms;
+    uint8_t is_enc;
+    int32_t left;
+    int32_t right;
+    float gyro_z;
+    float yaw;
+} replay_row_t;
+
+/**
+ * @brief 载入telemetry_decode.py --csv的输出，只保留enc和imu行
+ * @return int 行数，-1: 文件无效
+ */
+static int replay_load(const char *path, replay_row_t **rows_out)
+{
+    FILE *fp = fopen(path, "r");
+    char line[512];
+    replay_row_t *rows = NULL, *grown;
+    replay_row_t r;
+    int n = 0, cap = 0;
+    unsigned seq;
+    float v[12];
+
+    if (fp == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        memset(&r, 0, sizeof(r));
+        if (sscanf(line, "enc,%u,%lf,%d,%d", &seq, &r.t_ms, &r.left, &r.right) == 4) {
+            r.is_enc = 1;
+        } else if (sscanf(line, "imu,%u,%lf,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f", &seq, &r.t_ms,
+                          &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7], &v[8],
+                          &v[9], &v[10], &v[11]) == 14) {
+            r.gyro_z = v[5];
+            r.yaw = v[11];
+        } else {
+            continue;   /* 表头、丢帧注释或其他帧类型 */
+        }
+        if (n == cap) {
+            cap = (cap == 0) ? 1024 : cap * 2;
+            grown = realloc(rows, (size_t)cap * sizeof(*rows));
+            if (grown == NULL) {
+                free(rows);
+                fclose(fp);
+                return -1;
+            }
+            rows = grown;
+        }
+        rows[n++] = r;
+    }
+    fclose(fp);
+
+    *rows_out = rows;
+    return n;
+}
+
+/**
+ * @brief 回放记录，编码器位置在相邻两帧之间按1ms节拍线性插值
+ * @return int 0: 成功, -1: 记录无效
+ */
+static int replay_log(const char *path, float weight, const double *expect, double tol_pos, double tol_deg, int csv)
+{
+    replay_row_t *rows = NULL;
+    odometry_pose_t pose;
+    double t, t0 = 0.0, frac, yaw0 = 0.0, yaw1 = 0.0, d_yaw, err;
+    int n, prev = -1, next, imu = 0, has_yaw = 0;
+
+    n = replay_load(path, &rows);
+    if (n <= 0) {
+        fprintf(stderr, "%s: no enc/imu rows\n", path);
+        free(rows);
+        return -1;
+    }
+
+    memset(&s_enc, 0, sizeof(s_enc));
+    odometry_init(REPLAY_RATE_HZ, weight);
+    if (csv) {
+        printf("t_ms,x,y,theta_deg,gyro_valid\n");
+    }
+
+    for (next = 0; next < n; next++) {
+        if (!rows[next].is_enc) {
+            continue;
+        }
+        if (prev < 0) {
+            /* 首个编码器帧为起点，之前的IMU帧只用于航向基准 */
+            prev = next;
+            t0 = rows[next].t_ms;
+            s_enc.wheel[WHEEL_ENC_LEFT].position = rows[next].left;
+            s_enc.wheel[WHEEL_ENC_RIGHT].position = rows[next].right;
+            for (; imu < next; imu++) {
+                yaw0 = rows[imu].yaw;
+                has_yaw = 1;
+            }
+            continue;
+        }
+
+        for (t = rows[prev].t_ms + 1.0; t <= rows[next].t_ms; t += 1.0) {
+            for (; imu < n && rows[imu].t_ms <= t; imu++) {
+                if (!rows[imu].is_enc) {
+                    odometry_feed_gyro_z(rows[imu].gyro_z);
+                    if (!has_yaw) {
+                        yaw0 = rows[imu].yaw;
+                        has_yaw = 1;
+                    }
+                    yaw1 = rows[imu].yaw;
+                }
+            }
+            frac = (t - rows[prev].t_ms) / (rows[next].t_ms - rows[prev].t_ms);
+            s_enc.wheel[WHEEL_ENC_LEFT].position = rows[prev].left +
+                llround(frac * (double)(int32_t)((uint32_t)rows[next].left - (uint32_t)rows[prev].left));
+            s_enc.wheel[WHEEL_ENC_RIGHT].position = rows[prev].right +
+                llround(frac * (double)(int32_t)((uint32_t)rows[next].right - (uint32_t)rows[prev].right));
+            s_cycles = (uint32_t)(int64_t)(t * 1000.0 * REPLAY_CYCLES_PER_US);
+            odometry_update();
+        }
+        prev = next;
+
+        if (csv) {
+            odometry_get(&pose);
+            printf("%.3f,%.4f,%.4f,%.3f,%u\n", rows[next].t_ms, pose.x, pose.y,
+                   pose.theta * 180.0 / REPLAY_PI, pose.gyro_valid);
+        }
+    }
+
+    odometry_get(&pose);
+    fprintf(csv ? stderr : stdout, "log:     %.3f s, end (%.4f, %.4f) m, heading %.3f deg, distance %.4f m\n",
+            (rows[prev].t_ms - t0) / 1000.0, pose.x, pose.y, pose.theta * 180.0 / REPLAY_PI, pose.distance);
+
+    /* JY61P航向角由模块内部融合，作为末航向的参考 */
+    if (has_yaw) {
+        d_yaw = wrap_pi((yaw1 - yaw0) * REPLAY_PI / 180.0);
+        err = wrap_pi(pose.theta - d_yaw) * 180.0 / REPLAY_PI;
+        fprintf(csv ? stderr : stdout, "         JY61P yaw change %.3f deg, heading error %.3f deg\n",
+                d_yaw * 180.0 / REPLAY_PI, err);
+        check(fabs(err) <= tol_deg, "heading vs JY61P yaw", err, tol_deg);
+    }
+    if (expect != NULL) {
+        check(hypot(pose.x - expect[0], pose.y - expect[1]) <= tol_pos, "end position",
+              hypot(pose.x - expect[0], pose.y - expect[1]), tol_pos);
+        check(fabs(wrap_pi(pose.theta - expect[2] * REPLAY_PI / 180.0)) * 180.0 / REPLAY_PI <= tol_deg,
+              "end heading", pose.theta * 180.0 / REPLAY_PI, expect[2]);
+    }
+
+    free(rows);
+    return 0;
+}
+
+/* ========================================================================== */
+/*                              主程序                                        */
+/* ========================================================================== */
+
+int main(int argc, char **argv)
+{
+    const char *log = NULL;
+    float weight = ODOM_DEFAULT_GYRO_WEIGHT;
+    double expect[3];
+    double tol_pos = 0.05, tol_deg = 3.0;
+    int has_expect = 0, csv = 0;
+    int a;
+
+    for (a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--csv") == 0) {
+            csv = 1;
+        } else if (a + 1 < argc && strcmp(argv[a], "--log") == 0) {
+            log = argv[++a];
+        } else if (a + 1 < argc && strcmp(argv[a], "--weight") == 0) {
+            weight = strtof(argv[++a], NULL);
+        } else if (a + 1 < argc && strcmp(argv[a], "--expect") == 0) {
+            if (sscanf(argv[++a], "%lf,%lf,%lf", &expect[0], &expect[1], &expect[2]) != 3) {
+                fprintf(stderr, "--expect x,y,theta_deg\n");
+                return 2;
+            }
+            has_expect = 1;
+        } else if (a + 1 < argc && strcmp(argv[a], "--tol-pos") == 0) {
+            tol_pos = strtod(argv[++a], NULL);
+        } else if (a + 1 < argc && strcmp(argv[a], "--tol-deg") == 0) {
+            tol_deg = strtod(argv[++a], NULL);
+        } else {
+            fprintf(stderr, "unknown option %s\n", argv[a]);
+            return 2;
+        }
+    }
+
+    if (wheel_enc_wheel_base() <= 0.0f || odometry_init(REPLAY_RATE_HZ, weight) != 0) {
+        fprintf(stderr, "invalid config\n");
+        return 2;
+    }
+
+    if (log != NULL) {
+        if (replay_log(log, weight, has_expect ? expect : NULL, tol_pos, tol_deg, csv) != 0) {
+            return 2;
+        }
+    } else {
+        test_circle();
+        test_square();
+        test_gyro_timeout();
+        test_reset();
+    }
+
+    fprintf(csv ? stderr : stdout, "%s (%d failures)\n", (g_failures == 0) ? "PASS" : "FAIL", g_failures);
+    return (g_failures == 0) ? 0 : 1;
+}
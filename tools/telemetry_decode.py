@@ -0,0 +1,217 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+二进制遥测帧主机端解码工具
+
+将MCU输出的COBS编码遥测帧 (格式见 app/telemetry.h) 解码为可读文本。
+非遥测数据 (如命令回显等printf文本) 按原样输出。
+
+用法:
+    python3 telemetry_decode.py capture.bin             # 解码抓包文件
+    python3 telemetry_decode.py COM3 --baud 115200      # 直接读串口 (需pyserial)
+    python3 telemetry_decode.py /dev/ttyUSB0 --csv      # CSV格式输出
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+TYPE_IMU = 0x01
+TYPE_ENCODER = 0x02
+TYPE_MOTOR = 0x03
+
+HEADER_FMT = "<BHI"          # type, seq, timestamp
+HEADER_LEN = struct.calcsize(HEADER_FMT)
+
+# 原始值到物理量的换算 (与jy61p_app.c一致)
+ACC_SCALE = 16.0 / 32768.0       # g
+GYRO_SCALE = 2000.0 / 32768.0    # °/s
+ANGLE_SCALE = 180.0 / 32768.0    # °
+
+
+def crc16_ccitt(data):
+    """CRC-16/CCITT-FALSE, 多项式0x1021, 初值0xFFFF"""
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    """COBS解码, 格式错误时返回None"""
+    out = bytearray()
+    i = 0
+    n = len(data)
+    while i < n:
+        code = data[i]
+        if code == 0:
+            return None
+        block = data[i + 1:i + code]
+        if len(block) != code - 1:
+            return None
+        out += block
+        i += code
+        if code < 0xFF and i < n:
+            out.append(0)
+    return bytes(out)
+
+
+class Decoder(object):
+    def __init__(self, clock_hz, csv):
+        self.clock_hz = float(clock_hz)
+        self.csv = csv
+        self.buf = bytearray()
+        self.last_seq = None
+        self.lost = 0
+        self.bad = 0
+        self.t0 = None
+        self.last_ts = None
+        self.last_full = 0
+
+    def feed(self, chunk):
+        self.buf += chunk
+        while True:
+            idx = self.buf.find(b"\x00")
+            if idx < 0:
+                return
+            frame = bytes(self.buf[:idx])
+            del self.buf[:idx + 1]
+            if frame:
+                self.handle(frame)
+
+    def handle(self, frame):
+        raw = self.unpack(frame)
+        if raw is None:
+            # printf文本不含0x00，会与其后的帧粘连: 在每个换行处尝试切分
+            pos = frame.find(b"\n")
+            while pos >= 0:
+                raw = self.unpack(frame[pos + 1:])
+                if raw is not None:
+                    self.passthrough(frame[:pos + 1])
+                    break
+                pos = frame.find(b"\n", pos + 1)
+            if raw is None:
+                self.passthrough(frame)
+                return
+
+        ftype, seq, ts = struct.unpack(HEADER_FMT, raw[:HEADER_LEN])
+        payload = raw[HEADER_LEN:-2]
+
+        if self.last_seq is not None:
+            gap = (seq - self.last_seq - 1) & 0xFFFF
+            if gap:
+                self.lost += gap
+                self.emit("# lost %d frame(s) before seq %d" % (gap, seq))
+        self.last_seq = seq
+
+        t_ms = self.timestamp_ms(ts)
+
+        if ftype == TYPE_IMU and len(payload) == 24:
+            v = struct.unpack("<12h", payload)
+            acc = [x * ACC_SCALE for x in v[0:3]]
+            gyro = [x * GYRO_SCALE for x in v[3:6]]
+            mag = v[6:9]
+            angle = [x * ANGLE_SCALE for x in v[9:12]]
+            if self.csv:
+                self.emit("imu,%d,%.3f,%s" % (seq, t_ms, ",".join(
+                    ["%.4f" % x for x in acc + gyro] + ["%d" % x for x in mag] +
+                    ["%.3f" % x for x in angle])))
+            else:
+                self.emit("[%5d %10.3f ms] ACC %7.3f %7.3f %7.3f g | GYRO %8.2f %8.2f %8.2f dps | "
+                          "ANGLE %7.2f %7.2f %7.2f deg | MAG %d %d %d" %
+                          tuple([seq, t_ms] + acc + gyro + angle + list(mag)))
+        elif ftype == TYPE_ENCODER and len(payload) == 8:
+            left, right = struct.unpack("<ii", payload)
+            if self.csv:
+                self.emit("enc,%d,%.3f,%d,%d" % (seq, t_ms, left, right))
+            else:
+                self.emit("[%5d %10.3f ms] ENC left %d right %d" % (seq, t_ms, left, right))
+        elif ftype == TYPE_MOTOR and len(payload) == 4:
+            sa, da, sb, db = struct.unpack("<BbBb", payload)
+            if self.csv:
+                self.emit("motor,%d,%.3f,%d,%d,%d,%d" % (seq, t_ms, sa, da, sb, db))
+            else:
+                self.emit("[%5d %10.3f ms] MOTOR A %3d%% dir %+d | B %3d%% dir %+d" %
+                          (seq, t_ms, sa, da, sb, db))
+        else:
+            self.emit("[%5d %10.3f ms] type 0x%02X len %d: %s" %
+                      (seq, t_ms, ftype, len(payload), payload.hex()))
+
+    @staticmethod
+    def unpack(frame):
+        raw = cobs_decode(frame)
+        if raw is None or len(raw) < HEADER_LEN + 2 or \
+                crc16_ccitt(raw[:-2]) != struct.unpack("<H", raw[-2:])[0]:
+            return None
+        return raw
+
+    def timestamp_ms(self, ts):
+        # DWT周期计数为32位，168MHz下约25.6秒回绕，按有符号差值展开为连续时间
+        # (IMU帧时间戳取自采样节拍，可能略早于前一帧，故允许小幅回退)
+        if self.last_ts is None:
+            full = ts
+        else:
+            delta = (ts - self.last_ts) & 0xFFFFFFFF
+            if delta >= 1 << 31:
+                delta -= 1 << 32
+            full = self.last_full + delta
+        self.last_ts = ts
+        self.last_full = full
+        if self.t0 is None:
+            self.t0 = full
+        return (full - self.t0) * 1000.0 / self.clock_hz
+
+    def passthrough(self, frame):
+        text = frame.decode("utf-8", "replace").strip()
+        if text and all(c.isprintable() or c in "\r\n\t" for c in text):
+            self.emit("# " + text.replace("\r\n", "\n# "))
+        else:
+            self.bad += 1
+
+    def emit(self, line):
+        sys.stdout.write(line + "\n")
+
+
+def open_source(path, baud):
+    if os.path.isfile(path):
+        return open(path, "rb")
+    try:
+        import serial
+    except ImportError:
+        sys.exit("'%s' is not a file and pyserial is not installed" % path)
+    return serial.Serial(path, baud, timeout=0.1)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Decode binary telemetry frames")
+    ap.add_argument("source", help="capture file or serial port")
+    ap.add_argument("--baud", type=int, default=115200, help="serial baud rate")
+    ap.add_argument("--clock", type=float, default=168e6, help="MCU core clock in Hz")
+    ap.add_argument("--csv", action="store_true", help="emit CSV rows")
+    args = ap.parse_args()
+
+    dec = Decoder(args.clock, args.csv)
+    src = open_source(args.source, args.baud)
+    is_file = os.path.isfile(args.source)
+    try:
+        while True:
+            chunk = src.read(4096)
+            if not chunk:
+                if is_file:
+                    break
+                continue
+            dec.feed(chunk)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        src.close()
+
+    sys.stderr.write("lost frames: %d, undecodable: %d\n" % (dec.lost, dec.bad))
+
+
+if __name__ == "__main__":
+    main()
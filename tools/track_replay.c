@@ -0,0 +1,370 @@
+/**
+ * @file track_replay.c
+ * @brief 赛道记忆速度曲线主机端回放验证工具
+ * @details 直接编译app/track_map.c，按控制节拍的方式喂入一圈数据、分批规划，
+ *          然后检查规划出的速度曲线:
+ *          - 速度在[v_min, v_max]内，弯道横向加速度v²·|κ|不超过a_lat
+ *          - 带路口/丢线标记的段限速为v_min
+ *          - 相邻两段的纵向加速度/减速度不超过a_accel/a_brake (含首尾相接处)
+ *          - 按路程查表的结果与表中速度一致
+ *          并给出规划圈速与按固定速度巡线的圈速对比。
+ * @date 2026-10-16
+ *
+ * @usage 编译 (仓库根目录):
+ *          gcc -O2 -Wall -Iapp -o track_replay tools/track_replay.c app/track_map.c -lm
+ *        运行:
+ *          ./track_replay                      # 内置合成赛道 (两段直道+两个半圆+S弯，起点直道中间一个路口)
+ *          ./track_replay --samples lap.csv    # 一圈原始采样: t_s,distance_m,yaw_rate_rps,position[,flags]
+ *          ./track_replay --bins table.csv     # MCU打印的分段表: index,kappa,position,flags
+ *          选项: --vmax --vmin --alat --accel --brake --bin --reactive <m/s>, --csv 输出逐段曲线
+ *        有检查不通过时返回1
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "track_map.h"
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+#define REPLAY_RATE_HZ              1000U   /**< 与MOTOR_SPEED_RATE_HZ一致 */
+#define REPLAY_PLAN_BUDGET          64U     /**< 与电机应用中每节拍的规划批量一致 */
+#define REPLAY_TOL                  0.02f   /**< mm/s量化带来的容差 (相对) */
+#define REPLAY_PI                   3.14159265f
+
+/* ========================================================================== */
+/*                              合成赛道                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 一段赛道: 长度和曲率 (左转为正)
+ */
+typedef struct {
+    float length;
+    float kappa;
+} replay_seg_t;
+
+static const replay_seg_t k_synth_track[] = {
+    { 1.20f, 0.0f },                            /* 起终点直道 */
+    { REPLAY_PI * 0.35f, 1.0f / 0.35f },        /* 半圆 R0.35 */
+    { 0.50f, 0.0f },
+    { 0.40f, 1.0f / 0.25f },                    /* S弯 R0.25 */
+    { 0.40f, -1.0f / 0.25f },
+    { 0.30f, 0.0f },
+    { REPLAY_PI * 0.35f, 1.0f / 0.35f },        /* 半圆 R0.35 */
+};
+
+#define SYNTH_SEGS                  (sizeof(k_synth_track) / sizeof(k_synth_track[0]))
+
+/* 起点直道中间的十字路口 (路程范围，m) */
+#define SYNTH_JUNCTION_START        0.60f
+#define SYNTH_JUNCTION_END          0.64f
+
+/**
+ * @brief 合成赛道上路程s处的曲率
+ */
+static float synth_kappa(float s)
+{
+    uint32_t i;
+
+    for (i = 0; i < SYNTH_SEGS; i++) {
+        if (s < k_synth_track[i].length) {
+            return k_synth_track[i].kappa;
+        }
+        s -= k_synth_track[i].length;
+    }
+    return 0.0f;
+}
+
+/**
+ * @brief 合成赛道一圈长度
+ */
+static float synth_length(void)
+{
+    float len = 0.0f;
+    uint32_t i;
+
+    for (i = 0; i < SYNTH_SEGS; i++) {
+        len += k_synth_track[i].length;
+    }
+    return len;
+}
+
+/**
+ * @brief 以固定速度跑一圈合成赛道并记录 (陀螺带±2%噪声)
+ */
+static void replay_synth(track_map_t *map, float v0)
+{
+    float dt = 1.0f / (float)REPLAY_RATE_HZ;
+    float len = synth_length();
+    float s = 0.0f;
+    float noise;
+
+    srand(1);
+    track_map_lap_mark(map, 0.0f);
+    while (s < len) {
+        noise = 1.0f + 0.02f * ((float)rand() / (float)RAND_MAX * 2.0f - 1.0f);
+        track_map_record(map, s, v0 * synth_kappa(s) * noise, dt, 0,
+                         (s >= SYNTH_JUNCTION_START && s < SYNTH_JUNCTION_END) ? TRACK_MAP_FLAG_JUNCTION : 0U);
+        s += v0 * dt;
+    }
+    track_map_lap_mark(map, len);
+}
+
+/* ========================================================================== */
+/*                              文件输入                                      */
+/* ========================================================================== */
+
+/**
+ * @brief 回放一圈原始采样 (首行为起点标记，末行为终点标记)
+ * @return int 0: 成功, -1: 文件无效
+ */
+static int replay_samples(track_map_t *map, const char *path)
+{
+    FILE *fp = fopen(path, "r");
+    char line[256];
+    float t, d, w, t_prev = 0.0f, d_last = 0.0f;
+    int pos, flags, n, rows = 0;
+
+    if (fp == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        flags = 0;
+        n = sscanf(line, "%f,%f,%f,%d,%d", &t, &d, &w, &pos, &flags);
+        if (n < 4) {
+            continue;   /* 表头或注释 */
+        }
+        if (rows == 0) {
+            track_map_lap_mark(map, d);
+        } else {
+            track_map_record(map, d, w, t - t_prev, (int8_t)pos, (uint8_t)flags);
+        }
+        t_prev = t;
+        d_last = d;
+        rows++;
+    }
+    fclose(fp);
+
+    if (rows < 2) {
+        fprintf(stderr, "%s: no samples\n", path);
+        return -1;
+    }
+    track_map_lap_mark(map, d_last);
+    return 0;
+}
+
+/**
+ * @brief 载入MCU打印的分段表
+ * @return int 0: 成功, -1: 文件无效
+ */
+static int replay_bins(track_map_t *map, const char *path)
+{
+    FILE *fp = fopen(path, "r");
+    char line[256];
+    int idx, kappa, pos, flags;
+
+    if (fp == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    map->count = 0;
+    while (fgets(line, sizeof(line), fp) != NULL && map->count < TRACK_MAP_MAX_BINS) {
+        if (sscanf(line, "%d,%d,%d,%d", &idx, &kappa, &pos, &flags) != 4) {
+            continue;
+        }
+        map->bins[map->count].kappa = (int16_t)kappa;
+        map->bins[map->count].position = (int8_t)pos;
+        map->bins[map->count].flags = (uint8_t)flags;
+        map->count++;
+    }
+    fclose(fp);
+
+    map->length_m = (float)map->count * map->cfg.bin_m;
+    map->origin_m = 0.0f;
+    map->state = TRACK_MAP_READY;   /* track_map_plan()接受READY状态重新规划 */
+    return (track_map_plan(map) == 0) ? 0 : -1;
+}
+
+/* ========================================================================== */
+/*                              检查                                          */
+/* ========================================================================== */
+
+static int g_failures = 0;
+
+static void check(int ok, const char *what, uint32_t i, float value, float limit)
+{
+    if (!ok) {
+        if (g_failures < 20) {
+            fprintf(stderr, "FAIL %s at bin %u: %.4f > %.4f\n", what, (unsigned)i, value, limit);
+        }
+        g_failures++;
+    }
+}
+
+static float bin_v(const track_map_t *map, uint32_t i)
+{
+    return (float)map->bins[i].v_plan / 1000.0f;
+}
+
+/**
+ * @brief 检查规划结果
+ */
+static void replay_validate(const track_map_t *map)
+{
+    const track_map_config_t *cfg = &map->cfg;
+    uint32_t n = map->count;
+    uint32_t i;
+    float v, vp, k, lat, acc, look;
+
+    for (i = 0; i < n; i++) {
+        v = bin_v(map, i);
+        vp = bin_v(map, (i + n - 1U) % n);
+        k = fabsf((float)map->bins[i].kappa) / TRACK_MAP_KAPPA_SCALE;
+
+        check(v <= cfg->v_max * (1.0f + REPLAY_TOL), "v_max", i, v, cfg->v_max);
+        check(v >= cfg->v_min * (1.0f - REPLAY_TOL), "v_min", i, cfg->v_min, v);
+        if ((map->bins[i].flags & (TRACK_MAP_FLAG_JUNCTION | TRACK_MAP_FLAG_LOST)) != 0U) {
+            check(v <= cfg->v_min * (1.0f + REPLAY_TOL), "flagged", i, v, cfg->v_min);
+        }
+
+        /* 不低于v_min的限制优先于横向加速度 */
+        lat = v * v * k;
+        if (v > cfg->v_min * (1.0f + REPLAY_TOL)) {
+            check(lat <= cfg->a_lat * (1.0f + REPLAY_TOL), "a_lat", i, lat, cfg->a_lat);
+        }
+
+        acc = (v * v - vp * vp) / (2.0f * cfg->bin_m);
+        check(acc <= cfg->a_accel * (1.0f + REPLAY_TOL) + 0.05f, "a_accel", i, acc, cfg->a_accel);
+        check(-acc <= cfg->a_brake * (1.0f + REPLAY_TOL) + 0.05f, "a_brake", i, -acc, cfg->a_brake);
+
+        look = track_map_speed(map, map->origin_m + ((float)i + 0.001f) * cfg->bin_m, 0.0f);
+        check(fabsf(look - v) <= 0.002f, "lookup", i, look, v);
+    }
+}
+
+/* ========================================================================== */
+/*                              主程序                                        */
+/* ========================================================================== */
+
+static track_map_t g_map;
+
+int main(int argc, char **argv)
+{
+    track_map_config_t cfg = {
+        .bin_m = 0.02f,
+        .v_max = 2.0f,
+        .v_min = 0.4f,
+        .a_lat = 3.0f,
+        .a_accel = 2.0f,
+        .a_brake = 3.0f,
+        .lookahead_s = 0.05f,
+    };
+    const char *samples = NULL;
+    const char *bins = NULL;
+    float reactive = 0.6f;
+    float reactive_s, vmin_plan, vmax_plan;
+    int csv = 0;
+    uint32_t ticks = 0;
+    uint32_t i;
+    int a;
+
+    for (a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--csv") == 0) {
+            csv = 1;
+        } else if (a + 1 < argc && strcmp(argv[a], "--samples") == 0) {
+            samples = argv[++a];
+        } else if (a + 1 < argc && strcmp(argv[a], "--bins") == 0) {
+            bins = argv[++a];
+        } else if (a + 1 < argc && strcmp(argv[a], "--vmax") == 0) {
+            cfg.v_max = strtof(argv[++a], NULL);
+        } else if (a + 1 < argc && strcmp(argv[a], "--vmin") == 0) {
+            cfg.v_min = strtof(argv[++a], NULL);
+        } else if (a + 1 < argc && strcmp(argv[a], "--alat") == 0) {
+            cfg.a_lat = strtof(argv[++a], NULL);
+        } else if (a + 1 < argc && strcmp(argv[a], "--accel") == 0) {
+            cfg.a_accel = strtof(argv[++a], NULL);
+        } else if (a + 1 < argc && strcmp(argv[a], "--brake") == 0) {
+            cfg.a_brake = strtof(argv[++a], NULL);
+        } else if (a + 1 < argc && strcmp(argv[a], "--bin") == 0) {
+            cfg.bin_m = strtof(argv[++a], NULL);
+        } else if (a + 1 < argc && strcmp(argv[a], "--reactive") == 0) {
+            reactive = strtof(argv[++a], NULL);
+        } else {
+            fprintf(stderr, "unknown option %s\n", argv[a]);
+            return 2;
+        }
+    }
+
+    if (track_map_init(&g_map, &cfg) != 0) {
+        fprintf(stderr, "invalid config\n");
+        return 2;
+    }
+
+    if (bins != NULL) {
+        if (replay_bins(&g_map, bins) != 0) {
+            return 2;
+        }
+    } else {
+        if (samples != NULL) {
+            if (replay_samples(&g_map, samples) != 0) {
+                return 2;
+            }
+        } else {
+            replay_synth(&g_map, reactive);
+        }
+
+        /* 与控制节拍相同的分批规划，统计需要的节拍数 */
+        while (g_map.state == TRACK_MAP_PLANNING) {
+            track_map_plan_step(&g_map, REPLAY_PLAN_BUDGET);
+            ticks++;
+        }
+        if (g_map.state != TRACK_MAP_READY) {
+            fprintf(stderr, "recording failed (state %u, %u bins)\n", g_map.state, (unsigned)g_map.count);
+            return 1;
+        }
+    }
+
+    if (samples == NULL && bins == NULL) {
+        check(fabsf(g_map.length_m - synth_length()) <= cfg.bin_m, "length", 0, g_map.length_m, synth_length());
+        i = (uint32_t)((k_synth_track[0].length + 0.5f * k_synth_track[1].length) / cfg.bin_m);
+        check(fabsf((float)g_map.bins[i].kappa / TRACK_MAP_KAPPA_SCALE - k_synth_track[1].kappa) <=
+              0.05f * k_synth_track[1].kappa, "kappa", i, (float)g_map.bins[i].kappa / TRACK_MAP_KAPPA_SCALE,
+              k_synth_track[1].kappa);
+        i = (uint32_t)(0.5f * (SYNTH_JUNCTION_START + SYNTH_JUNCTION_END) / cfg.bin_m);
+        check((g_map.bins[i].flags & TRACK_MAP_FLAG_JUNCTION) != 0U, "junction", i, bin_v(&g_map, i), cfg.v_min);
+    }
+
+    replay_validate(&g_map);
+
+    vmin_plan = cfg.v_max;
+    vmax_plan = 0.0f;
+    for (i = 0; i < g_map.count; i++) {
+        if (bin_v(&g_map, i) < vmin_plan) {
+            vmin_plan = bin_v(&g_map, i);
+        }
+        if (bin_v(&g_map, i) > vmax_plan) {
+            vmax_plan = bin_v(&g_map, i);
+        }
+        if (csv) {
+            printf("%u,%.3f,%.3f,%d,%u,%.3f\n", (unsigned)i, (float)i * cfg.bin_m,
+                   (float)g_map.bins[i].kappa / TRACK_MAP_KAPPA_SCALE, g_map.bins[i].position,
+                   g_map.bins[i].flags, bin_v(&g_map, i));
+        }
+    }
+
+    reactive_s = g_map.length_m / reactive;
+    fprintf(stderr, "bins=%u length=%.3fm plan_ticks=%u v=[%.3f, %.3f]m/s\n", (unsigned)g_map.count,
+            g_map.length_m, (unsigned)ticks, vmin_plan, vmax_plan);
+    fprintf(stderr, "lap: planned %.3fs, reactive @%.2fm/s %.3fs (%.1f%%)\n", g_map.plan_time_s, reactive,
+            reactive_s, 100.0f * (reactive_s - g_map.plan_time_s) / reactive_s);
+    fprintf(stderr, "%s (%d failures)\n", (g_failures == 0) ? "PASS" : "FAIL", g_failures);
+
+    return (g_failures == 0) ? 0 : 1;
+}
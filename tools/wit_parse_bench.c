@@ -0,0 +1,536 @@
+/**
+ * @file wit_parse_bench.c
+ * @brief WIT串口解析器主机端吞吐量与重同步基准
+ * @details 生成NORMAL (0x55帧头+和校验) 和MODBUS (0x03读响应+CRC16) 两种协议的字节流，
+ *          每种协议分干净流和损坏流 (随机翻转位、丢字节、插入含0x55的垃圾)，
+ *          经hardware/wit_c_sdk/wit_c_sdk.c的单字节和整块 (64字节，相当于DMA半缓冲) 输入解析:
+ *          - 测量每种输入方式的吞吐量 (字节/秒)
+ *          - 干净流必须逐帧得到全部注入帧；损坏流中未被破坏的帧至少恢复BENCH_MIN_RECOVER
+ *          - 单字节和整块输入得到完全相同的帧序列
+ *          - 与参考解析器 (tools/wit_parse_ref.c，环形缓冲之前的解析逻辑) 比较: 干净流两者
+ *            逐帧相同；损坏流中参考解析器得到的真实帧必须按顺序全部出现在当前解析器的结果中，
+ *            两者碰巧通过校验的伪帧数单独打印
+ *            (旧解析器校验失败后每收到一个字节才移出一个字节，且成帧后丢弃已缓存的后续字节，
+ *            MODBUS流中一旦失步几乎不再恢复)
+ *          帧以"寄存器号、寄存器数和寄存器值"的FNV-1a摘要比较。
+ * @date 2026-10-16
+ *
+ * @usage 编译 (仓库根目录):
+ *          gcc -O2 -Wall -Wextra -Ihardware/wit_c_sdk -o wit_parse_bench \
+ *              tools/wit_parse_bench.c tools/wit_parse_ref.c hardware/wit_c_sdk/wit_c_sdk.c
+ *        运行: ./wit_parse_bench [帧数]，有检查不通过时返回1
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "wit_c_sdk.h"
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+#define BENCH_DEFAULT_FRAMES        200000U     /**< 每个流的帧数 */
+#define BENCH_BLOCK_LEN             64U         /**< 整块输入长度 */
+#define BENCH_MODBUS_ADDR           0x50U
+#define BENCH_MODBUS_REG            AX          /**< MODBUS读响应对应的起始寄存器 */
+#define BENCH_MODBUS_NUM            12U         /**< 与IMU采样块相同 */
+#define BENCH_CORRUPT_PERCENT       5U          /**< 损坏流中被破坏的帧比例 */
+#define BENCH_MIN_RECOVER           0.95        /**< 损坏流中完好帧的最低恢复比例 */
+#define BENCH_MATCH_WINDOW          32U         /**< 按顺序匹配帧时的查找窗口 */
+
+/* ========================================================================== */
+/*                              参考解析器 (tools/wit_parse_ref.c)            */
+/* ========================================================================== */
+
+extern int16_t RefsReg[REGSIZE];
+int32_t RefWitInit(uint32_t uiProtocol, uint8_t ucAddr);
+int32_t RefWitRegisterCallBack(RegUpdateCb update_func);
+int32_t RefWitReadReg(uint32_t uiReg, uint32_t uiReadNum);
+void RefWitSerialDataIn(uint8_t ucData);
+
+/* ========================================================================== */
+/*                              测试流                                        */
+/* ========================================================================== */
+
+/**
+ * @brief 字节流和注入帧的真值
+ */
+typedef struct {
+    uint8_t *data;
+    uint32_t len;
+    uint32_t cap;
+    uint32_t *truth;        /**< 未被破坏的帧摘要，按顺序 */
+    uint32_t truth_num;
+    uint32_t truth_cap;
+    uint32_t frames;        /**< 注入帧总数 */
+} bench_stream_t;
+
+/**
+ * @brief 解析结果: 按回调顺序记录的帧摘要
+ */
+typedef struct {
+    uint32_t *digest;
+    uint32_t num;
+    uint32_t cap;
+} bench_frames_t;
+
+static uint32_t s_rng = 1U;
+
+static uint32_t bench_rand(void)
+{
+    /* xorshift32，结果与平台rand()无关 */
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 17;
+    s_rng ^= s_rng << 5;
+    return s_rng;
+}
+
+static uint32_t fnv1a(uint32_t h, uint32_t v)
+{
+    uint32_t i;
+
+    for (i = 0; i < 4U; i++) {
+        h ^= (v >> (i * 8U)) & 0xFFU;
+        h *= 16777619UL;
+    }
+    return h;
+}
+
+static uint32_t frame_digest(uint32_t reg, uint32_t num, const int16_t *vals)
+{
+    uint32_t h = fnv1a(fnv1a(2166136261UL, reg), num);
+    uint32_t i;
+
+    for (i = 0; i < num; i++) {
+        h = fnv1a(h, (uint16_t)vals[i]);
+    }
+    return h;
+}
+
+static void *grow(void *p, uint32_t *cap, uint32_t need, size_t elem)
+{
+    void *q;
+
+    if (need <= *cap) {
+        return p;
+    }
+    while (*cap < need) {
+        *cap = (*cap == 0U) ? 4096U : *cap * 2U;
+    }
+    q = realloc(p, (size_t)*cap * elem);
+    if (q == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit(2);
+    }
+    return q;
+}
+
+static void stream_put(bench_stream_t *s, const uint8_t *p, uint32_t n)
+{
+    s->data = grow(s->data, &s->cap, s->len + n, 1U);
+    memcpy(&s->data[s->len], p, n);
+    s->len += n;
+}
+
+static void stream_truth(bench_stream_t *s, uint32_t digest)
+{
+    s->truth = grow(s->truth, &s->truth_cap, s->truth_num + 1U, sizeof(uint32_t));
+    s->truth[s->truth_num++] = digest;
+}
+
+static uint16_t modbus_crc(const uint8_t *p, uint32_t n)
+{
+    uint16_t crc = 0xFFFFU;
+    uint32_t i, b;
+
+    for (i = 0; i < n; i++) {
+        crc ^= p[i];
+        for (b = 0; b < 8U; b++) {
+            crc = (crc & 1U) ? (uint16_t)((crc >> 1) ^ 0xA001U) : (uint16_t)(crc >> 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief 编码一帧并给出其在解析器中产生的回调摘要
+ * @return uint32_t 帧长度
+ * @note NORMAL加速度/角度帧会产生两次回调 (3个寄存器+温度/版本)，摘要按两次回调串接
+ */
+static uint32_t encode_frame(uint32_t protocol, uint8_t *buf, uint32_t *digest)
+{
+    static const uint8_t k_types[] = { WIT_ACC, WIT_GYRO, WIT_ANGLE, WIT_MAGNETIC, WIT_QUATER };
+    int16_t vals[BENCH_MODBUS_NUM];
+    uint8_t type;
+    uint16_t crc;
+    uint32_t i, len;
+
+    if (protocol == WIT_PROTOCOL_NORMAL) {
+        type = k_types[bench_rand() % sizeof(k_types)];
+        buf[0] = 0x55;
+        buf[1] = type;
+        for (i = 0; i < 4U; i++) {
+            vals[i] = (int16_t)bench_rand();
+            buf[2U + 2U * i] = (uint8_t)vals[i];
+            buf[3U + 2U * i] = (uint8_t)((uint16_t)vals[i] >> 8);
+        }
+        buf[10] = 0;
+        for (i = 0; i < 10U; i++) {
+            buf[10] = (uint8_t)(buf[10] + buf[i]);
+        }
+        switch (type) {
+            case WIT_ACC:
+                *digest = fnv1a(frame_digest(AX, 3, vals), frame_digest(TEMP, 1, &vals[3]));
+                break;
+            case WIT_ANGLE:
+                *digest = fnv1a(frame_digest(Roll, 3, vals), frame_digest(VERSION, 1, &vals[3]));
+                break;
+            case WIT_GYRO:
+                *digest = frame_digest(GX, 3, vals);
+                break;
+            case WIT_MAGNETIC:
+                *digest = frame_digest(HX, 3, vals);
+                break;
+            default:
+                *digest = frame_digest(q0, 4, vals);
+                break;
+        }
+        return 11U;
+    }
+
+    buf[0] = BENCH_MODBUS_ADDR;
+    buf[1] = 0x03;
+    buf[2] = (uint8_t)(BENCH_MODBUS_NUM * 2U);
+    for (i = 0; i < BENCH_MODBUS_NUM; i++) {
+        vals[i] = (int16_t)bench_rand();
+        buf[3U + 2U * i] = (uint8_t)((uint16_t)vals[i] >> 8);
+        buf[4U + 2U * i] = (uint8_t)vals[i];
+    }
+    len = 3U + BENCH_MODBUS_NUM * 2U;
+    crc = modbus_crc(buf, len);
+    buf[len] = (uint8_t)crc;            /* 标准MODBUS: 低字节在前 */
+    buf[len + 1U] = (uint8_t)(crc >> 8);
+    *digest = frame_digest(BENCH_MODBUS_REG, BENCH_MODBUS_NUM, vals);
+    return len + 2U;
+}
+
+/**
+ * @brief 生成一个测试流
+ * @param corrupt 非0时按BENCH_CORRUPT_PERCENT破坏帧并插入垃圾
+ */
+static void stream_build(bench_stream_t *s, uint32_t protocol, uint32_t frames, int corrupt, uint32_t seed)
+{
+    uint8_t buf[64], junk[8];
+    uint32_t digest, len, i, n, k;
+
+    memset(s, 0, sizeof(*s));
+    s_rng = seed;
+    for (i = 0; i < frames; i++) {
+        len = encode_frame(protocol, buf, &digest);
+        s->frames++;
+        if (corrupt && (bench_rand() % 100U) < BENCH_CORRUPT_PERCENT) {
+            switch (bench_rand() % 3U) {
+                case 0:     /* 翻转一位 */
+                    buf[bench_rand() % len] ^= (uint8_t)(1U << (bench_rand() % 8U));
+                    stream_put(s, buf, len);
+                    break;
+                case 1:     /* 丢一个字节 */
+                    k = bench_rand() % len;
+                    stream_put(s, buf, k);
+                    stream_put(s, &buf[k + 1U], len - k - 1U);
+                    break;
+                default:    /* 帧前插入垃圾，其中常含伪帧头 */
+                    n = 1U + bench_rand() % sizeof(junk);
+                    for (k = 0; k < n; k++) {
+                        junk[k] = (bench_rand() & 1U) ? (uint8_t)(protocol == WIT_PROTOCOL_NORMAL ? 0x55 : 0x03)
+                                                      : (uint8_t)bench_rand();
+                    }
+                    stream_put(s, junk, n);
+                    stream_put(s, buf, len);
+                    stream_truth(s, digest);    /* 帧本身完好 */
+                    break;
+            }
+            continue;
+        }
+        stream_put(s, buf, len);
+        stream_truth(s, digest);
+    }
+}
+
+static void stream_free(bench_stream_t *s)
+{
+    free(s->data);
+    free(s->truth);
+    memset(s, 0, sizeof(*s));
+}
+
+/* ========================================================================== */
+/*                              解析回调                                      */
+/* ========================================================================== */
+
+static bench_frames_t *s_out;
+static uint32_t s_pending;          /* NORMAL加速度/角度帧的第一次回调 */
+static uint8_t s_pending_valid;
+static uint8_t s_merge;             /* NORMAL协议才合并 */
+
+/**
+ * @brief 记录一次回调；加速度/角度帧的两次回调合并为一个摘要
+ */
+static void frames_record(uint32_t reg, uint32_t num, const int16_t *shadow)
+{
+    uint32_t d = frame_digest(reg, num, &shadow[reg]);
+
+    if (s_merge && (reg == AX || reg == Roll)) {
+        s_pending = d;
+        s_pending_valid = 1;
+        return;
+    }
+    if ((reg == TEMP || reg == VERSION) && s_pending_valid) {
+        d = fnv1a(s_pending, d);
+    }
+    s_pending_valid = 0;
+    s_out->digest = grow(s_out->digest, &s_out->cap, s_out->num + 1U, sizeof(uint32_t));
+    s_out->digest[s_out->num++] = d;
+}
+
+static void sdk_update(uint32_t uiReg, uint32_t uiRegNum)
+{
+    frames_record(uiReg, uiRegNum, sReg);
+}
+
+static void ref_update(uint32_t uiReg, uint32_t uiRegNum)
+{
+    frames_record(uiReg, uiRegNum, RefsReg);
+}
+
+static void serial_write(uint8_t *p_ucData, uint32_t uiLen)
+{
+    (void)p_ucData;
+    (void)uiLen;
+}
+
+/* ========================================================================== */
+/*                              运行与比较                                    */
+/* ========================================================================== */
+
+typedef enum {
+    BENCH_SDK_BYTE = 0,
+    BENCH_SDK_BLOCK,
+    BENCH_REF_BYTE,
+    BENCH_MODE_NUM
+} bench_mode_t;
+
+static const char *const k_mode_name[] = { "byte", "block", "ref byte" };
+
+static double now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief 用一种输入方式解析整个流
+ * @return double 吞吐量 (字节/秒)
+ */
+static double bench_run(const bench_stream_t *s, uint32_t protocol, bench_mode_t mode, bench_frames_t *out)
+{
+    double t0, t1;
+    uint32_t i, n;
+
+    memset(out, 0, sizeof(*out));
+    s_out = out;
+    s_pending_valid = 0;
+    s_merge = (protocol == WIT_PROTOCOL_NORMAL);
+
+    if (mode == BENCH_REF_BYTE) {
+        RefWitInit(protocol, BENCH_MODBUS_ADDR);
+        RefWitRegisterCallBack(ref_update);
+        if (protocol == WIT_PROTOCOL_MODBUS) {
+            RefWitReadReg(BENCH_MODBUS_REG, BENCH_MODBUS_NUM);
+        }
+        t0 = now_s();
+        for (i = 0; i < s->len; i++) {
+            RefWitSerialDataIn(s->data[i]);
+        }
+        t1 = now_s();
+        return (double)s->len / (t1 - t0);
+    }
+
+    WitInit(protocol, BENCH_MODBUS_ADDR);
+    WitSerialWriteRegister(serial_write);
+    WitRegisterCallBack(sdk_update);
+    if (protocol == WIT_PROTOCOL_MODBUS) {
+        WitReadReg(BENCH_MODBUS_REG, BENCH_MODBUS_NUM);
+    }
+    t0 = now_s();
+    if (mode == BENCH_SDK_BYTE) {
+        for (i = 0; i < s->len; i++) {
+            WitSerialDataIn(s->data[i]);
+        }
+    } else {
+        for (i = 0; i < s->len; i += n) {
+            n = (s->len - i < BENCH_BLOCK_LEN) ? (s->len - i) : BENCH_BLOCK_LEN;
+            WitSerialDataInBlock(&s->data[i], n);
+        }
+    }
+    t1 = now_s();
+    return (double)s->len / (t1 - t0);
+}
+
+/**
+ * @brief sub中按顺序出现在seq里的帧数
+ * @param window 每个帧只在上一个匹配之后window帧内查找，0表示查到末尾；sub中缺失的帧被跳过
+ */
+static uint32_t subsequence(const uint32_t *sub, uint32_t sub_num, const uint32_t *seq, uint32_t seq_num, uint32_t window)
+{
+    uint32_t i, j = 0, k, end, found = 0;
+
+    for (i = 0; i < sub_num && j < seq_num; i++) {
+        end = (window == 0U || seq_num - j < window) ? seq_num : j + window;
+        for (k = j; k < end; k++) {
+            if (seq[k] == sub[i]) {
+                found++;
+                j = k + 1U;
+                break;
+            }
+        }
+    }
+    return found;
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 只保留注入过的帧 (去掉损坏字节碰巧通过校验的伪帧)
+ * @param sorted 排好序的真值摘要
+ * @return uint32_t 保留的帧数，结果原地写回frames
+ */
+static uint32_t frames_genuine(bench_frames_t *frames, const uint32_t *sorted, uint32_t sorted_num)
+{
+    uint32_t i, n = 0;
+
+    for (i = 0; i < frames->num; i++) {
+        if (bsearch(&frames->digest[i], sorted, sorted_num, sizeof(uint32_t), cmp_u32) != NULL) {
+            frames->digest[n++] = frames->digest[i];
+        }
+    }
+    return n;
+}
+
+static int g_failures = 0;
+
+static void check(int ok, const char *stream, const char *what, double value, double limit)
+{
+    if (!ok) {
+        fprintf(stderr, "FAIL %s: %s %.4f (limit %.4f)\n", stream, what, value, limit);
+        g_failures++;
+    }
+}
+
+/**
+ * @brief 跑一个流的全部输入方式并检查
+ */
+static void bench_stream(uint32_t protocol, int corrupt, uint32_t frames)
+{
+    char name[32];
+    bench_stream_t s;
+    bench_frames_t out[BENCH_MODE_NUM];
+    double rate[BENCH_MODE_NUM];
+    uint32_t *sorted;
+    uint32_t found, genuine, m;
+
+    snprintf(name, sizeof(name), "%s %s", (protocol == WIT_PROTOCOL_NORMAL) ? "NORMAL" : "MODBUS",
+             corrupt ? "corrupt" : "clean");
+    stream_build(&s, protocol, frames, corrupt, (protocol + 1U) * 7919U + (uint32_t)corrupt);
+
+    for (m = 0; m < BENCH_MODE_NUM; m++) {
+        rate[m] = bench_run(&s, protocol, (bench_mode_t)m, &out[m]);
+    }
+
+    printf("%-15s %8u bytes %7u frames (%7u intact)", name, (unsigned)s.len, (unsigned)s.frames, (unsigned)s.truth_num);
+    for (m = 0; m < BENCH_MODE_NUM; m++) {
+        printf(" | %s %6.1f MB/s %7u out", k_mode_name[m], rate[m] / 1e6, (unsigned)out[m].num);
+    }
+    printf("\n");
+
+    /* 单字节与整块输入结果一致 */
+    check(out[BENCH_SDK_BYTE].num == out[BENCH_SDK_BLOCK].num &&
+          memcmp(out[BENCH_SDK_BYTE].digest, out[BENCH_SDK_BLOCK].digest, out[BENCH_SDK_BYTE].num * sizeof(uint32_t)) == 0,
+          name, "byte vs block frames", out[BENCH_SDK_BLOCK].num, out[BENCH_SDK_BYTE].num);
+
+    found = subsequence(s.truth, s.truth_num, out[BENCH_SDK_BYTE].digest, out[BENCH_SDK_BYTE].num, BENCH_MATCH_WINDOW);
+    if (!corrupt) {
+        check(out[BENCH_SDK_BYTE].num == s.truth_num && found == s.truth_num, name, "frames", out[BENCH_SDK_BYTE].num, s.truth_num);
+    } else {
+        check((double)found >= BENCH_MIN_RECOVER * s.truth_num, name, "recovered", found, BENCH_MIN_RECOVER * s.truth_num);
+    }
+
+    sorted = malloc((size_t)(s.truth_num + 1U) * sizeof(uint32_t));
+    if (sorted == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit(2);
+    }
+    memcpy(sorted, s.truth, (size_t)s.truth_num * sizeof(uint32_t));
+    qsort(sorted, s.truth_num, sizeof(uint32_t), cmp_u32);
+
+    if (!corrupt) {
+        check(out[BENCH_REF_BYTE].num == out[BENCH_SDK_BYTE].num &&
+              memcmp(out[BENCH_REF_BYTE].digest, out[BENCH_SDK_BYTE].digest, out[BENCH_SDK_BYTE].num * sizeof(uint32_t)) == 0,
+              name, "ref frames", out[BENCH_SDK_BYTE].num, out[BENCH_REF_BYTE].num);
+    } else {
+        /* 参考解析器的伪帧不要求复现，其余帧必须按顺序全部出现 */
+        m = out[BENCH_REF_BYTE].num;
+        genuine = frames_genuine(&out[BENCH_REF_BYTE], sorted, s.truth_num);
+        found = subsequence(out[BENCH_REF_BYTE].digest, genuine, out[BENCH_SDK_BYTE].digest,
+                            out[BENCH_SDK_BYTE].num, 0U);
+        printf("%-15s ref: %u frames, %u false; genuine ones also found by the ring parser: %u/%u\n", "",
+               (unsigned)m, (unsigned)(m - genuine), (unsigned)found, (unsigned)genuine);
+        check(found == genuine, name, "ref frames kept", found, genuine);
+    }
+
+    if (corrupt) {
+        m = out[BENCH_SDK_BYTE].num;
+        genuine = frames_genuine(&out[BENCH_SDK_BYTE], sorted, s.truth_num);
+        printf("%-15s ring parser: %u false frames\n", "", (unsigned)(m - genuine));
+    }
+    free(sorted);
+
+    for (m = 0; m < BENCH_MODE_NUM; m++) {
+        free(out[m].digest);
+    }
+    stream_free(&s);
+}
+
+/* ========================================================================== */
+/*                              主程序                                        */
+/* ========================================================================== */
+
+int main(int argc, char **argv)
+{
+    uint32_t frames = BENCH_DEFAULT_FRAMES;
+
+    if (argc > 1) {
+        frames = (uint32_t)strtoul(argv[1], NULL, 0);
+        if (frames == 0U) {
+            fprintf(stderr, "usage: %s [frames]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    bench_stream(WIT_PROTOCOL_NORMAL, 0, frames);
+    bench_stream(WIT_PROTOCOL_NORMAL, 1, frames);
+    bench_stream(WIT_PROTOCOL_MODBUS, 0, frames);
+    bench_stream(WIT_PROTOCOL_MODBUS, 1, frames);
+
+    printf("%s (%d failures)\n", (g_failures == 0) ? "PASS" : "FAIL", g_failures);
+    return (g_failures == 0) ? 0 : 1;
+}
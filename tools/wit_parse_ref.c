@@ -0,0 +1,250 @@
+/**
+ * @file wit_parse_ref.c
+ * @brief wit_parse_bench的参考解析器
+ * @details 环形缓冲改动之前WIT SDK的串口解析逻辑 (NORMAL/MODBUS)，按原实现移植:
+ *          线性接收缓冲，帧头或校验不符时整体前移一个字节，成帧后丢弃缓冲中其余字节。
+ *          只保留解析所需部分，公共符号加Ref前缀，与当前SDK链接进同一程序，
+ *          基准程序用同一字节流分别驱动两者并比较解析出的帧。
+ *          原实现用memcpy前移重叠区域，此处改为memmove，行为相同且有定义。
+ * @date 2026-10-16
+ *
+ * @usage 见tools/wit_parse_bench.c
+ */
+
+#include <string.h>
+#include "wit_c_sdk.h"
+
+/* ========================================================================== */
+/*                              私有宏定义                                    */
+/* ========================================================================== */
+
+#define REF_DATA_BUFF_SIZE      256U    /* 原SDK的WIT_DATA_BUFF_SIZE */
+#define REF_FUNC_READ           0x03U
+
+/* ========================================================================== */
+/*                              私有变量                                      */
+/* ========================================================================== */
+
+int16_t RefsReg[REGSIZE];
+
+static RegUpdateCb s_ref_update = NULL;
+/* MODBUS长度字节最大255，等待整帧时最多收255+5字节而不经过末尾的回绕判断；
+ * 原实现在此越界写入相邻变量，这里留出余量 */
+static uint8_t s_ref_buff[REF_DATA_BUFF_SIZE + 4U];
+static uint32_t s_ref_cnt = 0;
+static uint32_t s_ref_protocol = 0;
+static uint32_t s_ref_read_index = 0;
+
+static const uint8_t k_crc_hi[256] = {
+    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81,
+    0x40, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0,
+    0x80, 0x41, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01,
+    0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41,
+    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81,
+    0x40, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0,
+    0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01,
+    0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40,
+    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81,
+    0x40, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0,
+    0x80, 0x41, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01,
+    0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41,
+    0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81,
+    0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0,
+    0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01,
+    0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41,
+    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81,
+    0x40
+};
+static const uint8_t k_crc_lo[256] = {
+    0x00, 0xC0, 0xC1, 0x01, 0xC3, 0x03, 0x02, 0xC2, 0xC6, 0x06, 0x07, 0xC7, 0x05, 0xC5, 0xC4,
+    0x04, 0xCC, 0x0C, 0x0D, 0xCD, 0x0F, 0xCF, 0xCE, 0x0E, 0x0A, 0xCA, 0xCB, 0x0B, 0xC9, 0x09,
+    0x08, 0xC8, 0xD8, 0x18, 0x19, 0xD9, 0x1B, 0xDB, 0xDA, 0x1A, 0x1E, 0xDE, 0xDF, 0x1F, 0xDD,
+    0x1D, 0x1C, 0xDC, 0x14, 0xD4, 0xD5, 0x15, 0xD7, 0x17, 0x16, 0xD6, 0xD2, 0x12, 0x13, 0xD3,
+    0x11, 0xD1, 0xD0, 0x10, 0xF0, 0x30, 0x31, 0xF1, 0x33, 0xF3, 0xF2, 0x32, 0x36, 0xF6, 0xF7,
+    0x37, 0xF5, 0x35, 0x34, 0xF4, 0x3C, 0xFC, 0xFD, 0x3D, 0xFF, 0x3F, 0x3E, 0xFE, 0xFA, 0x3A,
+    0x3B, 0xFB, 0x39, 0xF9, 0xF8, 0x38, 0x28, 0xE8, 0xE9, 0x29, 0xEB, 0x2B, 0x2A, 0xEA, 0xEE,
+    0x2E, 0x2F, 0xEF, 0x2D, 0xED, 0xEC, 0x2C, 0xE4, 0x24, 0x25, 0xE5, 0x27, 0xE7, 0xE6, 0x26,
+    0x22, 0xE2, 0xE3, 0x23, 0xE1, 0x21, 0x20, 0xE0, 0xA0, 0x60, 0x61, 0xA1, 0x63, 0xA3, 0xA2,
+    0x62, 0x66, 0xA6, 0xA7, 0x67, 0xA5, 0x65, 0x64, 0xA4, 0x6C, 0xAC, 0xAD, 0x6D, 0xAF, 0x6F,
+    0x6E, 0xAE, 0xAA, 0x6A, 0x6B, 0xAB, 0x69, 0xA9, 0xA8, 0x68, 0x78, 0xB8, 0xB9, 0x79, 0xBB,
+    0x7B, 0x7A, 0xBA, 0xBE, 0x7E, 0x7F, 0xBF, 0x7D, 0xBD, 0xBC, 0x7C, 0xB4, 0x74, 0x75, 0xB5,
+    0x77, 0xB7, 0xB6, 0x76, 0x72, 0xB2, 0xB3, 0x73, 0xB1, 0x71, 0x70, 0xB0, 0x50, 0x90, 0x91,
+    0x51, 0x93, 0x53, 0x52, 0x92, 0x96, 0x56, 0x57, 0x97, 0x55, 0x95, 0x94, 0x54, 0x9C, 0x5C,
+    0x5D, 0x9D, 0x5F, 0x9F, 0x9E, 0x5E, 0x5A, 0x9A, 0x9B, 0x5B, 0x99, 0x59, 0x58, 0x98, 0x88,
+    0x48, 0x49, 0x89, 0x4B, 0x8B, 0x8A, 0x4A, 0x4E, 0x8E, 0x8F, 0x4F, 0x8D, 0x4D, 0x4C, 0x8C,
+    0x44, 0x84, 0x85, 0x45, 0x87, 0x47, 0x46, 0x86, 0x82, 0x42, 0x43, 0x83, 0x41, 0x81, 0x80,
+    0x40
+};
+
+/* ========================================================================== */
+/*                              私有函数实现                                  */
+/* ========================================================================== */
+
+static uint16_t ref_crc16(const uint8_t *p, uint32_t len)
+{
+    uint8_t crc_hi = 0xFF, crc_lo = 0xFF, index;
+    uint32_t i;
+
+    for (i = 0; i < len; i++) {
+        index = crc_hi ^ p[i];
+        crc_hi = crc_lo ^ k_crc_hi[index];
+        crc_lo = k_crc_lo[index];
+    }
+    return (uint16_t)(((uint16_t)crc_hi << 8) | crc_lo);
+}
+
+static uint8_t ref_sum(const uint8_t *p, uint32_t len)
+{
+    uint8_t sum = 0;
+    uint32_t i;
+
+    for (i = 0; i < len; i++) {
+        sum = (uint8_t)(sum + p[i]);
+    }
+    return sum;
+}
+
+/**
+ * @brief 丢弃缓冲首字节，其余字节前移
+ */
+static void ref_shift(void)
+{
+    s_ref_cnt--;
+    memmove(s_ref_buff, &s_ref_buff[1], s_ref_cnt);
+}
+
+/**
+ * @brief NORMAL帧写入寄存器并回调 (原CopeWitData)
+ */
+static void ref_cope_data(uint8_t type, const uint16_t *data)
+{
+    uint32_t reg1, reg2 = 0, len1 = 4, len2 = 0;
+
+    switch (type) {
+        case WIT_ACC:       reg1 = AX;    len1 = 3; reg2 = TEMP;    len2 = 1; break;
+        case WIT_ANGLE:     reg1 = Roll;  len1 = 3; reg2 = VERSION; len2 = 1; break;
+        case WIT_TIME:      reg1 = YYMM;  break;
+        case WIT_GYRO:      reg1 = GX;    len1 = 3; break;
+        case WIT_MAGNETIC:  reg1 = HX;    len1 = 3; break;
+        case WIT_DPORT:     reg1 = D0Status; break;
+        case WIT_PRESS:     reg1 = PressureL; break;
+        case WIT_GPS:       reg1 = LonL;  break;
+        case WIT_VELOCITY:  reg1 = GPSHeight; break;
+        case WIT_QUATER:    reg1 = q0;    break;
+        case WIT_GSA:       reg1 = SVNUM; break;
+        case WIT_REGVALUE:  reg1 = s_ref_read_index; break;
+        default:
+            return;
+    }
+
+    memcpy(&RefsReg[reg1], data, len1 << 1);
+    s_ref_update(reg1, len1);
+    if (len2 != 0U) {
+        memcpy(&RefsReg[reg2], &data[3], len2 << 1);
+        s_ref_update(reg2, len2);
+    }
+}
+
+/* ========================================================================== */
+/*                              公共函数实现                                  */
+/* ========================================================================== */
+
+/**
+ * @brief 选择协议并清空接收缓冲
+ */
+int32_t RefWitInit(uint32_t uiProtocol, uint8_t ucAddr)
+{
+    (void)ucAddr;
+    if (uiProtocol > WIT_PROTOCOL_I2C) {
+        return WIT_HAL_INVAL;
+    }
+    s_ref_protocol = uiProtocol;
+    s_ref_cnt = 0;
+    return WIT_HAL_OK;
+}
+
+int32_t RefWitRegisterCallBack(RegUpdateCb update_func)
+{
+    if (update_func == NULL) {
+        return WIT_HAL_INVAL;
+    }
+    s_ref_update = update_func;
+    return WIT_HAL_OK;
+}
+
+/**
+ * @brief 记录MODBUS读响应对应的起始寄存器 (不发送请求)
+ */
+int32_t RefWitReadReg(uint32_t uiReg, uint32_t uiReadNum)
+{
+    if ((uiReg + uiReadNum) >= REGSIZE) {
+        return WIT_HAL_INVAL;
+    }
+    s_ref_read_index = uiReg;
+    return WIT_HAL_OK;
+}
+
+/**
+ * @brief 逐字节输入串口数据 (原WitSerialDataIn)
+ */
+void RefWitSerialDataIn(uint8_t ucData)
+{
+    uint16_t crc, value, num, i, data[4];
+
+    if (s_ref_update == NULL) {
+        return;
+    }
+    s_ref_buff[s_ref_cnt++] = ucData;
+
+    switch (s_ref_protocol) {
+        case WIT_PROTOCOL_NORMAL:
+            if (s_ref_buff[0] != 0x55) {
+                ref_shift();
+                return;
+            }
+            if (s_ref_cnt >= 11U) {
+                if (ref_sum(s_ref_buff, 10) != s_ref_buff[10]) {
+                    ref_shift();
+                    return;
+                }
+                for (i = 0; i < 4U; i++) {
+                    data[i] = (uint16_t)(((uint16_t)s_ref_buff[3U + 2U * i] << 8) | s_ref_buff[2U + 2U * i]);
+                }
+                ref_cope_data(s_ref_buff[1], data);
+                s_ref_cnt = 0;
+            }
+            break;
+
+        case WIT_PROTOCOL_MODBUS:
+            if (s_ref_cnt > 2U) {
+                if (s_ref_buff[1] != REF_FUNC_READ) {
+                    ref_shift();
+                    return;
+                }
+                if (s_ref_cnt < (uint32_t)s_ref_buff[2] + 5U) {
+                    return;
+                }
+                value = (uint16_t)(((uint16_t)s_ref_buff[s_ref_cnt - 2U] << 8) | s_ref_buff[s_ref_cnt - 1U]);
+                crc = ref_crc16(s_ref_buff, s_ref_cnt - 2U);
+                if (value != crc) {
+                    ref_shift();
+                    return;
+                }
+                num = s_ref_buff[2] >> 1;
+                for (i = 0; i < num; i++) {
+                    RefsReg[i + s_ref_read_index] =
+                        (int16_t)(((uint16_t)s_ref_buff[(i << 1) + 3U] << 8) | s_ref_buff[(i << 1) + 4U]);
+                }
+                s_ref_update(s_ref_read_index, num);
+                s_ref_cnt = 0;
+            }
+            break;
+
+        default:
+            s_ref_cnt = 0;
+            break;
+    }
+    if (s_ref_cnt == REF_DATA_BUFF_SIZE) {
+        s_ref_cnt = 0;
+    }
+}